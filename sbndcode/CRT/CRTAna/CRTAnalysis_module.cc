@@ -481,7 +481,7 @@ sbnd::crt::CRTAnalysis::CRTAnalysis(fhicl::ParameterSet const& p)
 
     if(fDebug)
       {
-        for(auto const &[name, tagger] : fCRTGeoAlg.GetTaggers())
+        for(auto const &tagger : fCRTGeoAlg.GetTaggers())
           {
             std::cout << "Tagger:  " << tagger.name << '\n'
                       << "X - Min: " << tagger.minX << " Max: " << tagger.maxX << '\n'
@@ -491,7 +491,7 @@ sbnd::crt::CRTAnalysis::CRTAnalysis(fhicl::ParameterSet const& p)
 
         std::cout << std::endl;
 
-        for(auto const &[name, module] : fCRTGeoAlg.GetModules())
+        for(auto const &module : fCRTGeoAlg.GetModules())
           {
             std::cout << "Module:  " << module.name << " (" << module.taggerName << ")" << '\n';
             if(module.minos)
@@ -504,8 +504,11 @@ sbnd::crt::CRTAnalysis::CRTAnalysis(fhicl::ParameterSet const& p)
 
         std::cout << std::endl;
 
-        for(auto const &[name, sipm] : fCRTGeoAlg.GetSiPMs())
+        for(auto const &sipm : fCRTGeoAlg.GetSiPMs())
           {
+            if(sipm.null)
+              continue;
+
             std::cout << "SiPM:  " << sipm.channel << " (" << sipm.channel/32 << " - " << sipm.channel%32 << ")" << '\n'
                       << "x: " << sipm.x << " y: " << sipm.y << " z: " << sipm.z << std::endl;
           }
@@ -533,7 +533,7 @@ sbnd::crt::CRTCalibAna::CRTCalibAna(fhicl::ParameterSet const& p)
 
     if(fDebug)
       {
-        for(auto const &[name, tagger] : fCRTGeoAlg.GetTaggers())
+        for(auto const &tagger : fCRTGeoAlg.GetTaggers())
           {
             std::cout << "Tagger:  " << tagger.name << '\n'
                       << "X - Min: " << tagger.minX << " Max: " << tagger.maxX << '\n'
@@ -543,7 +543,7 @@ sbnd::crt::CRTCalibAna::CRTCalibAna(fhicl::ParameterSet const& p)
 
         std::cout << std::endl;
 
-        for(auto const &[name, module] : fCRTGeoAlg.GetModules())
+        for(auto const &module : fCRTGeoAlg.GetModules())
           {
             std::cout << "Module:  " << module.name << " (" << module.taggerName << ")" << '\n';
             if(module.minos)
@@ -556,8 +556,11 @@ sbnd::crt::CRTCalibAna::CRTCalibAna(fhicl::ParameterSet const& p)
 
         std::cout << std::endl;
 
-        for(auto const &[name, sipm] : fCRTGeoAlg.GetSiPMs())
+        for(auto const &sipm : fCRTGeoAlg.GetSiPMs())
           {
+            if(sipm.null)
+              continue;
+
             std::cout << "SiPM:  " << sipm.channel << " (" << sipm.channel/32 << " - " << sipm.channel%32 << ")" << '\n'
                       << "x: " << sipm.x << " y: " << sipm.y << " z: " << sipm.z << std::endl;
           }
@@ -35,7 +35,15 @@ namespace sbnd::crt {
     fMCPIDEsEnergyMap.clear();
     fMCPStripHitsMap.clear();
     fTrackIDMotherMap.clear();
-    fStripHitMCPMap.clear();
+    fStripHitIDEOffsets.assign(1, 0);
+    fStripHitIDEs.clear();
+    fStripHitTruthMatches.clear();
+    fClusterStripHitOffsets.assign(1, 0);
+    fClusterStripHits.clear();
+    fClusterTaggers.clear();
+    fClusterTruthMatches.clear();
+    fSpacePointClusters.clear();
+    fTrackTruthMatches.clear();
 
     art::Handle<std::vector<sim::ParticleAncestryMap>> droppedTrackIDMapVecHandle;
     event.getByLabel(fSimModuleLabel, droppedTrackIDMapVecHandle);
@@ -253,23 +261,127 @@ namespace sbnd::crt {
         fMCPIDEsEnergyMap[rollUpID]          += ide->energyDeposited;
       }
 
+    // Walk the FEBData -> strip hit -> cluster -> space point -> track chain once,
+    // storing the truth contributions of every object. All later truth queries
+    // are lookups into these arrays.
+    art::Handle<std::vector<FEBData>> febDataHandle;
+    event.getByLabel(fFEBDataModuleLabel, febDataHandle);
+
     art::Handle<std::vector<CRTStripHit>> stripHitHandle;
     event.getByLabel(fStripHitModuleLabel, stripHitHandle);
     std::vector<art::Ptr<CRTStripHit>> stripHitVec;
     art::fill_ptr_vector(stripHitVec, stripHitHandle);
 
+    art::FindManyP<sim::AuxDetIDE, FEBTruthInfo> febDataToIDEs(febDataHandle, event, fFEBDataModuleLabel);
+    art::FindOneP<FEBData> stripHitToFEBData(stripHitHandle, event, fStripHitModuleLabel);
+
     for(auto const stripHit : stripHitVec)
       {
         const CRTTagger tagger = fCRTGeoAlg.ChannelToTaggerEnum(stripHit->Channel());
-        TruthMatchMetrics truthMatch = TruthMatching(event, stripHit);
 
-        fStripHitMCPMap[stripHit.key()] = truthMatch.trackid;
+        auto const febData          = stripHitToFEBData.at(stripHit.key());
+        auto const &assnIDEVec      = febDataToIDEs.at(febData.key());
+        auto const &febTruthInfoVec = febDataToIDEs.data(febData.key());
+
+        std::map<int, double> idToEnergyMap;
+        double totalEnergy = 0., x = 0., y = 0., z = 0., t = 0.;
+        uint nides = 0;
+
+        for(unsigned i = 0; i < assnIDEVec.size(); ++i)
+          {
+            const art::Ptr<sim::AuxDetIDE> ide = assnIDEVec[i];
+            if((uint) febTruthInfoVec[i]->GetChannel() == (stripHit->Channel() % 32))
+              {
+                const int rollUpID = RollUpID(ide->trackID);
+                fStripHitIDEs.emplace_back(rollUpID, ide->energyDeposited);
+
+                idToEnergyMap[rollUpID] += ide->energyDeposited;
+                totalEnergy             += ide->energyDeposited;
+
+                x                       += (ide->entryX + ide->exitX) / 2.;
+                y                       += (ide->entryY + ide->exitY) / 2.;
+                z                       += (ide->entryZ + ide->exitZ) / 2.;
+                t                       += (ide->entryT + ide->exitT) / 2.;
+
+                ++nides;
+              }
+          }
+
+        fStripHitIDEOffsets.push_back(fStripHitIDEs.size());
 
-        Category category(truthMatch.trackid, tagger);
-        if(fMCPStripHitsMap.find(category) == fMCPStripHitsMap.end())
-          fMCPStripHitsMap[category] = 0;
+        x /= nides;
+        y /= nides;
+        z /= nides;
+        t /= nides;
+
+        double bestPur = 0., comp = 0.;
+        int trackid = -99999;
+
+        for(auto const [id, en] : idToEnergyMap)
+          {
+            double pur = en / totalEnergy;
+            if(pur > bestPur)
+              {
+                Category category(id, tagger);
+
+                trackid = id;
+                bestPur = pur;
+                comp    = en / fMCPIDEsEnergyPerTaggerMap[category];
+              }
+          }
+
+        TrueDeposit deposit(trackid, -999999, tagger, totalEnergy, t, x, y, z, true);
+        fStripHitTruthMatches.emplace_back(trackid, comp, bestPur, 1., 1., deposit);
+
+        ++fMCPStripHitsMap[{trackid, tagger}];
+      }
+
+    art::Handle<std::vector<CRTCluster>> clusterHandle;
+    if(event.getByLabel(fClusterModuleLabel, clusterHandle))
+      {
+        art::FindManyP<CRTStripHit> clusterToStripHits(clusterHandle, event, fClusterModuleLabel);
+
+        for(unsigned i = 0; i < clusterHandle->size(); ++i)
+          {
+            for(auto const stripHit : clusterToStripHits.at(i))
+              fClusterStripHits.push_back(stripHit.key());
+
+            fClusterStripHitOffsets.push_back(fClusterStripHits.size());
+            fClusterTaggers.push_back(clusterHandle->at(i).Tagger());
+          }
 
-        ++fMCPStripHitsMap[{truthMatch.trackid, tagger}];
+        for(unsigned i = 0; i < clusterHandle->size(); ++i)
+          fClusterTruthMatches.push_back(ClusterTruthMatching(i));
+      }
+
+    art::Handle<std::vector<CRTSpacePoint>> spacePointHandle;
+    if(event.getByLabel(fSpacePointModuleLabel, spacePointHandle))
+      {
+        art::FindOneP<CRTCluster> spacePointToCluster(spacePointHandle, event, fSpacePointModuleLabel);
+
+        for(unsigned i = 0; i < spacePointHandle->size(); ++i)
+          fSpacePointClusters.push_back(spacePointToCluster.at(i).key());
+      }
+
+    art::Handle<std::vector<CRTTrack>> trackHandle;
+    if(event.getByLabel(fTrackModuleLabel, trackHandle))
+      {
+        art::FindManyP<CRTSpacePoint> trackToSpacePoints(trackHandle, event, fTrackModuleLabel);
+
+        for(unsigned i = 0; i < trackHandle->size(); ++i)
+          fTrackTruthMatches.push_back(TrackTruthMatching(trackToSpacePoints.at(i)));
+      }
+  }
+
+  void CRTBackTrackerAlg::AddStripHitContributions(const size_t stripHitKey, std::map<int, double> &idToEnergyMap,
+                                                   double &totalEnergy)
+  {
+    for(unsigned i = fStripHitIDEOffsets.at(stripHitKey); i < fStripHitIDEOffsets.at(stripHitKey + 1); ++i)
+      {
+        auto const& [id, energy] = fStripHitIDEs[i];
+
+        idToEnergyMap[id] += energy;
+        totalEnergy       += energy;
       }
   }
 
@@ -283,19 +395,11 @@ namespace sbnd::crt {
 
   void CRTBackTrackerAlg::RunSpacePointRecoStatusChecks(const art::Event &event)
   {
-    art::Handle<std::vector<CRTSpacePoint>> spacePointHandle;
-    event.getByLabel(fSpacePointModuleLabel, spacePointHandle);
-
-    art::FindManyP<CRTCluster> spacePointsToClusters(spacePointHandle, event, fSpacePointModuleLabel);
-
-    for(unsigned i = 0; i < spacePointHandle->size(); ++i)
+    for(auto const clusterKey : fSpacePointClusters)
       {
-        const art::Ptr<CRTSpacePoint> spacePoint(spacePointHandle, i);
-        const art::Ptr<CRTCluster> cluster = spacePointsToClusters.at(spacePoint.key())[0];
-
-        TruthMatchMetrics truthMatch = TruthMatching(event, cluster);
+        const TruthMatchMetrics &truthMatch = fClusterTruthMatches.at(clusterKey);
 
-        Category category(truthMatch.trackid, cluster->Tagger());
+        Category category(truthMatch.trackid, fClusterTaggers.at(clusterKey));
         fTrackIDSpacePointRecoMap[category] = true;
       }
   }
@@ -307,11 +411,9 @@ namespace sbnd::crt {
 
     for(unsigned i = 0; i < trackHandle->size(); ++i)
       {
-        const art::Ptr<CRTTrack> track(trackHandle, i);
+        const TruthMatchMetrics &truthMatch = fTrackTruthMatches.at(i);
 
-        TruthMatchMetrics truthMatch = TruthMatching(event, track);
-
-        fTrackIDTrackRecoMap[truthMatch.trackid] = { true, track->Triple()};
+        fTrackIDTrackRecoMap[truthMatch.trackid] = { true, trackHandle->at(i).Triple()};
       }
   }
 
@@ -336,109 +438,37 @@ namespace sbnd::crt {
   }
 
   CRTBackTrackerAlg::TruthMatchMetrics CRTBackTrackerAlg::TruthMatching(const art::Event &event, const art::Ptr<CRTStripHit> &stripHit)
-  {  
-    art::Handle<std::vector<FEBData>> febDataHandle;
-    event.getByLabel(fFEBDataModuleLabel, febDataHandle);
-
-    art::Handle<std::vector<CRTStripHit>> stripHitHandle;
-    event.getByLabel(fStripHitModuleLabel, stripHitHandle);
-
-    art::FindManyP<sim::AuxDetIDE, FEBTruthInfo> febDataToIDEs(febDataHandle, event, fFEBDataModuleLabel);
-    art::FindOneP<FEBData> stripHitToFEBData(stripHitHandle, event, fStripHitModuleLabel);
-    const CRTTagger tagger = fCRTGeoAlg.ChannelToTaggerEnum(stripHit->Channel());
-
-    auto const febData = stripHitToFEBData.at(stripHit.key());
-    auto const assnIDEVec = febDataToIDEs.at(febData.key());
-
-    std::map<int, double> idToEnergyMap;
-    double totalEnergy = 0., x = 0., y = 0., z = 0., t = 0.;
-    uint nides = 0;
-
-    for(unsigned i = 0; i < assnIDEVec.size(); ++i)
-      {
-        const art::Ptr<sim::AuxDetIDE> ide = assnIDEVec[i];
-        const FEBTruthInfo *febTruthInfo = febDataToIDEs.data(febData.key())[i];
-        if((uint) febTruthInfo->GetChannel() == (stripHit->Channel() % 32))
-          {
-            idToEnergyMap[RollUpID(ide->trackID)] += ide->energyDeposited;
-            totalEnergy                           += ide->energyDeposited;
-
-            x                                     += (ide->entryX + ide->exitX) / 2.;
-            y                                     += (ide->entryY + ide->exitY) / 2.;
-            z                                     += (ide->entryZ + ide->exitZ) / 2.;
-            t                                     += (ide->entryT + ide->exitT) / 2.;
-
-            ++nides;
-          }
-      }
-
-    x /= nides;
-    y /= nides;
-    z /= nides;
-    t /= nides;
-
-    double bestPur = 0., comp = 0.;
-    int trackid = -99999;
-
-    for(auto const [id, en] : idToEnergyMap)
-      {
-        double pur = en / totalEnergy;
-        if(pur > bestPur)
-          {
-            Category category(id, tagger);
-
-            trackid = id;
-            bestPur = pur;
-            comp    = en / fMCPIDEsEnergyPerTaggerMap[category];
-          }
-      }
-
-    TrueDeposit deposit(trackid, -999999, tagger, totalEnergy, t, x, y, z, true);
-
-    return TruthMatchMetrics(trackid, comp, bestPur, 1., 1., deposit);
+  {
+    return fStripHitTruthMatches.at(stripHit.key());
   }
 
   CRTBackTrackerAlg::TruthMatchMetrics CRTBackTrackerAlg::TruthMatching(const art::Event &event, const art::Ptr<CRTCluster> &cluster)
   {
-    art::Handle<std::vector<FEBData>> febDataHandle;
-    event.getByLabel(fFEBDataModuleLabel, febDataHandle);
-
-    art::Handle<std::vector<CRTStripHit>> stripHitHandle;
-    event.getByLabel(fStripHitModuleLabel, stripHitHandle);
+    return fClusterTruthMatches.at(cluster.key());
+  }
 
-    art::Handle<std::vector<CRTCluster>> clusterHandle;
-    event.getByLabel(fClusterModuleLabel, clusterHandle);
+  CRTBackTrackerAlg::TruthMatchMetrics CRTBackTrackerAlg::TruthMatching(const art::Event &event, const art::Ptr<CRTTrack> &track)
+  {
+    return fTrackTruthMatches.at(track.key());
+  }
 
-    art::FindManyP<sim::AuxDetIDE, FEBTruthInfo> febDataToIDEs(febDataHandle, event, fFEBDataModuleLabel);
-    art::FindManyP<FEBData> stripHitToFEBData(stripHitHandle, event, fStripHitModuleLabel);
-    art::FindManyP<CRTStripHit> clusterToStripHits(clusterHandle, event, fClusterModuleLabel);
+  CRTBackTrackerAlg::TruthMatchMetrics CRTBackTrackerAlg::ClusterTruthMatching(const size_t clusterKey)
+  {
+    const CRTTagger tagger = fClusterTaggers.at(clusterKey);
 
     std::map<int, double> idToEnergyMap;
     double totalEnergy = 0.;
     std::map<int, uint> idToNHitsMap;
 
-    auto const assnStripHitVec = clusterToStripHits.at(cluster.key());
+    const unsigned begin = fClusterStripHitOffsets.at(clusterKey), end = fClusterStripHitOffsets.at(clusterKey + 1);
 
-    for(auto const stripHit : assnStripHitVec)
+    for(unsigned i = begin; i < end; ++i)
       {
-        auto const febData = stripHitToFEBData.at(stripHit.key());
-        assert(febData.size() == 1);
-        auto const assnIDEVec = febDataToIDEs.at(febData.at(0).key());
-        for(unsigned i = 0; i < assnIDEVec.size(); ++i)
-          {
-            const art::Ptr<sim::AuxDetIDE> ide = assnIDEVec[i];
-            const FEBTruthInfo *febTruthInfo = febDataToIDEs.data(febData.at(0).key())[i];
-            if((uint) febTruthInfo->GetChannel() == (stripHit->Channel() % 32))
-              {
-                idToEnergyMap[RollUpID(ide->trackID)] += ide->energyDeposited;
-                totalEnergy                           += ide->energyDeposited;
-              }
-          }
+        const size_t stripHitKey = fClusterStripHits[i];
 
-        if(idToNHitsMap.find(fStripHitMCPMap[stripHit.key()]) == idToNHitsMap.end())
-          idToNHitsMap[fStripHitMCPMap[stripHit.key()]] = 0;
-        
-        ++idToNHitsMap[fStripHitMCPMap[stripHit.key()]];
+        AddStripHitContributions(stripHitKey, idToEnergyMap, totalEnergy);
+
+        ++idToNHitsMap[fStripHitTruthMatches.at(stripHitKey).trackid];
       }
 
     double bestPur = 0., comp = 0.;
@@ -449,7 +479,7 @@ namespace sbnd::crt {
         double pur = en / totalEnergy;
         if(pur > bestPur)
           {
-            Category category(id, cluster->Tagger());
+            Category category(id, tagger);
 
             trackid = id;
             bestPur = pur;
@@ -457,65 +487,26 @@ namespace sbnd::crt {
           }
       }
 
-    Category category(trackid, cluster->Tagger());
+    Category category(trackid, tagger);
 
     double hitComp = idToNHitsMap[trackid] / (double) fMCPStripHitsMap[category];
-    double hitPur  = idToNHitsMap[trackid] / (double) assnStripHitVec.size();
+    double hitPur  = idToNHitsMap[trackid] / (double) (end - begin);
 
     return TruthMatchMetrics(trackid, comp, bestPur, hitComp, hitPur, 
                              fTrueDepositsPerTaggerMap[category]);
   }
 
-  CRTBackTrackerAlg::TruthMatchMetrics CRTBackTrackerAlg::TruthMatching(const art::Event &event, const art::Ptr<CRTTrack> &track)
+  CRTBackTrackerAlg::TruthMatchMetrics CRTBackTrackerAlg::TrackTruthMatching(const std::vector<art::Ptr<CRTSpacePoint>> &spacePointVec)
   {
-    art::Handle<std::vector<FEBData>> febDataHandle;
-    event.getByLabel(fFEBDataModuleLabel, febDataHandle);
-
-    art::Handle<std::vector<CRTStripHit>> stripHitHandle;
-    event.getByLabel(fStripHitModuleLabel, stripHitHandle);
-
-    art::Handle<std::vector<CRTCluster>> clusterHandle;
-    event.getByLabel(fClusterModuleLabel, clusterHandle);
-
-    art::Handle<std::vector<CRTSpacePoint>> spacePointHandle;
-    event.getByLabel(fSpacePointModuleLabel, spacePointHandle);
-
-    art::Handle<std::vector<CRTTrack>> trackHandle;
-    event.getByLabel(fTrackModuleLabel, trackHandle);
-
-    art::FindManyP<sim::AuxDetIDE, FEBTruthInfo> febDataToIDEs(febDataHandle, event, fFEBDataModuleLabel);
-    art::FindManyP<FEBData> stripHitToFEBData(stripHitHandle, event, fStripHitModuleLabel);
-    art::FindManyP<CRTStripHit> clusterToStripHits(clusterHandle, event, fClusterModuleLabel);
-    art::FindOneP<CRTCluster> spacePointToCluster(spacePointHandle, event, fSpacePointModuleLabel);
-    art::FindManyP<CRTSpacePoint> trackToSpacePoints(trackHandle, event, fTrackModuleLabel);
-
     std::map<int, double> idToEnergyMap;
     double totalEnergy = 0.;
 
-    auto const spacePointVec = trackToSpacePoints.at(track.key());
-
     for(auto const spacePoint : spacePointVec)
       {
-        auto const cluster     = spacePointToCluster.at(spacePoint.key());
-        auto const stripHitVec = clusterToStripHits.at(cluster.key());
-        
-        for(auto const stripHit : stripHitVec)
-          {
-            auto const febData = stripHitToFEBData.at(stripHit.key());
-            assert(febData.size() == 1);
-            auto const assnIDEVec = febDataToIDEs.at(febData.at(0).key());
+        const size_t clusterKey = fSpacePointClusters.at(spacePoint.key());
 
-            for(unsigned i = 0; i < assnIDEVec.size(); ++i)
-              {
-                const art::Ptr<sim::AuxDetIDE> ide = assnIDEVec[i];
-                const FEBTruthInfo *febTruthInfo = febDataToIDEs.data(febData.at(0).key())[i];
-                if((uint) febTruthInfo->GetChannel() == (stripHit->Channel() % 32))
-                  {
-                    idToEnergyMap[RollUpID(ide->trackID)] += ide->energyDeposited;
-                    totalEnergy                           += ide->energyDeposited;
-                  }
-              }
-          }
+        for(unsigned i = fClusterStripHitOffsets.at(clusterKey); i < fClusterStripHitOffsets.at(clusterKey + 1); ++i)
+          AddStripHitContributions(fClusterStripHits[i], idToEnergyMap, totalEnergy);
       }
 
     double bestPur = 0., comp = 0.;
@@ -541,7 +532,7 @@ namespace sbnd::crt {
                                                                                  const CRTTagger &tagger)
   {
     const CoordSet constrainedPlane = CRTCommonUtils::GetTaggerDefinedCoordinate(tagger);
-    const CRTTaggerGeo taggerGeo    = fCRTGeoAlg.GetTagger(CRTCommonUtils::GetTaggerName(tagger));
+    const CRTTaggerGeo &taggerGeo   = fCRTGeoAlg.GetTagger(CRTCommonUtils::GetTaggerName(tagger));
     double k;
 
     switch(constrainedPlane)
@@ -248,7 +248,27 @@ namespace sbnd::crt {
     std::map<int, double>                fMCPIDEsEnergyMap;
     std::map<Category, int>              fMCPStripHitsMap;
     std::map<int, int>                   fTrackIDMotherMap;
-    std::map<int, int>                   fStripHitMCPMap;
+
+    // Per event truth chain, indexed by the keys of each data product.
+    // The IDEs contributing to strip hit i are fStripHitIDEs[fStripHitIDEOffsets[i]]
+    // to fStripHitIDEs[fStripHitIDEOffsets[i+1]] as (rolled up track ID, energy),
+    // and likewise for the strip hits of each cluster.
+    std::vector<unsigned>                 fStripHitIDEOffsets;
+    std::vector<std::pair<int, double>>   fStripHitIDEs;
+    std::vector<TruthMatchMetrics>        fStripHitTruthMatches;
+    std::vector<unsigned>                 fClusterStripHitOffsets;
+    std::vector<size_t>                   fClusterStripHits;
+    std::vector<CRTTagger>                fClusterTaggers;
+    std::vector<TruthMatchMetrics>        fClusterTruthMatches;
+    std::vector<size_t>                   fSpacePointClusters;
+    std::vector<TruthMatchMetrics>        fTrackTruthMatches;
+
+    void AddStripHitContributions(const size_t stripHitKey, std::map<int, double> &idToEnergyMap,
+                                  double &totalEnergy);
+
+    TruthMatchMetrics ClusterTruthMatching(const size_t clusterKey);
+
+    TruthMatchMetrics TrackTruthMatching(const std::vector<art::Ptr<CRTSpacePoint>> &spacePointVec);
     
   };
 }
@@ -138,9 +138,9 @@ namespace sbnd::crt {
     // Draw the CRT taggers
     if(fDrawTaggers)
       {
-        for(auto const &[name, tagger] : fCRTGeoAlg.GetTaggers())
+        for(auto const &tagger : fCRTGeoAlg.GetTaggers())
           {
-            if(fChoseTaggers && std::find(fChosenTaggers.begin(), fChosenTaggers.end(), CRTCommonUtils::GetTaggerEnum(name)) == fChosenTaggers.end())
+            if(fChoseTaggers && std::find(fChosenTaggers.begin(), fChosenTaggers.end(), tagger.tagger) == fChosenTaggers.end())
               continue;
                
             double rmin[3] = {tagger.minX, 
@@ -156,9 +156,9 @@ namespace sbnd::crt {
     // Draw individual CRT modules
     if(fDrawModules)
       {
-        for(auto const &[name, module] : fCRTGeoAlg.GetModules())
+        for(auto const &module : fCRTGeoAlg.GetModules())
           {
-            if(fChoseTaggers && std::find(fChosenTaggers.begin(), fChosenTaggers.end(), CRTCommonUtils::GetTaggerEnum(module.taggerName)) == fChosenTaggers.end())
+            if(fChoseTaggers && std::find(fChosenTaggers.begin(), fChosenTaggers.end(), module.tagger) == fChosenTaggers.end())
               continue;
 
             double rmin[3] = {module.minX, 
@@ -204,7 +204,7 @@ namespace sbnd::crt {
     // Draw individual CRT strips
     if(fDrawStrips)
       {
-        for(auto const &[name, strip] : fCRTGeoAlg.GetStrips())
+        for(auto const &strip : fCRTGeoAlg.GetStrips())
           {
             if(fChoseTaggers && std::find(fChosenTaggers.begin(), fChosenTaggers.end(), fCRTGeoAlg.ChannelToTaggerEnum(strip.channel0)) == fChosenTaggers.end())
               continue;
@@ -330,7 +330,7 @@ namespace sbnd::crt {
             if(stripHit->Ts1() - G4RefTime < fMinTime || stripHit->Ts1() - G4RefTime > fMaxTime)
               continue;
 
-            CRTStripGeo strip = fCRTGeoAlg.GetStrip(stripHit->Channel());
+            const CRTStripGeo &strip = fCRTGeoAlg.GetStrip(stripHit->Channel());
 
             double rmin[3] = {strip.minX, strip.minY, strip.minZ};
             double rmax[3] = {strip.maxX, strip.maxY, strip.maxZ};
@@ -372,7 +372,7 @@ namespace sbnd::crt {
               {
                 for(auto stripHit : stripHitVec)
                   {
-                    CRTStripGeo strip = fCRTGeoAlg.GetStrip(stripHit->Channel());
+                    const CRTStripGeo &strip = fCRTGeoAlg.GetStrip(stripHit->Channel());
                     
                     double rmin[3] = {strip.minX, strip.minY, strip.minZ};
                     double rmax[3] = {strip.maxX, strip.maxY, strip.maxZ};
@@ -46,17 +46,11 @@ namespace sbnd::crt {
 
     if(threeD)
       {
-        if(fCRTGeoAlg.CheckOverlap(hit0->Channel(), hit1->Channel(), fOverlapBuffer))
-          {
-            std::array<double, 6> overlap = FindOverlap(hit0, hit1);
-            
-            geo::Point_t pos, err;
-            CentralPosition(overlap, pos, err);
-
-            const double pe   = ReconstructPE(hit0, hit1, pos);
-            double time, etime;
-            CorrectTime(hit0, hit1, pos, time, etime);
+        geo::Point_t pos, err;
+        double pe, time, etime;
 
+        if(ThreeDSpacePoint(GetHitProperties(hit0), GetHitProperties(hit1), pos, err, pe, time, etime))
+          {
             spacepoint = CRTSpacePoint(pos, err, pe, time + fTimeOffset, etime, true);
             return true;
           }
@@ -84,24 +78,40 @@ namespace sbnd::crt {
 
   bool CRTClusterCharacterisationAlg::CharacteriseMultiHitCluster(const art::Ptr<CRTCluster> &cluster, const std::vector<art::Ptr<CRTStripHit>> &stripHits, CRTSpacePoint &spacepoint)
   {
-    std::vector<CRTSpacePoint> spacepoints, complete_spacepoints;
+    // Strip geometry, 3D position and PE are looked up once per hit rather
+    // than once per pairing
+    std::vector<HitProperties> hits;
+    hits.reserve(stripHits.size());
+
+    for(auto const &stripHit : stripHits)
+      hits.push_back(GetHitProperties(stripHit));
+
+    // Only hits in different layers make complete space points, so the hits are
+    // split by layer and each hit is paired with the later hits of the other layer
+    // only, in the same order as the scan over all pairs
+    std::array<std::vector<unsigned>, 2> layers;
 
-    for(unsigned i = 0; i < stripHits.size(); ++i)
+    for(unsigned i = 0; i < hits.size(); ++i)
+      layers[hits[i].orientation].push_back(i);
+
+    std::vector<CRTSpacePoint> complete_spacepoints;
+    std::array<unsigned, 2> seen = {0, 0};
+
+    for(unsigned i = 0; i < hits.size(); ++i)
       {
-        const art::Ptr<CRTStripHit> hit0 = stripHits[i];
+        const size_t layer = hits[i].orientation;
+        const std::vector<unsigned> &other = layers[1 - layer];
+        ++seen[layer];
 
-        for(unsigned ii = i + 1; ii < stripHits.size(); ++ii)
+        for(unsigned k = seen[1 - layer]; k < other.size(); ++k)
           {
-            const art::Ptr<CRTStripHit> hit1 = stripHits[ii];
-
-            CRTSpacePoint sp;
-            if(TwoHitSpacePoint(hit0, hit1, sp))
-              {
-                spacepoints.push_back(sp);
-        
-                if(sp.Complete()) 
-                  complete_spacepoints.push_back(sp);
-              }
+            const unsigned ii = other[k];
+
+            geo::Point_t sp_pos, sp_err;
+            double sp_pe, sp_time, sp_etime;
+
+            if(ThreeDSpacePoint(hits[i], hits[ii], sp_pos, sp_err, sp_pe, sp_time, sp_etime))
+              complete_spacepoints.emplace_back(sp_pos, sp_err, sp_pe, sp_time + fTimeOffset, sp_etime, true);
           }
       }
 
@@ -127,29 +137,58 @@ namespace sbnd::crt {
     return true;
   }
 
-  double CRTClusterCharacterisationAlg::ADCToPE(const uint16_t channel, const uint16_t adc1, const uint16_t adc2)
+  CRTClusterCharacterisationAlg::HitProperties CRTClusterCharacterisationAlg::GetHitProperties(const art::Ptr<CRTStripHit> &hit)
   {
-    return ADCToPE(channel, adc1) + ADCToPE(channel+1, adc2);
+    const uint16_t channel = hit->Channel();
+
+    return {hit, &fCRTGeoAlg.GetStrip(channel), fCRTGeoAlg.ChannelToOrientation(channel),
+            fCRTGeoAlg.StripHit3DPos(channel, hit->Pos(), hit->Error()),
+            ADCToPE(channel, hit->ADC1(), hit->ADC2())};
   }
 
-  double CRTClusterCharacterisationAlg::ADCToPE(const uint16_t channel, const uint16_t adc)
+  bool CRTClusterCharacterisationAlg::ThreeDSpacePoint(const HitProperties &hit0, const HitProperties &hit1, geo::Point_t &pos,
+                                                       geo::Point_t &err, double &pe, double &time, double &etime)
   {
-    return fCRTGeoAlg.GetSiPM(channel).gain * adc;
+    if(!fCRTGeoAlg.CheckOverlap(*hit0.strip, *hit1.strip, fOverlapBuffer))
+      return false;
+
+    const std::array<double, 6> overlap({std::max(hit0.pos[0], hit1.pos[0]),
+                                         std::min(hit0.pos[1], hit1.pos[1]),
+                                         std::max(hit0.pos[2], hit1.pos[2]),
+                                         std::min(hit0.pos[3], hit1.pos[3]),
+                                         std::max(hit0.pos[4], hit1.pos[4]),
+                                         std::min(hit0.pos[5], hit1.pos[5])});
+
+    CentralPosition(overlap, pos, err);
+
+    const double dist0 = fCRTGeoAlg.DistanceDownStrip(pos, *hit0.strip);
+    const double dist1 = fCRTGeoAlg.DistanceDownStrip(pos, *hit1.strip);
+
+    const double pe0 = ReconstructPE(hit0.pe, dist0);
+    const double pe1 = ReconstructPE(hit1.pe, dist1);
+
+    pe = pe0 + pe1;
+
+    const double t0 = fUseT1 ? (double)hit0.hit->Ts1() : (double)hit0.hit->Ts0();
+    const double t1 = fUseT1 ? (double)hit1.hit->Ts1() : (double)hit1.hit->Ts0();
+
+    const double corr0 = TimingCorrectionOffset(dist0, pe0);
+    const double corr1 = TimingCorrectionOffset(dist1, pe1);
+
+    time  = (t0 - corr0 + t1 - corr1) / 2.;
+    etime = std::abs((t0 - corr0) - (t1 - corr1)) / 2.;
+
+    return true;
   }
 
-  std::array<double, 6> CRTClusterCharacterisationAlg::FindOverlap(const art::Ptr<CRTStripHit> &hit0, const art::Ptr<CRTStripHit> &hit1)
+  double CRTClusterCharacterisationAlg::ADCToPE(const uint16_t channel, const uint16_t adc1, const uint16_t adc2)
   {
-    const std::array<double, 6> hit0pos = fCRTGeoAlg.StripHit3DPos(hit0->Channel(), hit0->Pos(), hit0->Error());
-    const std::array<double, 6> hit1pos = fCRTGeoAlg.StripHit3DPos(hit1->Channel(), hit1->Pos(), hit1->Error());
-
-    std::array<double, 6> overlap({std::max(hit0pos[0], hit1pos[0]),
-                                   std::min(hit0pos[1], hit1pos[1]),
-                                   std::max(hit0pos[2], hit1pos[2]),
-                                   std::min(hit0pos[3], hit1pos[3]),
-                                   std::max(hit0pos[4], hit1pos[4]),
-                                   std::min(hit0pos[5], hit1pos[5])});
+    return ADCToPE(channel, adc1) + ADCToPE(channel+1, adc2);
+  }
 
-    return overlap;
+  double CRTClusterCharacterisationAlg::ADCToPE(const uint16_t channel, const uint16_t adc)
+  {
+    return fCRTGeoAlg.GetSiPM(channel).gain * adc;
   }
 
   std::array<double, 6> CRTClusterCharacterisationAlg::FindAdjacentPosition(const art::Ptr<CRTStripHit> &hit0, const art::Ptr<CRTStripHit> &hit1)
@@ -179,46 +218,13 @@ namespace sbnd::crt {
                        std::abs((overlap[4] - overlap[5])/2.));
   }
 
-  double CRTClusterCharacterisationAlg::ReconstructPE(const art::Ptr<CRTStripHit> &hit0, const art::Ptr<CRTStripHit> &hit1, const geo::Point_t &pos)
-  {
-    const double dist0 = fCRTGeoAlg.DistanceDownStrip(pos, hit0->Channel());
-    const double dist1 = fCRTGeoAlg.DistanceDownStrip(pos, hit1->Channel());
-
-    return ReconstructPE(hit0, dist0) + ReconstructPE(hit1, dist1);
-  }
-
-  double CRTClusterCharacterisationAlg::ReconstructPE(const art::Ptr<CRTStripHit> &hit, const double dist)
+  double CRTClusterCharacterisationAlg::ReconstructPE(const double pe, const double dist)
   {
-    const double pe         = ADCToPE(hit->Channel(), hit->ADC1(), hit->ADC2());
     const double correction = std::pow(dist - fPEAttenuation, 2) / std::pow(fPEAttenuation, 2);
 
     return pe * correction;
   }
 
-  void CRTClusterCharacterisationAlg::CorrectTime(const art::Ptr<CRTStripHit> &hit0, const art::Ptr<CRTStripHit> &hit1, const geo::Point_t &pos,
-                                                  double &time, double &etime)
-  {
-    const double dist0 = fCRTGeoAlg.DistanceDownStrip(pos, hit0->Channel());
-    const double dist1 = fCRTGeoAlg.DistanceDownStrip(pos, hit1->Channel());
-
-    const double pe0 = ReconstructPE(hit0, dist0);
-    const double pe1 = ReconstructPE(hit1, dist1);
-
-    const double corr0 = TimingCorrectionOffset(dist0, pe0);
-    const double corr1 = TimingCorrectionOffset(dist1, pe1);
-
-    if(fUseT1)
-      {
-        time  = ((double)hit0->Ts1() - corr0 + (double)hit1->Ts1() - corr1) / 2.;
-        etime = std::abs(((double)hit0->Ts1() - corr0) - ((double)hit1->Ts1() - corr1)) / 2.;
-      }
-    else
-      {
-        time  = ((double)hit0->Ts0() - corr0 + (double)hit1->Ts0() - corr1) / 2.;
-        etime = std::abs(((double)hit0->Ts0() - corr0) - ((double)hit1->Ts0() - corr1)) / 2.;
-      }
-  }
-
   double CRTClusterCharacterisationAlg::TimingCorrectionOffset(const double &dist, const double &pe)
   {
     return dist * fPropDelay + fTimeWalkNorm * std::exp(-0.5 * std::pow((pe - fTimeWalkShift) / fTimeWalkSigma, 2)) + fTimeWalkOffset;
@@ -54,18 +54,11 @@ namespace sbnd::crt {
 
     double ADCToPE(const uint16_t channel, const uint16_t adc);
 
-    std::array<double, 6> FindOverlap(const art::Ptr<CRTStripHit> &hit0, const art::Ptr<CRTStripHit> &hit1);
-
     std::array<double, 6> FindAdjacentPosition(const art::Ptr<CRTStripHit> &hit0, const art::Ptr<CRTStripHit> &hit1);
 
     void CentralPosition(const std::array<double, 6> overlap, geo::Point_t &pos, geo::Point_t &err);
 
-    double ReconstructPE(const art::Ptr<CRTStripHit> &hit0, const art::Ptr<CRTStripHit> &hit1, const geo::Point_t &pos);
-
-    double ReconstructPE(const art::Ptr<CRTStripHit> &hit, const double dist);
-
-    void CorrectTime(const art::Ptr<CRTStripHit> &hit0, const art::Ptr<CRTStripHit> &hit1, const geo::Point_t &pos,
-                     double &time, double &etime);
+    double ReconstructPE(const double pe, const double dist);
 
     double TimingCorrectionOffset(const double &dist, const double &pe);
 
@@ -75,6 +68,20 @@ namespace sbnd::crt {
 
   private:
 
+    // Per-hit quantities, computed once and reused for every pairing of the hit
+    struct HitProperties {
+      art::Ptr<CRTStripHit> hit;
+      const CRTStripGeo    *strip;
+      size_t                orientation;
+      std::array<double, 6> pos;
+      double                pe;
+    };
+
+    HitProperties GetHitProperties(const art::Ptr<CRTStripHit> &hit);
+
+    bool ThreeDSpacePoint(const HitProperties &hit0, const HitProperties &hit1, geo::Point_t &pos,
+                          geo::Point_t &err, double &pe, double &time, double &etime);
+
     CRTGeoAlg fCRTGeoAlg;
 
     bool   fUseT1;
@@ -51,12 +51,19 @@ public:
 
   CRTCluster CharacteriseCluster(const std::vector<art::Ptr<CRTStripHit>> &clusteredHits);
 
+  void BuildStripOverlaps();
+
 private:
 
   CRTGeoAlg   fCRTGeoAlg;
   std::string fCRTStripHitModuleLabel;
   uint32_t    fCoincidenceTimeRequirement;
   double      fOverlapBuffer;
+
+  // Both indexed by strip ID. The overlap bits of each strip run over the
+  // strips of its own tagger, addressed by their index within that tagger.
+  std::vector<uint32_t>          fStripTaggerIndex;
+  std::vector<std::vector<bool>> fStripOverlaps;
 };
 
 
@@ -69,8 +76,45 @@ sbnd::crt::CRTClusterProducer::CRTClusterProducer(fhicl::ParameterSet const& p)
   {
     produces<std::vector<CRTCluster>>();
     produces<art::Assns<CRTCluster, CRTStripHit>>();
+
+    BuildStripOverlaps();
   }
 
+void sbnd::crt::CRTClusterProducer::BuildStripOverlaps()
+{
+  const std::vector<CRTStripGeo> &strips = fCRTGeoAlg.GetStrips();
+
+  // Strips are grouped by the same tagger enum as the hits in GroupStripHits,
+  // so all the hits of a cluster index into the same overlap rows
+  std::map<CRTTagger, std::vector<uint32_t>> taggerStrips;
+
+  for(uint32_t stripID = 0; stripID < strips.size(); ++stripID)
+    taggerStrips[fCRTGeoAlg.GetModuleByID(strips[stripID].moduleID).tagger].push_back(stripID);
+
+  fStripTaggerIndex.assign(strips.size(), 0);
+  fStripOverlaps.assign(strips.size(), std::vector<bool>());
+
+  for(auto const& [tagger, stripIDs] : taggerStrips)
+    {
+      for(uint32_t i = 0; i < stripIDs.size(); ++i)
+        {
+          fStripTaggerIndex[stripIDs[i]] = i;
+          fStripOverlaps[stripIDs[i]].resize(stripIDs.size(), false);
+        }
+
+      for(uint32_t i = 0; i < stripIDs.size(); ++i)
+        {
+          for(uint32_t ii = i; ii < stripIDs.size(); ++ii)
+            {
+              // The splitting has always used a fixed 10 cm buffer
+              const bool overlap = fCRTGeoAlg.CheckOverlap(strips[stripIDs[i]], strips[stripIDs[ii]], 10.);
+              fStripOverlaps[stripIDs[i]][ii] = overlap;
+              fStripOverlaps[stripIDs[ii]][i] = overlap;
+            }
+        }
+    }
+}
+
 void sbnd::crt::CRTClusterProducer::produce(art::Event& e)
 {
   auto clusterVec          = std::make_unique<std::vector<CRTCluster>>();
@@ -126,35 +170,25 @@ std::vector<std::pair<sbnd::crt::CRTCluster, std::vector<art::Ptr<sbnd::crt::CRT
 {
   std::vector<std::pair<CRTCluster, std::vector<art::Ptr<CRTStripHit>>>> clustersAndHits;
 
-  std::vector<bool> used(stripHits.size(), false);
+  // Hits are sorted in time so each cluster is the run of hits within the
+  // coincidence window of its first hit, and the next cluster starts at the
+  // first hit outside of it.
+  size_t i = 0;
 
-  for(uint16_t i = 0; i < stripHits.size(); ++i)
+  while(i < stripHits.size())
     {
       const art::Ptr<CRTStripHit> &initialStripHit = stripHits[i];
 
-      if(!used[i])
-        {
-          std::vector<art::Ptr<CRTStripHit>> clusteredHits;
-          clusteredHits.push_back(initialStripHit);
-          used[i] = true;
+      size_t end = i + 1;
+      while(end < stripHits.size() && stripHits[end]->Ts1() - initialStripHit->Ts1() < fCoincidenceTimeRequirement)
+        ++end;
 
-          for(uint16_t ii = i+1; ii < stripHits.size(); ++ii)
-            {
-              const art::Ptr<CRTStripHit> &stripHit = stripHits[ii];
-    
-              if(!used[ii])
-                {
-                  if(stripHit->Ts1() - initialStripHit->Ts1() < fCoincidenceTimeRequirement)
-                    {
-                      clusteredHits.push_back(stripHit);
-                      used[ii] = true;
-                    }
-                }
-            }
-          
-          const CRTCluster &cluster = CharacteriseCluster(clusteredHits);
-          clustersAndHits.emplace_back(cluster, clusteredHits);
-        }
+      const std::vector<art::Ptr<CRTStripHit>> clusteredHits(stripHits.begin() + i, stripHits.begin() + end);
+
+      const CRTCluster &cluster = CharacteriseCluster(clusteredHits);
+      clustersAndHits.emplace_back(cluster, clusteredHits);
+
+      i = end;
     }
   return SplitClusters(clustersAndHits);
 }
@@ -166,36 +200,45 @@ std::vector<std::pair<sbnd::crt::CRTCluster, std::vector<art::Ptr<sbnd::crt::CRT
 
   for(auto const& [cluster, hits] : initialClusters)
     {
-      std::map<uint16_t, std::set<uint16_t>> overlaps;
+      // All hits of a cluster are on the same tagger
+      std::vector<uint32_t> stripIDs(hits.size());
+      for(size_t j = 0; j < hits.size(); ++j)
+        stripIDs[j] = fCRTGeoAlg.GetSiPM(hits[j]->Channel()).stripID;
+
+      // Sorted sets of overlapping hits (always including the hit itself)
+      std::vector<std::vector<size_t>> overlaps(hits.size());
       
       std::vector<bool> used(hits.size(), false);
 
-      for(uint16_t j = 0; j < hits.size(); ++j)
+      for(size_t j = 0; j < hits.size(); ++j)
         {
-          const art::Ptr<CRTStripHit> &hit1 = hits[j];
-          overlaps[j] = {j};
-          
-          for(uint16_t jj = 0; jj < hits.size(); ++jj)
+          const std::vector<bool> &stripOverlaps = fStripOverlaps[stripIDs[j]];
+
+          for(size_t jj = 0; jj < hits.size(); ++jj)
             {
-              const art::Ptr<CRTStripHit> &hit2 = hits[jj];
-              if(fCRTGeoAlg.CheckOverlap(hit1->Channel(), hit2->Channel(), 10.))
-                overlaps[j].insert(jj);
+              if(jj == j || stripOverlaps[fStripTaggerIndex[stripIDs[jj]]])
+                overlaps[j].push_back(jj);
             }
         }
 
-      std::set<uint16_t> leftovers;
+      std::vector<size_t> leftovers;
       
-      for(auto const& [id, overlap_set] : overlaps)
+      for(size_t id = 0; id < overlaps.size(); ++id)
         {
           if(used[id])
             continue;
 
+          const std::vector<size_t> &overlap_set = overlaps[id];
+
           bool exclusive = true;
           
           for(auto const& id2 : overlap_set)
             {
               if(overlaps[id2] != overlap_set)
-                exclusive = false;
+                {
+                  exclusive = false;
+                  break;
+                }
             }
           
           if(exclusive)
@@ -212,7 +255,7 @@ std::vector<std::pair<sbnd::crt::CRTCluster, std::vector<art::Ptr<sbnd::crt::CRT
               clustersAndHits.emplace_back(cluster, newClusteredHits);
             }
           else
-            leftovers.insert(id);
+            leftovers.push_back(id);
         }
       
       std::vector<art::Ptr<CRTStripHit>> leftoverClusteredHits;
@@ -234,21 +277,21 @@ sbnd::crt::CRTCluster sbnd::crt::CRTClusterProducer::CharacteriseCluster(const s
 {
   const uint16_t nHits = clusteredHits.size();
 
-  const CRTStripGeo strip0 = fCRTGeoAlg.GetStrip(clusteredHits.at(0)->Channel());
+  const CRTStripGeo &strip0 = fCRTGeoAlg.GetStrip(clusteredHits.at(0)->Channel());
   const CRTTagger tagger = fCRTGeoAlg.ChannelToTaggerEnum(clusteredHits.at(0)->Channel());
 
   uint32_t ts0 = 0, ts1 = 0, s = 0;
   CoordSet composition = kUndefinedSet;
 
-  for(uint16_t i = 0; i < clusteredHits.size(); ++i)
+  for(size_t i = 0; i < clusteredHits.size(); ++i)
     {
-      const art::Ptr<CRTStripHit> hit = clusteredHits[i];
+      const art::Ptr<CRTStripHit> &hit = clusteredHits[i];
 
       ts0 += hit->Ts0();
       ts1 += hit->Ts1();
       s   += hit->UnixS();
 
-      const CRTStripGeo strip = fCRTGeoAlg.GetStrip(hit->Channel());
+      const CRTStripGeo &strip = fCRTGeoAlg.GetStrip(hit->Channel());
       if(fCRTGeoAlg.DifferentOrientations(strip0, strip))
         composition = kXYZ;
     }
@@ -101,7 +101,7 @@ std::vector<sbnd::crt::CRTStripHit> sbnd::crt::CRTStripHitProducer::CreateStripH
   if(data->Flags() != 3)
     return stripHits;
   
-  const CRTModuleGeo module = fCRTGeoAlg.GetModule(mac5 * 32);
+  const CRTModuleGeo &module = fCRTGeoAlg.GetModule(mac5 * 32);
 
   // Correct for FEB readout cable length
   // (time is FEB-by-FEB not channel-by-channel)
@@ -115,9 +115,9 @@ std::vector<sbnd::crt::CRTStripHit> sbnd::crt::CRTStripHitProducer::CreateStripH
       // Calculate SiPM channel number
       const uint16_t channel = mac5 * 32 + adc_i;
 
-      const CRTStripGeo strip = fCRTGeoAlg.GetStrip(channel);
-      const CRTSiPMGeo sipm1  = fCRTGeoAlg.GetSiPM(channel);
-      const CRTSiPMGeo sipm2  = fCRTGeoAlg.GetSiPM(channel+1);
+      const CRTStripGeo &strip = fCRTGeoAlg.GetStrip(channel);
+      const CRTSiPMGeo &sipm1  = fCRTGeoAlg.GetSiPM(channel);
+      const CRTSiPMGeo &sipm2  = fCRTGeoAlg.GetSiPM(channel+1);
 
       // Subtract channel pedestals
       const uint16_t adc1 = sipm1.pedestal < sipm_adcs[adc_i]   ? sipm_adcs[adc_i] - sipm1.pedestal   : 0;
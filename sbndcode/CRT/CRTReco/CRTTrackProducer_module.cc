@@ -97,6 +97,9 @@ private:
   std::string fCRTSpacePointModuleLabel;
   double      fCoincidenceTimeRequirement;
   double      fThirdSpacePointMaximumDCA;
+
+  // Position of each tagger along the coordinate it constrains
+  std::map<CRTTagger, double> fTaggerPlanePositions;
 };
 
 
@@ -109,6 +112,24 @@ sbnd::crt::CRTTrackProducer::CRTTrackProducer(fhicl::ParameterSet const& p)
   {
     produces<std::vector<CRTTrack>>();
     produces<art::Assns<CRTSpacePoint, CRTTrack>>();
+
+    for(auto const& taggerGeo : fCRTGeoAlg.GetTaggers())
+      {
+        switch(CRTCommonUtils::GetTaggerDefinedCoordinate(taggerGeo.tagger))
+          {
+          case kX:
+            fTaggerPlanePositions[taggerGeo.tagger] = (taggerGeo.maxX + taggerGeo.minX) / 2.;
+            break;
+          case kY:
+            fTaggerPlanePositions[taggerGeo.tagger] = (taggerGeo.maxY + taggerGeo.minY) / 2.;
+            break;
+          case kZ:
+            fTaggerPlanePositions[taggerGeo.tagger] = (taggerGeo.maxZ + taggerGeo.minZ) / 2.;
+            break;
+          default:
+            break;
+          }
+      }
   }
 
 void sbnd::crt::CRTTrackProducer::produce(art::Event& e)
@@ -157,44 +178,49 @@ std::vector<std::pair<sbnd::crt::CRTTrack, std::set<unsigned>>> sbnd::crt::CRTTr
 {
   std::vector<std::pair<CRTTrack, std::set<unsigned>>> candidates;
 
+  // Look up the tagger of each space point once rather than once per pairing
+  std::vector<CRTTagger> taggers;
+  taggers.reserve(spacePointVec.size());
+  for(auto const& spacePoint : spacePointVec)
+    taggers.push_back(spacePointsToCluster.at(spacePoint.key())->Tagger());
+
+  // Space points are ordered in time, so each search stops at the first
+  // space point outside the coincidence window of the primary.
   for(unsigned i = 0; i < spacePointVec.size(); ++i)
     {
-      const art::Ptr<CRTSpacePoint> primarySpacePoint = spacePointVec[i];
-      const art::Ptr<CRTCluster> primaryCluster       = spacePointsToCluster.at(primarySpacePoint.key());
+      const art::Ptr<CRTSpacePoint> &primarySpacePoint = spacePointVec[i];
+      const CRTTagger primaryTagger                    = taggers[i];
 
       for(unsigned ii = i+1; ii < spacePointVec.size(); ++ii)
         {
-          const art::Ptr<CRTSpacePoint> secondarySpacePoint = spacePointVec[ii];
-          const art::Ptr<CRTCluster> secondaryCluster       = spacePointsToCluster.at(secondarySpacePoint.key());
+          const art::Ptr<CRTSpacePoint> &secondarySpacePoint = spacePointVec[ii];
+          const CRTTagger secondaryTagger                    = taggers[ii];
 
-          if(secondarySpacePoint->Time() - primarySpacePoint->Time() > fCoincidenceTimeRequirement ||
-             secondaryCluster->Tagger() == primaryCluster->Tagger())
+          if(secondarySpacePoint->Time() - primarySpacePoint->Time() > fCoincidenceTimeRequirement)
+            break;
+
+          if(secondaryTagger == primaryTagger)
             continue;
 
           const geo::Point_t &start = primarySpacePoint->Pos();
           const geo::Point_t &end   = secondarySpacePoint->Pos();
           const geo::Vector_t &dir  = (end - start).Unit();
 
-          if(CRTCommonUtils::IsTopTagger(primaryCluster->Tagger()) || CRTCommonUtils::IsTopTagger(secondaryCluster->Tagger()))
+          if(CRTCommonUtils::IsTopTagger(primaryTagger) || CRTCommonUtils::IsTopTagger(secondaryTagger))
             {
               for(unsigned iii = ii + 1; iii < spacePointVec.size(); ++iii)
                 {
-                  const art::Ptr<CRTSpacePoint> tertiarySpacePoint = spacePointVec[iii];
-                  const art::Ptr<CRTCluster> tertiaryCluster       = spacePointsToCluster.at(tertiarySpacePoint.key());
+                  const art::Ptr<CRTSpacePoint> &tertiarySpacePoint = spacePointVec[iii];
+                  const CRTTagger tertiaryTagger                    = taggers[iii];
 
-                  if(!CRTCommonUtils::CoverTopTaggers(primaryCluster->Tagger(), secondaryCluster->Tagger(), tertiaryCluster->Tagger()))
-                    continue;
+                  // Also guarantees the tertiary is within the window of the secondary
+                  if(tertiarySpacePoint->Time() - primarySpacePoint->Time() > fCoincidenceTimeRequirement)
+                    break;
 
-                  if(tertiarySpacePoint->Time() - primarySpacePoint->Time() > fCoincidenceTimeRequirement ||
-                     tertiaryCluster->Tagger() == primaryCluster->Tagger())
+                  if(tertiaryTagger == primaryTagger || tertiaryTagger == secondaryTagger ||
+                     !CRTCommonUtils::CoverTopTaggers(primaryTagger, secondaryTagger, tertiaryTagger))
                     continue;
 
-                  if(tertiarySpacePoint->Time() - secondarySpacePoint->Time() > fCoincidenceTimeRequirement ||
-                     tertiaryCluster->Tagger() == secondaryCluster->Tagger())
-                    continue;
-
-                  const CRTTagger &tertiaryTagger = tertiaryCluster->Tagger();
-
                   const double dca = DistanceOfClosestApproach(tertiaryTagger, tertiarySpacePoint, start, dir);
 
                   if(dca < fThirdSpacePointMaximumDCA)
@@ -206,13 +232,13 @@ std::vector<std::pair<sbnd::crt::CRTTrack, std::set<unsigned>>> sbnd::crt::CRTTr
 
                       const double pe = primarySpacePoint->PE() + secondarySpacePoint->PE() + tertiarySpacePoint->PE();
 
-                      const std::set<CRTTagger> used_taggers = {primaryCluster->Tagger(), secondaryCluster->Tagger(), tertiaryCluster->Tagger()};
+                      const std::set<CRTTagger> used_taggers = {primaryTagger, secondaryTagger, tertiaryTagger};
  
                       geo::Point_t fitStart, fitMid, fitEnd;
                       double gof;
                       
-                      BestFitLine(primarySpacePoint->Pos(), secondarySpacePoint->Pos(), tertiarySpacePoint->Pos(), primaryCluster->Tagger(), 
-                                  secondaryCluster->Tagger(), tertiaryCluster->Tagger(), fitStart, fitMid, fitEnd, gof);
+                      BestFitLine(primarySpacePoint->Pos(), secondarySpacePoint->Pos(), tertiarySpacePoint->Pos(), primaryTagger, 
+                                  secondaryTagger, tertiaryTagger, fitStart, fitMid, fitEnd, gof);
 
                       const CRTTrack track({fitStart, fitMid, fitEnd}, time, etime, pe, tof, used_taggers);
                       const std::set<unsigned> used_spacepoints = {i, ii, iii};
@@ -228,7 +254,7 @@ std::vector<std::pair<sbnd::crt::CRTTrack, std::set<unsigned>>> sbnd::crt::CRTTr
 
           const double pe = primarySpacePoint->PE() + secondarySpacePoint->PE();
 
-          const std::set<CRTTagger> used_taggers = {primaryCluster->Tagger(), secondaryCluster->Tagger()};
+          const std::set<CRTTagger> used_taggers = {primaryTagger, secondaryTagger};
 
           const CRTTrack track(start, end, time, etime, pe, tof, used_taggers);
           const std::set<unsigned> used_spacepoints = {i, ii};
@@ -269,15 +295,18 @@ std::vector<std::pair<sbnd::crt::CRTTrack, std::set<unsigned>>> sbnd::crt::CRTTr
 {
   std::vector<std::pair<sbnd::crt::CRTTrack, std::set<unsigned>>> chosenTracks;
 
-  std::set<unsigned> used;
+  std::vector<bool> used;
 
   for(auto const& [track, spIDs] : trackCandidates)
     {
       bool keep = true;
       for(auto const& spID : spIDs)
         {
-          if(used.count(spID) != 0)
-            keep = false;
+          if(spID < used.size() && used[spID])
+            {
+              keep = false;
+              break;
+            }
         }
       
       if(keep)
@@ -285,7 +314,11 @@ std::vector<std::pair<sbnd::crt::CRTTrack, std::set<unsigned>>> sbnd::crt::CRTTr
           chosenTracks.emplace_back(track, spIDs);
 
           for(auto const& spID : spIDs)
-            used.insert(spID);
+            {
+              if(spID >= used.size())
+                used.resize(spID + 1, false);
+              used[spID] = true;
+            }
         }
     }
 
@@ -439,28 +472,19 @@ void sbnd::crt::CRTTrackProducer::BestFitLine(const geo::Point_t &a, const geo::
 geo::Point_t sbnd::crt::CRTTrackProducer::LineTaggerIntersectionPoint(const geo::Point_t &start, const geo::Vector_t &dir, const CRTTagger &tagger)
 {
   const CoordSet constrainedPlane = CRTCommonUtils::GetTaggerDefinedCoordinate(tagger);
-  const CRTTaggerGeo taggerGeo    = fCRTGeoAlg.GetTagger(CRTCommonUtils::GetTaggerName(tagger));
+  const double planePosition      = fTaggerPlanePositions.at(tagger);
   double k;
 
   switch(constrainedPlane)
     {
     case kX:
-      {
-        const double x = (taggerGeo.maxX + taggerGeo.minX) / 2.;
-        k =  (x - start.X()) / dir.X();
-      }
+      k = (planePosition - start.X()) / dir.X();
       break;
     case kY:
-      {
-        const double y = (taggerGeo.maxY + taggerGeo.minY) / 2.;
-        k = (y - start.Y()) / dir.Y();
-      }
+      k = (planePosition - start.Y()) / dir.Y();
       break;
     case kZ:
-      {
-        const double z = (taggerGeo.maxZ + taggerGeo.minZ) / 2.;
-        k = (z - start.Z()) / dir.Z();
-      }
+      k = (planePosition - start.Z()) / dir.Z();
       break;
     default:
       std::cout << "Tagger not defined in one plane" << std::endl;
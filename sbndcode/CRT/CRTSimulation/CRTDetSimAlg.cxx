@@ -10,6 +10,7 @@ namespace crt {
     : fParams(params())
     , fEngine(engine)
     , fG4RefTime(g4RefTime)
+    , fDoWaveformEmulation(fParams.DoWaveformEmulation())
     {
         ConfigureWaveform();
         ConfigureTimeOffset();
@@ -17,6 +18,16 @@ namespace crt {
         fTaggers.clear();
         fData.clear();
         fAuxData.clear();
+
+        // One tagger per geometry tagger, simulated in name order
+        fTaggers.resize(fCRTGeoAlg.NumTaggers());
+
+        fTaggerOrder.resize(fCRTGeoAlg.NumTaggers());
+        std::iota(fTaggerOrder.begin(), fTaggerOrder.end(), 0);
+        std::sort(fTaggerOrder.begin(), fTaggerOrder.end(),
+                  [this](const uint16_t a, const uint16_t b) {
+                    return fCRTGeoAlg.GetTaggerByID(a).name < fCRTGeoAlg.GetTaggerByID(b).name;
+                  });
     }
 
 
@@ -33,11 +44,16 @@ namespace crt {
         // estimate its effect on time delays.
         std::reverse(wvf_y.begin(),wvf_y.end());
 
-        fInterpolator = std::make_unique<ROOT::Math::Interpolator>
-            (wvf_y.size(), ROOT::Math::Interpolation::kLINEAR);
+        ROOT::Math::Interpolator interpolator(wvf_y.size(), ROOT::Math::Interpolation::kLINEAR);
+        interpolator.SetData(wvf_x, wvf_y);
 
-        fInterpolator->SetData(wvf_x, wvf_y);
+        // Time delays are integer clock ticks, so tabulate the waveform
+        // on every tick up to the end of the waveform.
+        const size_t n_ticks = static_cast<size_t>(std::floor(wvf_x.back())) + 1;
 
+        fWaveformTable.resize(n_ticks);
+        for (size_t t = 0; t < n_ticks; t++)
+            fWaveformTable[t] = interpolator.Eval(t);
     }
 
     void CRTDetSimAlg::ConfigureTimeOffset()
@@ -56,12 +72,12 @@ namespace crt {
         }
     }
 
-    std::vector<std::pair<FEBData, std::vector<AuxDetIDE>>> CRTDetSimAlg::GetData()
+    const std::vector<std::pair<FEBData, std::vector<AuxDetIDE>>> & CRTDetSimAlg::GetData() const
     {
         return fData;
     }
 
-    std::vector<std::vector<int>> CRTDetSimAlg::GetAuxData()
+    const std::vector<std::vector<int>> & CRTDetSimAlg::GetAuxData() const
     {
         return fAuxData;
     }
@@ -71,18 +87,12 @@ namespace crt {
     uint16_t CRTDetSimAlg::WaveformEmulation(const uint32_t & time_delay, const double & adc)
     {
 
-        if (!fParams.DoWaveformEmulation())
+        if (!fDoWaveformEmulation)
         {
             return static_cast<uint16_t>(adc);
         }
 
-        if (time_delay < 0)
-        {
-            throw art::Exception(art::errors::LogicError)
-                << "Time delay cannot be negative for waveform emulation to happen." << std::endl;
-        }
-
-        if (time_delay > fParams.WaveformX().back())
+        if (time_delay >= fWaveformTable.size())
         {
             // If the time delay is more than the waveform rise time, we
             // will never be able to see this signal. So return a 0 ADC value.
@@ -90,8 +100,7 @@ namespace crt {
         }
 
         // Evaluate the waveform
-        double wf = fInterpolator->Eval(time_delay);
-        wf *= adc;
+        double wf = fWaveformTable[time_delay] * adc;
 
         if (fParams.DebugTrigger()) std::cout << "WaveformEmulation, time_delay " << time_delay
                                               << ", adc " << adc
@@ -101,99 +110,128 @@ namespace crt {
     }
 
 
-    void CRTDetSimAlg::AddADC(FEBData & feb_data,
-                              const int & sipmID, const uint16_t & adc)
+    void CRTDetSimAlg::AddADCs(FEBData & feb_data,
+                               const std::array<uint32_t, 32> & adcs, const uint32_t hit_mask)
     {
-        uint16_t original_adc = feb_data.ADC(sipmID);
-        uint16_t new_adc = original_adc + adc;
+        const uint32_t saturation = fParams.AdcSaturation();
 
-        if (new_adc > fParams.AdcSaturation())
+        for (int sipmID = 0; sipmID < 32; sipmID++)
         {
-            new_adc = fParams.AdcSaturation();
-        }
+            if (!(hit_mask & (1u << sipmID))) continue;
+
+            uint16_t original_adc = feb_data.ADC(sipmID);
+            uint32_t new_adc = original_adc + adcs[sipmID];
 
-        feb_data.SetADC(sipmID, new_adc);
+            if (new_adc > saturation)
+            {
+                new_adc = saturation;
+            }
 
-        if (fParams.DebugTrigger()) std::cout << "Updating ADC value for FEB " << feb_data.Mac5()
-                                              << ", sipmID " << sipmID
-                                              << " with adc " << adc
-                                              << ": was " << original_adc
-                                              << ", now is " << feb_data.ADC(sipmID) << std::endl;
+            feb_data.SetADC(sipmID, new_adc);
 
+            if (fParams.DebugTrigger()) std::cout << "Updating ADC value for FEB " << feb_data.Mac5()
+                                                  << ", sipmID " << sipmID
+                                                  << " with adc " << adcs[sipmID]
+                                                  << ": was " << original_adc
+                                                  << ", now is " << feb_data.ADC(sipmID) << std::endl;
+        }
     }
 
 
 
 
-    void CRTDetSimAlg::ProcessStrips(const std::vector<StripData> & strips)
+    void CRTDetSimAlg::ProcessStrips(const std::vector<StripData> & strips, const std::vector<size_t> & indices)
     {
-        std::map<uint16_t, FEBData> mac_to_febdata;
-        std::map<uint16_t, std::vector<AuxDetIDE>> mac_to_ides;
-        std::map<uint16_t, std::vector<int>> mac_to_sipmids;
-
         // TODO Add pedestal fluctuations
         std::array<uint16_t, 32> adc_pedestal = {static_cast<uint16_t>(fParams.QPed())};
 
-        for (auto & strip : strips)
+        // Find the FEBs read out by this trigger, and the first strip seen on each
+        fTriggerFEBs.clear();
+        for (const size_t i : indices)
         {
+            const uint16_t mac5 = strips[i].mac5;
 
-            // First time we encounter this FEB...
-            if (!mac_to_febdata.count(strip.mac5))
+            if (mac5 >= fFEBSlots.size()) fFEBSlots.resize(mac5 + 1, -1);
+
+            if (fFEBSlots[mac5] == -1)
             {
-                // Construct a new FEBData object with only pedestal values (will be filled later)
-                mac_to_febdata[strip.mac5] = FEBData(strip.mac5,          // FEB ID
-                                                     strip.flags,         // Flags
-                                                     strip.sipm0.t0,      // Ts0
-                                                     strip.sipm0.t1,      // Ts1
-                                                     strip.unixs,         // UnixS
-                                                     adc_pedestal,        // ADCs
-                                                     strip.sipm0.sipmID); // Coinc
-
-                mac_to_ides[strip.mac5] = std::vector<AuxDetIDE>();
-                mac_to_sipmids[strip.mac5] = std::vector<int>();
+                fFEBSlots[mac5] = 0;
+                fTriggerFEBs.emplace_back(mac5, i);
             }
-            // ... all the other times we encounter this FEB
-            else
+        }
+
+        // FEBData objects are stored in mac5 order
+        std::sort(fTriggerFEBs.begin(), fTriggerFEBs.end());
+
+        const size_t first_slot = fData.size();
+
+        for (auto const& [mac5, first] : fTriggerFEBs)
+        {
+            auto & strip = strips[first];
+
+            fFEBSlots[mac5] = fData.size();
+
+            // Construct a new FEBData object with only pedestal values (will be filled later)
+            fData.emplace_back(FEBData(strip.mac5,          // FEB ID
+                                       strip.flags,         // Flags
+                                       strip.sipm0.t0,      // Ts0
+                                       strip.sipm0.t1,      // Ts1
+                                       strip.unixs,         // UnixS
+                                       adc_pedestal,        // ADCs
+                                       strip.sipm0.sipmID), // Coinc
+                               std::vector<AuxDetIDE>());
+            fAuxData.emplace_back();
+        }
+
+        // We want to save the earliest t1 and t0 for each FEB.
+        for (const size_t i : indices)
+        {
+            auto & strip = strips[i];
+            auto & feb_data = fData[fFEBSlots[strip.mac5]].first;
+
+            if (strip.sipm0.t1 < feb_data.Ts1())
             {
-                // We want to save the earliest t1 and t0 for each FEB.
-                if (strip.sipm0.t1 < mac_to_febdata[strip.mac5].Ts1())
-                {
-                    mac_to_febdata[strip.mac5].SetFlags(strip.flags);
-                    mac_to_febdata[strip.mac5].SetTs1(strip.sipm0.t1);
-                    mac_to_febdata[strip.mac5].SetTs0(strip.sipm0.t0);
-                    mac_to_febdata[strip.mac5].SetUnixS(strip.unixs);
-                    mac_to_febdata[strip.mac5].SetCoinc(strip.sipm0.sipmID);
-                }
+                feb_data.SetFlags(strip.flags);
+                feb_data.SetTs1(strip.sipm0.t1);
+                feb_data.SetTs0(strip.sipm0.t0);
+                feb_data.SetUnixS(strip.unixs);
+                feb_data.SetCoinc(strip.sipm0.sipmID);
             }
         }
 
+        // Accumulate the emulated ADCs of each FEB, all 32 channels are then
+        // added to the pedestals at once.
+        fFEBADCs.assign(fTriggerFEBs.size(), {});
+        fFEBHitMasks.assign(fTriggerFEBs.size(), 0);
 
-        for (auto & strip : strips)
+        for (const size_t i : indices)
         {
+            auto & strip = strips[i];
+            const int slot = fFEBSlots[strip.mac5];
 
-            auto &feb_data = mac_to_febdata[strip.mac5];
+            auto & [feb_data, ides] = fData[slot];
             uint32_t trigger_time = feb_data.Ts1();
 
             uint16_t adc_sipm0 = WaveformEmulation(strip.sipm0.t1 - trigger_time, strip.sipm0.adc);
             uint16_t adc_sipm1 = WaveformEmulation(strip.sipm1.t1 - trigger_time, strip.sipm1.adc);
 
-            AddADC(feb_data, strip.sipm0.sipmID, adc_sipm0);
-            AddADC(feb_data, strip.sipm1.sipmID, adc_sipm1);
+            auto & adcs = fFEBADCs[slot - first_slot];
+            adcs[strip.sipm0.sipmID] += adc_sipm0;
+            adcs[strip.sipm1.sipmID] += adc_sipm1;
+            fFEBHitMasks[slot - first_slot] |= (1u << strip.sipm0.sipmID) | (1u << strip.sipm1.sipmID);
 
-            auto &ides = mac_to_ides[strip.mac5];
             ides.push_back(strip.ide);
-
-            auto &sipmids = mac_to_sipmids[strip.mac5];
-            sipmids.push_back(std::min(strip.sipm0.sipmID, strip.sipm1.sipmID));
+            fAuxData[slot].push_back(std::min(strip.sipm0.sipmID, strip.sipm1.sipmID));
         }
 
-        for (auto const& [mac, feb_data] : mac_to_febdata)
-        {
-            fData.push_back(std::make_pair(feb_data, mac_to_ides[mac]));
-            fAuxData.push_back(mac_to_sipmids[mac]);
-        }
+        for (size_t k = 0; k < fTriggerFEBs.size(); k++)
+            AddADCs(fData[first_slot + k].first, fFEBADCs[k], fFEBHitMasks[k]);
+
+        // Release the slots for the next trigger
+        for (auto const& [mac5, first] : fTriggerFEBs)
+            fFEBSlots[mac5] = -1;
 
-        if (fParams.DebugTrigger()) std::cout << "Constructed " << mac_to_febdata.size()
+        if (fParams.DebugTrigger()) std::cout << "Constructed " << fTriggerFEBs.size()
                                               << " FEBData object(s)." << std::endl << std::endl;
     }
 
@@ -209,18 +247,26 @@ namespace crt {
             double _dead_time;
             bool _planeX;
             bool _planeY;
-            std::set<int> _mac5s;
-            std::vector<StripData> _strips;
+            std::vector<uint16_t> _mac5s;
+            std::vector<size_t> _strips;
             uint32_t _trigger_time;
             bool _debug;
 
-            Trigger(bool is_bottom, double dead_time, bool debug) {
+            Trigger(double dead_time, bool debug) {
                 _planeX = _planeY = false;
-                _is_bottom = is_bottom;
+                _is_bottom = false;
                 _dead_time = dead_time;
                 _debug = debug;
             }
 
+            /** \brief Prepares this trigger object for a new tagger */
+            void clear(bool is_bottom) {
+                _planeX = _planeY = false;
+                _strips.clear();
+                _mac5s.clear();
+                _is_bottom = is_bottom;
+            }
+
             /** \brief Resets this trigger object */
             void reset(uint32_t trigger_time) {
                 _planeX = _planeY = false;
@@ -231,10 +277,11 @@ namespace crt {
                 if(_debug) std::cout << "TRIGGER TIME IS " << _trigger_time << std::endl;
             }
 
-            /** \brief Add a strip belonging to a particular trigger */
-            void add_strip(StripData strip) {
-                _strips.push_back(strip);
-                _mac5s.insert(strip.mac5);
+            /** \brief Add a strip (index i in the tagger) belonging to a particular trigger */
+            void add_strip(const StripData & strip, size_t i) {
+                _strips.push_back(i);
+                if (std::find(_mac5s.begin(), _mac5s.end(), strip.mac5) == _mac5s.end())
+                    _mac5s.push_back(strip.mac5);
 
                 if (strip.sipm_coinc) {
                     if (strip.orientation == 0) _planeX = true;
@@ -256,18 +303,18 @@ namespace crt {
 
             /** \brief Returns true is the strip is in dead time */
             bool is_in_dead_time(int mac5, int time) {
-                if (!_mac5s.count(mac5)) { return false; }
+                if (std::find(_mac5s.begin(), _mac5s.end(), mac5) == _mac5s.end()) { return false; }
                 return (time <= _dead_time);
             }
 
-            void print_no_coinc(StripData strip) {
+            void print_no_coinc(const StripData & strip) {
                 if (_debug) std::cout << "\tStrip with mac " << strip.mac5
                                      << " on plane " << strip.orientation
                                      << ", with time " << strip.sipm0.t1
                                      << " -> didn't have SiPMs coincidence" << std::endl;
             }
 
-            void print_dead_time(StripData strip) {
+            void print_dead_time(const StripData & strip) {
                 if (_debug) std::cout << "\tStrip with mac " << strip.mac5
                                      << " on plane " << strip.orientation
                                      << ", with time " << strip.sipm0.t1
@@ -276,16 +323,23 @@ namespace crt {
         };
 
 
+        Trigger trigger(fParams.DeadTime(), fParams.DebugTrigger());
+
         // Loop over all the CRT Taggers and simulate triggering, dead time, ...
-        for (auto iter : fTaggers)
+        // Taggers are independent of each other and no random numbers are drawn here.
+        for (const uint16_t taggerID : fTaggerOrder)
         {
-            auto & name = iter.first;
-            auto & tagger = iter.second;
+            auto & tagger = fTaggers[taggerID];
+
+            if (tagger.data.empty())
+                continue;
+
+            const std::string & name = fCRTGeoAlg.GetTaggerByID(taggerID).name;
 
            mf::LogInfo("CRTDetSimAlg") << "Simulating trigger for tagger " << name << std::endl;
 
             bool is_bottom = name.find("Bottom") != std::string::npos;
-            Trigger trigger(is_bottom, fParams.DeadTime(), fParams.DebugTrigger());
+            trigger.clear(is_bottom);
 
             auto & strip_data_v = tagger.data;
 
@@ -317,7 +371,7 @@ namespace crt {
                 // Save strips belonging to this trigger
                 if (current_time - trigger_ts1 < fParams.TaggerPlaneCoincidenceWindow())
                 {
-                    trigger.add_strip(strip_data);
+                    trigger.add_strip(strip_data, i);
                 }
                 // Create a new trigger if either the current tagger is not trigger, or,
                 // if it is triggered, if we are past the dead time. Also, always require
@@ -328,7 +382,7 @@ namespace crt {
                          strip_data.sipm_coinc)
                 {
                     if (trigger.tagger_triggered()) {
-                        ProcessStrips(trigger._strips);
+                        ProcessStrips(strip_data_v, trigger._strips);
                     }
 
                     // Set the current, new, trigger
@@ -338,7 +392,7 @@ namespace crt {
                     trigger.reset(trigger_ts1);
 
                     // Add this strip, which created the trigger
-                    trigger.add_strip(strip_data);
+                    trigger.add_strip(strip_data, i);
                 }
                 else if (!strip_data.sipm_coinc)
                 {
@@ -352,7 +406,7 @@ namespace crt {
             } // loop over strips
 
             if (trigger.tagger_triggered()) {
-                ProcessStrips(trigger._strips);
+                ProcessStrips(strip_data_v, trigger._strips);
             }
 
         } // loop over taggers
@@ -363,16 +417,18 @@ namespace crt {
 
 
     void CRTDetSimAlg::FillTaggers(const uint32_t adid, const uint32_t adsid,
-                                   vector<sim::AuxDetIDE> ides) {
-
-        // Return the vector of IDEs
-        std::sort(ides.begin(), ides.end(),
-                  [](const sim::AuxDetIDE & a, const sim::AuxDetIDE & b) -> bool{
-                    return ((a.entryT + a.exitT)/2) < ((b.entryT + b.exitT)/2);
+                                   const vector<sim::AuxDetIDE> & ides) {
+
+        // Time order the IDEs, without copying them
+        fIDEOrder.resize(ides.size());
+        std::iota(fIDEOrder.begin(), fIDEOrder.end(), 0);
+        std::sort(fIDEOrder.begin(), fIDEOrder.end(),
+                  [&ides](const size_t a, const size_t b) -> bool{
+                    return ((ides[a].entryT + ides[a].exitT)/2) < ((ides[b].entryT + ides[b].exitT)/2);
                   });
 
-        const CRTStripGeo strip   = fCRTGeoAlg.GetStripByAuxDetIndices(adid, adsid);
-        const CRTModuleGeo module = fCRTGeoAlg.GetModule(strip.moduleName);
+        const CRTStripGeo &strip   = fCRTGeoAlg.GetStripByAuxDetIndices(adid, adsid);
+        const CRTModuleGeo &module = fCRTGeoAlg.GetModuleByID(strip.moduleID);
 	
 	if(module.minos)
 	  return;
@@ -381,11 +437,20 @@ namespace crt {
         const uint16_t mac5 = adid;
         const uint16_t orientation = module.orientation;
 
+        // Retrive the Tagger object
+        Tagger& tagger = fTaggers[module.taggerID];
+
+        // Give the flags parameter values 3 as all should be "data events"
+        const uint16_t flags = 3;
+
+        // Use the current server time to give us a unix timestamp
+        const uint32_t unixs = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+
         // Simulate the CRT response for each hit
         mf::LogInfo("CRTDetSimAlg") << "We have " << ides.size() << " IDE for this SimChannel." << std::endl;
-        for (size_t ide_i = 0; ide_i < ides.size(); ide_i++) {
+        for (const size_t ide_i : fIDEOrder) {
 
-            sim::AuxDetIDE ide = ides[ide_i];
+            const sim::AuxDetIDE & ide = ides[ide_i];
 
             // Finally, what is the distance from the hit (centroid of the entry
             // and exit points) to the readout end?
@@ -454,12 +519,6 @@ namespace crt {
             double threshold = static_cast<double>(fParams.QThreshold());
             bool sipm_coinc = false;
 
-            // Give the flags parameter values 3 as all should be "data events"
-            const uint16_t flags = 3;
-
-            // Use the current server time to give us a unix timestamp
-            const uint32_t unixs = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
-
             if (q0 > threshold &&
                 q1 > threshold &&
                 lar::util::absDiff(ts1_ch0, ts1_ch1) < fParams.StripCoincidenceWindow())
@@ -487,18 +546,14 @@ namespace crt {
                                       ts1_ch1,
                                       q1);
 
-            StripData strip_data = StripData(mac5,
-                                             flags,
-                                             orientation,
-                                             sipm0,
-                                             sipm1,
-                                             unixs,
-                                             sipm_coinc,
-                                             ide);
-
-            // Retrive the Tagger object
-            Tagger& tagger = fTaggers[module.taggerName];
-            tagger.data.push_back(strip_data);
+            tagger.data.emplace_back(mac5,
+                                     flags,
+                                     orientation,
+                                     sipm0,
+                                     sipm1,
+                                     unixs,
+                                     sipm_coinc,
+                                     ide);
 
             mf::LogInfo("CRTDetSimAlg")
                 << "CRT HIT in adid/adsid " << adid << "/" << adsid << "\n"
@@ -608,8 +663,10 @@ namespace crt {
 
     void CRTDetSimAlg::ClearTaggers()
     {
+        // Keep the per-tagger buffers allocated across events
+        for (auto & tagger : fTaggers)
+            tagger.data.clear();
 
-        fTaggers.clear();
         fData.clear();
         fAuxData.clear();
     }
@@ -34,11 +34,13 @@
 //C++ includes
 #include <cmath>
 #include <map>
+#include <numeric>
 #include <set>
 #include <vector>
 #include <string>
 #include <utility>
 #include <algorithm>
+#include <array>
 #include <chrono>
 
 // ROOT includes
@@ -149,7 +151,7 @@ public:
      * @param adsid The AuxDetSensitiveChannelID
      * @param ides The vector of AuxDetIDE
      */
-    void FillTaggers(const uint32_t adid, const uint32_t adsid, std::vector<AuxDetIDE> ides);
+    void FillTaggers(const uint32_t adid, const uint32_t adsid, const std::vector<AuxDetIDE> & ides);
 
     /**
      * Returns FEBData objects.
@@ -169,14 +171,14 @@ public:
      *
      * @return Vector of pairs (FEBData, vector of AuxDetIDE)
      */
-    std::vector<std::pair<FEBData, std::vector<AuxDetIDE>>> GetData();
+    const std::vector<std::pair<FEBData, std::vector<AuxDetIDE>>> & GetData() const;
 
     /**
      * Returns the indeces of SiPMs associated to the AuxDetIDEs
      *
      * @return Vector of vector (1: FEBs, 2: SiPMs indeces per AuxDetIDE)
      */
-    std::vector<std::vector<int>> GetAuxData();
+    const std::vector<std::vector<int>> & GetAuxData() const;
 
 
     /**
@@ -239,9 +241,23 @@ private:
     double fG4RefTime; //!< The G4 reference time that can be used as a time offset
     double fTimeOffset; //!< The time that will be used in the simulation
 
-    std::unique_ptr<ROOT::Math::Interpolator> fInterpolator; //!< The interpolator used to estimate the CRT waveform
+    bool fDoWaveformEmulation; //!< Whether to perform the waveform emulation
 
-    std::map<std::string, Tagger> fTaggers; //!< A list of hit taggers, before any coincidence requirement (name -> tagger)
+    std::vector<double> fWaveformTable; //!< The normalised CRT waveform tabulated on every time delay tick
+
+    std::vector<Tagger> fTaggers; //!< A list of hit taggers, before any coincidence requirement (indexed by tagger ID)
+
+    std::vector<uint16_t> fTaggerOrder; //!< Tagger IDs ordered by tagger name, the order in which triggers are simulated
+
+    std::vector<size_t> fIDEOrder; //!< Reusable buffer holding the time ordering of the IDEs of one AuxDetSimChannel
+
+    std::vector<int> fFEBSlots; //!< Reusable buffer mapping mac5 to its position in fData for the trigger being processed (-1 if unused)
+
+    std::vector<std::array<uint32_t, 32>> fFEBADCs; //!< Reusable buffer accumulating the emulated ADCs of each FEB in the trigger being processed
+
+    std::vector<uint32_t> fFEBHitMasks; //!< Reusable buffer flagging the channels of each FEB that received a signal
+
+    std::vector<std::pair<uint16_t, size_t>> fTriggerFEBs; //!< Reusable buffer holding the FEBs read out by the trigger being processed (mac5, index of first strip)
 
     std::vector<std::pair<FEBData, std::vector<AuxDetIDE>>> fData; //!< This member stores the final FEBData for the CRT simulation
 
@@ -251,7 +267,7 @@ private:
 
     /**
      * Configures the waveform by reading waveform points from configuration and
-     * setting up the interpolator.
+     * tabulating the interpolated waveform on integer time delays.
      */
     void ConfigureWaveform();
 
@@ -266,18 +282,19 @@ private:
      * takes as input all the strips that belong to a single CRT tagger-level trigger
      * and constructs FEBData objects from them.
      *
-     * @param strips The set of strips that belong to the same trigger
+     * @param strips The strips of the tagger
+     * @param indices The indices of the strips that belong to the same trigger
      */
-    void ProcessStrips(const std::vector<StripData> & strips);
+    void ProcessStrips(const std::vector<StripData> & strips, const std::vector<size_t> & indices);
 
     /**
-     * Adds ADCs to a certain SiPM in a FEBData object
+     * Adds ADCs to all the SiPMs of a FEBData object, applying the saturation
      *
      * @param feb_data The FEBData object.
-     * @param sipmID The SiPM index (0-31).
-     * @param adc ADC value to be added.
+     * @param adcs ADC values to be added, per SiPM (0-31).
+     * @param hit_mask Bit mask of the SiPMs that received a signal.
      */
-    void AddADC(FEBData & feb_data, const int & sipmID, const uint16_t & adc);
+    void AddADCs(FEBData & feb_data, const std::array<uint32_t, 32> & adcs, const uint32_t hit_mask);
 
 };
 
@@ -115,8 +115,8 @@ void CRTDetSim::produce(art::Event & e) {
   //
 
   fDetAlg.CreateData();
-  std::vector<std::pair<FEBData, std::vector<sim::AuxDetIDE>>> data = fDetAlg.GetData();
-  std::vector<std::vector<int>> auxdata = fDetAlg.GetAuxData();
+  auto const& data = fDetAlg.GetData();
+  auto const& auxdata = fDetAlg.GetAuxData();
 
   //
   // Step 3: Save output
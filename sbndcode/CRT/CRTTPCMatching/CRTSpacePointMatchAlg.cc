@@ -33,16 +33,83 @@ namespace sbnd::crt {
     return;
   }
 
-  SPMatchCandidate CRTSpacePointMatchAlg::GetClosestCRTSpacePoint(detinfo::DetectorPropertiesData const &detProp, const art::Ptr<recob::Track> &track,
-                                                                  const std::vector<art::Ptr<CRTSpacePoint>> &crtSPs, const art::Event &e)
+  void CRTSpacePointMatchAlg::SetupEvent(const art::Event &e)
   {
     art::Handle<std::vector<recob::Track>> trackHandle;
     e.getByLabel(fTPCTrackLabel, trackHandle);
 
-    const art::FindManyP<recob::Hit> tracksToHits(trackHandle, e, fTPCTrackLabel);
-    const std::vector<art::Ptr<recob::Hit>> hits = tracksToHits.at(track.key());
+    fTrackHits.clear();
+
+    if(trackHandle.isValid())
+      {
+        const art::FindManyP<recob::Hit> tracksToHits(trackHandle, e, fTPCTrackLabel);
+
+        fTrackHits.resize(trackHandle->size());
+        for(unsigned i = 0; i < trackHandle->size(); ++i)
+          fTrackHits[i] = tracksToHits.at(i);
+      }
+
+    art::Handle<std::vector<CRTSpacePoint>> spacePointHandle;
+    e.getByLabel(fCRTSpacePointLabel, spacePointHandle);
+
+    fSpacePointTaggers.clear();
+
+    if(spacePointHandle.isValid())
+      {
+        const art::FindOneP<CRTCluster> spacePointsToClusters(spacePointHandle, e, fCRTSpacePointLabel);
+
+        fSpacePointTaggers.resize(spacePointHandle->size());
+        for(unsigned i = 0; i < spacePointHandle->size(); ++i)
+          fSpacePointTaggers[i] = spacePointsToClusters.at(i)->Tagger();
+      }
+  }
+
+  std::vector<SPMatchCandidate> CRTSpacePointMatchAlg::GetClosestCRTSpacePoints(detinfo::DetectorPropertiesData const &detProp,
+                                                                                const std::vector<art::Ptr<recob::Track>> &tracks,
+                                                                                const std::vector<art::Ptr<CRTSpacePoint>> &crtSPs, const art::Event &e)
+  {
+    std::vector<SPMatchCandidate> matches;
+
+    std::vector<art::Ptr<CRTSpacePoint>> sortedSPs(crtSPs);
+    std::sort(sortedSPs.begin(), sortedSPs.end(),
+              [](const art::Ptr<CRTSpacePoint> &a, const art::Ptr<CRTSpacePoint> &b)
+              { return a->Time() < b->Time(); });
+
+    // Corrected times in us, as used for the T0 window below
+    std::vector<double> crtTimes;
+    crtTimes.reserve(sortedSPs.size());
+    for(auto const &crtSP : sortedSPs)
+      crtTimes.push_back(crtSP->Time() * 1e-3 + fTimeCorrection);
 
-    return GetClosestCRTSpacePoint(detProp, track, hits, crtSPs, e);
+    for(auto const &track : tracks)
+      {
+        const std::vector<art::Ptr<recob::Hit>> &hits = fTrackHits.at(track.key());
+
+        const int driftDirection                = TPCGeoUtil::DriftDirectionFromHits(fGeometryService, hits);
+        const std::pair<double, double> xLimits = TPCGeoUtil::XLimitsFromHits(fGeometryService, hits);
+
+        const std::pair<double, double> t0MinMax = TrackT0Range(detProp, track->Vertex().X(), track->End().X(), driftDirection, xLimits);
+
+        // Only the space points inside the (padded) T0 window can be matched
+        const auto begin = std::upper_bound(crtTimes.begin(), crtTimes.end(), t0MinMax.first - 10.);
+        const auto end   = std::lower_bound(begin, crtTimes.end(), t0MinMax.second + 10.);
+
+        const std::vector<art::Ptr<CRTSpacePoint>> windowSPs(sortedSPs.begin() + (begin - crtTimes.begin()),
+                                                             sortedSPs.begin() + (end - crtTimes.begin()));
+
+        const SPMatchCandidate closest = GetClosestCRTSpacePoint(detProp, track, t0MinMax, windowSPs, driftDirection, e);
+
+        if(closest.valid)
+          matches.push_back(closest);
+      }
+
+    return matches;
+  }
+
+  SPMatchCandidate CRTSpacePointMatchAlg::GetClosestCRTSpacePoint(detinfo::DetectorPropertiesData const &detProp, const art::Ptr<recob::Track> &track,
+                                                                  const std::vector<art::Ptr<CRTSpacePoint>> &crtSPs, const art::Event &e)
+  {
+    return GetClosestCRTSpacePoint(detProp, track, fTrackHits.at(track.key()), crtSPs, e);
   }
 
   SPMatchCandidate CRTSpacePointMatchAlg::GetClosestCRTSpacePoint(detinfo::DetectorPropertiesData const &detProp, const art::Ptr<recob::Track> &track,
@@ -72,6 +139,11 @@ namespace sbnd::crt {
 
     std::vector<SPMatchCandidate> candidates;
 
+    // The average directions do not depend on the space point
+    std::pair<geo::Vector_t, geo::Vector_t> averageStartEndDir;
+    if(fDirMethod==2)
+      averageStartEndDir = AverageTrackDirections(track, fTrackDirectionFrac);
+
     for(auto &crtSP : crtSPs){
 
       const double crtTime = crtSP->Time() * 1e-3 + fTimeCorrection;
@@ -87,7 +159,7 @@ namespace sbnd::crt {
       std::pair<geo::Vector_t, geo::Vector_t> startEndDir;
 
       if(fDirMethod==2)
-        startEndDir = AverageTrackDirections(track, fTrackDirectionFrac);
+        startEndDir = averageStartEndDir;
       else
         startEndDir = TrackDirections(detProp, track, fTrackDirectionFrac, crtTime, driftDirection);
 
@@ -167,14 +239,8 @@ namespace sbnd::crt {
 
     const geo::Point_t end = trackStart + trackDir;
 
-    art::Handle<std::vector<CRTSpacePoint>> spacePointHandle;
-    e.getByLabel(fCRTSpacePointLabel, spacePointHandle);
-
-    const art::FindOneP<CRTCluster> spacePointsToClusters(spacePointHandle, e, fCRTSpacePointLabel);
-    const art::Ptr<CRTCluster> cluster = spacePointsToClusters.at(crtSP.key());
-
     if(fDCAuseBox)
-      return CRTCommonUtils::DistToCRTSpacePoint(crtSP, trackStart, end, cluster->Tagger());
+      return CRTCommonUtils::DistToCRTSpacePoint(crtSP, trackStart, end, fSpacePointTaggers.at(crtSP.key()));
     else
       return CRTCommonUtils::SimpleDCA(crtSP, trackStart, trackDir);
   }
@@ -143,6 +143,18 @@ namespace sbnd::crt {
 
     void reconfigure(const Config& config);
 
+    // Builds the hit lists of all TPC tracks and the tagger of every CRT space
+    // point in the event once. Must be called once per event, before any of
+    // the event based overloads.
+    void SetupEvent(const art::Event &e);
+
+    // Matches all the given TPC tracks against the CRT space points in one pass
+    // over a time ordered space point index. Returns the valid closest space
+    // point of each TPC track.
+    std::vector<SPMatchCandidate> GetClosestCRTSpacePoints(detinfo::DetectorPropertiesData const &detProp,
+                                                           const std::vector<art::Ptr<recob::Track>> &tracks,
+                                                           const std::vector<art::Ptr<CRTSpacePoint>> &crtSPs, const art::Event &e);
+
     SPMatchCandidate GetClosestCRTSpacePoint(detinfo::DetectorPropertiesData const &detProp, const art::Ptr<recob::Track> &track,
                                              const std::vector<art::Ptr<CRTSpacePoint>> &crtSPs, const art::Event &e);
 
@@ -181,6 +193,9 @@ namespace sbnd::crt {
 
     art::InputTag fTPCTrackLabel;
     art::InputTag fCRTSpacePointLabel;
+
+    std::vector<std::vector<art::Ptr<recob::Hit>>> fTrackHits;
+    std::vector<CRTTagger>                         fSpacePointTaggers;
   };
 }
 #endif
@@ -83,20 +83,19 @@ void sbnd::crt::CRTSpacePointMatching::produce(art::Event& e)
 
   auto const detProp = art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataFor(e);
 
-  std::vector<SPMatchCandidate> candidates;
+  std::vector<art::Ptr<recob::Track>> muonTrackVec;
 
   for(auto const &track : trackVec)
     {
       const art::Ptr<recob::PFParticle> pfp = tracksToPFPs.at(track.key());
 
-      if(pfp->PdgCode() != 13)
-        continue;
+      if(pfp->PdgCode() == 13)
+        muonTrackVec.push_back(track);
+    }
 
-      SPMatchCandidate closest = fMatchingAlg.GetClosestCRTSpacePoint(detProp, track, CRTSpacePointVec, e);
+  fMatchingAlg.SetupEvent(e);
 
-      if(closest.valid)
-        candidates.push_back(closest);
-    }
+  std::vector<SPMatchCandidate> candidates = fMatchingAlg.GetClosestCRTSpacePoints(detProp, muonTrackVec, CRTSpacePointVec, e);
 
   std::sort(candidates.begin(), candidates.end(),
             [](const SPMatchCandidate &a, const SPMatchCandidate &b)
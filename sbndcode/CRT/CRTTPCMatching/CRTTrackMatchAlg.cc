@@ -27,15 +27,92 @@ namespace sbnd::crt {
 
     return;
   }
- 
-  TrackMatchCandidate CRTTrackMatchAlg::GetBestMatchedCRTTrack(detinfo::DetectorPropertiesData const &detProp, const art::Ptr<recob::Track> &tpcTrack,
-                                                               const std::vector<art::Ptr<CRTTrack>> &crtTracks, const art::Event &e)
+
+  void CRTTrackMatchAlg::SetupEvent(const art::Event &e)
   {
     art::Handle<std::vector<recob::Track>> tpcTrackHandle;
     e.getByLabel(fTPCTrackLabel, tpcTrackHandle);
 
-    const art::FindManyP<recob::Hit> tracksToHits(tpcTrackHandle, e, fTPCTrackLabel);
-    const std::vector<art::Ptr<recob::Hit>> hits = tracksToHits.at(tpcTrack.key());
+    fTrackHits.clear();
+
+    if(tpcTrackHandle.isValid())
+      {
+        const art::FindManyP<recob::Hit> tracksToHits(tpcTrackHandle, e, fTPCTrackLabel);
+
+        fTrackHits.resize(tpcTrackHandle->size());
+        for(unsigned i = 0; i < tpcTrackHandle->size(); ++i)
+          fTrackHits[i] = tracksToHits.at(i);
+      }
+  }
+
+  const std::vector<art::Ptr<recob::Hit>>& CRTTrackMatchAlg::TrackHits(const art::Ptr<recob::Track> &tpcTrack)
+  {
+    return fTrackHits.at(tpcTrack.key());
+  }
+
+  std::vector<TrackMatchCandidate> CRTTrackMatchAlg::GetBestMatchedCRTTracks(detinfo::DetectorPropertiesData const &detProp,
+                                                                            const std::vector<art::Ptr<recob::Track>> &tpcTracks,
+                                                                            const std::vector<art::Ptr<CRTTrack>> &crtTracks, const art::Event &e)
+  {
+    std::vector<TrackMatchCandidate> matches;
+
+    std::vector<art::Ptr<CRTTrack>> sortedCRTTracks(crtTracks);
+    std::sort(sortedCRTTracks.begin(), sortedCRTTracks.end(),
+              [](const art::Ptr<CRTTrack> &a, const art::Ptr<CRTTrack> &b)
+              { return a->Time() < b->Time(); });
+
+    std::vector<double> crtTimes;
+    crtTimes.reserve(sortedCRTTracks.size());
+    for(auto const &crtTrack : sortedCRTTracks)
+      crtTimes.push_back(crtTrack->Time());
+
+    for(auto const &tpcTrack : tpcTracks)
+      {
+        const std::vector<art::Ptr<recob::Hit>> &hits = TrackHits(tpcTrack);
+
+        if(hits.empty())
+          continue;
+
+        const int driftDirection = TPCGeoUtil::DriftDirectionFromHits(fGeometryService, hits);
+
+        // Range of CRT times for which the shifted TPC track stays inside its TPC,
+        // see AllPossibleCRTTracks. It is padded, always includes t = 0 (no shift),
+        // and only used to pick the CRT tracks worth testing.
+        double minTime = -std::numeric_limits<double>::max(), maxTime = std::numeric_limits<double>::max();
+
+        if(driftDirection != 0)
+          {
+            const geo::TPCGeo &tpcGeo = fGeometryService->GetElement(hits[0]->WireID().asTPCID());
+
+            const double minShift = tpcGeo.MinX() - 2. - std::min(tpcTrack->Vertex().X(), tpcTrack->End().X());
+            const double maxShift = tpcGeo.MaxX() + 2. - std::max(tpcTrack->Vertex().X(), tpcTrack->End().X());
+
+            const double t0 = minShift / (driftDirection * detProp.DriftVelocity()) * 1e3;
+            const double t1 = maxShift / (driftDirection * detProp.DriftVelocity()) * 1e3;
+
+            minTime = std::min({t0, t1, 0.}) - 1.;
+            maxTime = std::max({t0, t1, 0.}) + 1.;
+          }
+
+        const auto begin = std::lower_bound(crtTimes.begin(), crtTimes.end(), minTime);
+        const auto end   = std::upper_bound(begin, crtTimes.end(), maxTime);
+
+        const std::vector<art::Ptr<CRTTrack>> windowCRTTracks(sortedCRTTracks.begin() + (begin - crtTimes.begin()),
+                                                              sortedCRTTracks.begin() + (end - crtTimes.begin()));
+
+        const TrackMatchCandidate best = GetBestMatchedCRTTrack(detProp, tpcTrack, hits, windowCRTTracks);
+
+        if(best.valid)
+          matches.push_back(best);
+      }
+
+    return matches;
+  }
+ 
+  TrackMatchCandidate CRTTrackMatchAlg::GetBestMatchedCRTTrack(detinfo::DetectorPropertiesData const &detProp, const art::Ptr<recob::Track> &tpcTrack,
+                                                               const std::vector<art::Ptr<CRTTrack>> &crtTracks, const art::Event &e)
+  {
+    const std::vector<art::Ptr<recob::Hit>> &hits = TrackHits(tpcTrack);
 
     return GetBestMatchedCRTTrack(detProp, tpcTrack, hits, crtTracks);
   }
@@ -46,9 +123,14 @@ namespace sbnd::crt {
     if(tpcTrack->Length() < fMinTPCTrackLength)
       return TrackMatchCandidate();
 
+    const std::vector<art::Ptr<CRTTrack>> preselectedCRTTracks = PreselectCRTTracks(detProp, tpcTrack, hits, crtTracks);
+
+    if(preselectedCRTTracks.empty())
+      return TrackMatchCandidate();
+
     if(fSelectionMetric == "angle")
       {
-        TrackMatchCandidate candidate = ClosestCRTTrackByAngle(detProp, tpcTrack, hits, crtTracks, fMaxDCA);
+        TrackMatchCandidate candidate = ClosestCRTTrackByAngle(detProp, tpcTrack, hits, preselectedCRTTracks, fMaxDCA);
 
         if(candidate.score > fMaxAngleDiff)
           return TrackMatchCandidate();
@@ -57,7 +139,7 @@ namespace sbnd::crt {
       }
     else if(fSelectionMetric == "dca")
       {
-        TrackMatchCandidate candidate = ClosestCRTTrackByDCA(detProp, tpcTrack, hits, crtTracks, fMaxAngleDiff);
+        TrackMatchCandidate candidate = ClosestCRTTrackByDCA(detProp, tpcTrack, hits, preselectedCRTTracks, fMaxAngleDiff);
 
         if(candidate.score > fMaxDCA)
           return TrackMatchCandidate();
@@ -66,7 +148,7 @@ namespace sbnd::crt {
       }
     else
       {
-        TrackMatchCandidate candidate = ClosestCRTTrackByScore(detProp, tpcTrack, hits, crtTracks);
+        TrackMatchCandidate candidate = ClosestCRTTrackByScore(detProp, tpcTrack, hits, preselectedCRTTracks);
 
         if(candidate.score > fMaxScore)
           return TrackMatchCandidate();
@@ -89,11 +171,7 @@ namespace sbnd::crt {
   std::vector<art::Ptr<CRTTrack>> CRTTrackMatchAlg::AllPossibleCRTTracks(detinfo::DetectorPropertiesData const &detProp, const art::Ptr<recob::Track> &tpcTrack,
                                                                          const std::vector<art::Ptr<CRTTrack>> &crtTracks, const art::Event &e)
   {
-    art::Handle<std::vector<recob::Track>> tpcTrackHandle;
-    e.getByLabel(fTPCTrackLabel, tpcTrackHandle);
-
-    const art::FindManyP<recob::Hit> tracksToHits(tpcTrackHandle, e, fTPCTrackLabel);
-    const std::vector<art::Ptr<recob::Hit>> hits = tracksToHits.at(tpcTrack.key());
+    const std::vector<art::Ptr<recob::Hit>> &hits = TrackHits(tpcTrack);
 
     return AllPossibleCRTTracks(detProp, tpcTrack, hits, crtTracks);
   }
@@ -138,11 +216,7 @@ namespace sbnd::crt {
   TrackMatchCandidate CRTTrackMatchAlg::ClosestCRTTrackByAngle(detinfo::DetectorPropertiesData const &detProp, const art::Ptr<recob::Track> &tpcTrack,
                                                                const std::vector<art::Ptr<CRTTrack>> &crtTracks, const art::Event &e, const double maxDCA)
   {
-    art::Handle<std::vector<recob::Track>> tpcTrackHandle;
-    e.getByLabel(fTPCTrackLabel, tpcTrackHandle);
-
-    const art::FindManyP<recob::Hit> tracksToHits(tpcTrackHandle, e, fTPCTrackLabel);
-    const std::vector<art::Ptr<recob::Hit>> hits = tracksToHits.at(tpcTrack.key());
+    const std::vector<art::Ptr<recob::Hit>> &hits = TrackHits(tpcTrack);
 
     return ClosestCRTTrackByAngle(detProp, tpcTrack, hits, crtTracks, maxDCA);
   }
@@ -185,11 +259,7 @@ namespace sbnd::crt {
   TrackMatchCandidate CRTTrackMatchAlg::ClosestCRTTrackByDCA(detinfo::DetectorPropertiesData const &detProp, const art::Ptr<recob::Track> &tpcTrack,
                                                              const std::vector<art::Ptr<CRTTrack>> &crtTracks, const art::Event &e, const double maxAngle)
   {
-    art::Handle<std::vector<recob::Track>> tpcTrackHandle;
-    e.getByLabel(fTPCTrackLabel, tpcTrackHandle);
-
-    const art::FindManyP<recob::Hit> tracksToHits(tpcTrackHandle, e, fTPCTrackLabel);
-    const std::vector<art::Ptr<recob::Hit>> hits = tracksToHits.at(tpcTrack.key());
+    const std::vector<art::Ptr<recob::Hit>> &hits = TrackHits(tpcTrack);
 
     return ClosestCRTTrackByDCA(detProp, tpcTrack, hits, crtTracks, maxAngle);
   }
@@ -231,11 +301,7 @@ namespace sbnd::crt {
   TrackMatchCandidate CRTTrackMatchAlg::ClosestCRTTrackByScore(detinfo::DetectorPropertiesData const &detProp, const art::Ptr<recob::Track> &tpcTrack,
                                                                const std::vector<art::Ptr<CRTTrack>> &crtTracks, const art::Event &e)
   {
-    art::Handle<std::vector<recob::Track>> tpcTrackHandle;
-    e.getByLabel(fTPCTrackLabel, tpcTrackHandle);
-
-    const art::FindManyP<recob::Hit> tracksToHits(tpcTrackHandle, e, fTPCTrackLabel);
-    const std::vector<art::Ptr<recob::Hit>> hits = tracksToHits.at(tpcTrack.key());
+    const std::vector<art::Ptr<recob::Hit>> &hits = TrackHits(tpcTrack);
 
     return ClosestCRTTrackByScore(detProp, tpcTrack, hits, crtTracks);
   }
@@ -318,4 +384,60 @@ namespace sbnd::crt {
 
     return aveDCA / usedPts;
   }
+
+  std::vector<art::Ptr<CRTTrack>> CRTTrackMatchAlg::PreselectCRTTracks(detinfo::DetectorPropertiesData const &detProp, const art::Ptr<recob::Track> &tpcTrack,
+                                                                       const std::vector<art::Ptr<recob::Hit>> &hits, const std::vector<art::Ptr<CRTTrack>> &crtTracks)
+  {
+    // The distance to a line is convex in the point, so the average DCA of the
+    // trajectory points is never smaller than the DCA of their centroid. This
+    // bound, together with the angle, rejects the CRT tracks that could neither
+    // be a candidate nor pass the final cut for the configured metric, which
+    // leaves the selected match unchanged.
+    const int driftDirection = TPCGeoUtil::DriftDirectionFromHits(fGeometryService, hits);
+
+    geo::Point_t centroid(0., 0., 0.);
+    unsigned usedPts = 0;
+
+    for(unsigned i = 0; i < tpcTrack->NumberTrajectoryPoints(); ++i)
+      {
+        if(!tpcTrack->HasValidPoint(i))
+          continue;
+
+        const geo::Point_t point = tpcTrack->LocationAtPoint(i);
+        centroid.SetXYZ(centroid.X() + point.X(), centroid.Y() + point.Y(), centroid.Z() + point.Z());
+        ++usedPts;
+      }
+
+    if(usedPts == 0)
+      return crtTracks;
+
+    centroid /= usedPts;
+
+    std::vector<art::Ptr<CRTTrack>> selected;
+
+    for(auto const &crtTrack : crtTracks)
+      {
+        const double angle = AngleBetweenTracks(tpcTrack, crtTrack);
+
+        const double shift = driftDirection * crtTrack->Time() * 1e-3 * detProp.DriftVelocity();
+        geo::Point_t point = centroid;
+        point.SetX(point.X() + shift);
+
+        const geo::Point_t crtStart = crtTrack->Start();
+        const geo::Point_t crtEnd   = crtTrack->End();
+        const double minDCA = (point - crtStart).Cross(point - crtEnd).R() / (crtEnd - crtStart).R();
+
+        if(fSelectionMetric == "angle" || fSelectionMetric == "dca")
+          {
+            if(angle > fMaxAngleDiff || minDCA > fMaxDCA)
+              continue;
+          }
+        else if(minDCA + 4 * 180 / TMath::Pi() * angle > fMaxScore)
+          continue;
+
+        selected.push_back(crtTrack);
+      }
+
+    return selected;
+  }
 }
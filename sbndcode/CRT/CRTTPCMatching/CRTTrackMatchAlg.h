@@ -106,6 +106,16 @@ namespace sbnd::crt {
 
     void reconfigure(const Config& config);
 
+    // Builds the hit lists of all TPC tracks in the event once. Must be called
+    // once per event, before any of the event based overloads.
+    void SetupEvent(const art::Event &e);
+
+    // Matches all the given TPC tracks against the CRT tracks in one pass over a
+    // time ordered CRT track index. Returns the valid best match of each TPC track.
+    std::vector<TrackMatchCandidate> GetBestMatchedCRTTracks(detinfo::DetectorPropertiesData const &detProp,
+                                                             const std::vector<art::Ptr<recob::Track>> &tpcTracks,
+                                                             const std::vector<art::Ptr<CRTTrack>> &crtTracks, const art::Event &e);
+
     bool TPCIntersection(const geo::TPCGeo &tpcGeo, const art::Ptr<CRTTrack> &track, geo::Point_t &entry, geo::Point_t &exit);
 
     TrackMatchCandidate GetBestMatchedCRTTrack(detinfo::DetectorPropertiesData const &detProp, const art::Ptr<recob::Track> &tpcTrack,
@@ -142,8 +152,15 @@ namespace sbnd::crt {
 
     double AveDCABetweenTracks(const art::Ptr<recob::Track> &tpcTrack, const art::Ptr<CRTTrack> &crtTrack, const double shift);
 
+    // Keeps only the CRT tracks that can still give a valid match under the configured
+    // selection metric, using the angle and a lower bound on the average DCA
+    std::vector<art::Ptr<CRTTrack>> PreselectCRTTracks(detinfo::DetectorPropertiesData const &detProp, const art::Ptr<recob::Track> &tpcTrack,
+                                                       const std::vector<art::Ptr<recob::Hit>> &hits, const std::vector<art::Ptr<CRTTrack>> &crtTracks);
+
   private:
 
+    const std::vector<art::Ptr<recob::Hit>>& TrackHits(const art::Ptr<recob::Track> &tpcTrack);
+
     geo::GeometryCore const* fGeometryService;
 
     double      fMaxAngleDiff;
@@ -153,6 +170,8 @@ namespace sbnd::crt {
     std::string fSelectionMetric;
 
     art::InputTag fTPCTrackLabel;
+
+    std::vector<std::vector<art::Ptr<recob::Hit>>> fTrackHits;
   };
 }
 
@@ -80,20 +80,19 @@ void sbnd::crt::CRTTrackMatching::produce(art::Event& e)
 
   auto const detProp = art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataFor(e);
 
-  std::vector<TrackMatchCandidate> candidates;
+  std::vector<art::Ptr<recob::Track>> muonTrackVec;
 
   for(auto const &tpcTrack : tpcTrackVec)
     {
       const art::Ptr<recob::PFParticle> pfp = tracksToPFPs.at(tpcTrack.key());
 
-      if(pfp->PdgCode() != 13)
-        continue;
+      if(pfp->PdgCode() == 13)
+        muonTrackVec.push_back(tpcTrack);
+    }
 
-      TrackMatchCandidate best = fMatchingAlg.GetBestMatchedCRTTrack(detProp, tpcTrack, crtTrackVec, e);
+  fMatchingAlg.SetupEvent(e);
 
-      if(best.valid)
-        candidates.push_back(best);
-    }
+  std::vector<TrackMatchCandidate> candidates = fMatchingAlg.GetBestMatchedCRTTracks(detProp, muonTrackVec, crtTrackVec, e);
 
   std::sort(candidates.begin(), candidates.end(),
             [](const TrackMatchCandidate &a, const TrackMatchCandidate &b)
@@ -11,7 +11,6 @@
 #ifndef SBNDTPCChannelMapService_H
 #define SBNDTPCChannelMapService_H
 
-#include <unordered_map>
 #include <vector>
 #include <string>
 
@@ -55,24 +54,38 @@ public:
     bool valid;          // true if valid, false if not
   } ChanInfo_t;
 
-  ChanInfo_t GetChanInfoFromFEMElements(
+  // both lookups return a reference to an invalid ChanInfo_t for unmapped channels
+
+  const ChanInfo_t& GetChanInfoFromFEMElements(
 					unsigned int femcrate,
 					unsigned int fem,
 					unsigned int femchan) const;
 
-  ChanInfo_t GetChanInfoFromOfflChan(unsigned int offlchan) const;
+  const ChanInfo_t& GetChanInfoFromOfflChan(unsigned int offlchan) const;
 
 private:
 
-  // look up channel info by offline channel number
+  // index into fChanInfo of a FEMCrate, FEM, FEMCh combination, -1 if unmapped
+  int FEMIndex(unsigned int femcrate, unsigned int fem, unsigned int femchan) const;
+
+  // channel info of every line of the map
   
-  std::unordered_map<unsigned int, ChanInfo_t> fChanInfoFromOfflChan;
+  std::vector<ChanInfo_t> fChanInfo;
 
-  // look up channel info by FEMCrate, FEM, and FEMCh
+  // look up index in fChanInfo by offline channel number, -1 if unmapped
   
-  std::unordered_map<unsigned int,
-		     std::unordered_map<unsigned int,
-					std::unordered_map< unsigned int, ChanInfo_t > > > fChanInfoFromFEMInfo;
+  std::vector<int> fChanIndexFromOfflChan;
+
+  // look up index in fChanInfo by FEMCrate, FEM, and FEMCh, -1 if unmapped.
+  // Dense array of fNFEMCrates x fNFEMs x fNFEMChans entries
+  
+  std::vector<int> fChanIndexFromFEMInfo;
+  std::vector<bool> fFEMCrateMapped;
+  unsigned int fNFEMCrates = 0;
+  unsigned int fNFEMs = 0;
+  unsigned int fNFEMChans = 0;
+
+  ChanInfo_t fBadInfo{};
 
 };
 
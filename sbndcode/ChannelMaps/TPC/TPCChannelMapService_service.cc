@@ -11,6 +11,7 @@
 #include <fstream>
 #include <sstream>
 #include <stdlib.h>
+#include <algorithm>
 
 #include "TPCChannelMapService.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
@@ -26,6 +27,8 @@ SBND::TPCChannelMapService::TPCChannelMapService(fhicl::ParameterSet const& pset
   if (!useDB && !useFile) {
     throw cet::exception("SBND::TPCChannelMapService: UseHWDB and ReadMapFromFile are both false");
   }
+  fBadInfo.valid = false;
+
   if (useFile) {
     std::string channelMapFile = pset.get<std::string>("FileName");
 
@@ -68,6 +71,9 @@ SBND::TPCChannelMapService::TPCChannelMapService(fhicl::ParameterSet const& pset
 	>> c.FEMCh
 	>> c.offlchan;
 
+      // skip blank or truncated lines rather than mapping garbage
+      if (linestream.fail()) continue;
+
       c.valid = true;
       c.plane = 10;
       if (planestr == "U") c.plane = 0;
@@ -76,10 +82,30 @@ SBND::TPCChannelMapService::TPCChannelMapService(fhicl::ParameterSet const& pset
       if (c.plane == 10) c.valid = false;
       c.WIBQFSP = atoi(qfspstr.substr(3,1).c_str());
 
-      fChanInfoFromFEMInfo[c.FEMCrate][c.FEM][c.FEMCh] = c;
-      fChanInfoFromOfflChan[c.offlchan] = c;
+      fChanInfo.push_back(c);
     }
     inFile.close();
+
+    // size the lookup arrays from the largest channel identifiers in the map;
+    // later lines of the file take precedence over earlier ones
+    unsigned int maxOfflChan = 0;
+    for (auto const& c : fChanInfo) {
+      fNFEMCrates = std::max(fNFEMCrates, c.FEMCrate + 1);
+      fNFEMs      = std::max(fNFEMs,      c.FEM + 1);
+      fNFEMChans  = std::max(fNFEMChans,  c.FEMCh + 1);
+      maxOfflChan = std::max(maxOfflChan, c.offlchan);
+    }
+
+    fChanIndexFromFEMInfo.assign((size_t) fNFEMCrates * fNFEMs * fNFEMChans, -1);
+    fFEMCrateMapped.assign(fNFEMCrates, false);
+    fChanIndexFromOfflChan.assign(fChanInfo.empty() ? 0 : maxOfflChan + 1, -1);
+
+    for (size_t i = 0; i < fChanInfo.size(); ++i) {
+      auto const& c = fChanInfo[i];
+      fChanIndexFromFEMInfo[((size_t) c.FEMCrate * fNFEMs + c.FEM) * fNFEMChans + c.FEMCh] = i;
+      fFEMCrateMapped[c.FEMCrate] = true;
+      fChanIndexFromOfflChan[c.offlchan] = i;
+    }
   }
   else
     {
@@ -91,41 +117,37 @@ SBND::TPCChannelMapService::TPCChannelMapService(fhicl::ParameterSet const& pset
 													    (pset) {
 }
 
-SBND::TPCChannelMapService::ChanInfo_t SBND::TPCChannelMapService::GetChanInfoFromFEMElements(unsigned int femcrate,
-											      unsigned int fem,
-											      unsigned int femchan) const {
+int SBND::TPCChannelMapService::FEMIndex(unsigned int femcrate,
+					 unsigned int fem,
+					 unsigned int femchan) const {
+
+  if (femcrate >= fNFEMCrates || fem >= fNFEMs || femchan >= fNFEMChans) return -1;
+  return fChanIndexFromFEMInfo[((size_t) femcrate * fNFEMs + fem) * fNFEMChans + femchan];
+}
 
-  SBND::TPCChannelMapService::ChanInfo_t badinfo{};
-  badinfo.valid = false;
 
-  // look up one map at a time in order to handle cases where the item is not found
+const SBND::TPCChannelMapService::ChanInfo_t& SBND::TPCChannelMapService::GetChanInfoFromFEMElements(unsigned int femcrate,
+												     unsigned int fem,
+												     unsigned int femchan) const {
+
+  // out of range or unmapped elements give the invalid channel info,
   // without throwing and catching exception which can make debugging hard
   
-  auto fm1 = fChanInfoFromFEMInfo.find(femcrate);
-  if (fm1 == fChanInfoFromFEMInfo.end()) {
-    unsigned int substituteCrate = 1;  // a hack -- ununderstood crates get mapped to crate 1
-    fm1 = fChanInfoFromFEMInfo.find(substituteCrate);
-    if (fm1 == fChanInfoFromFEMInfo.end()) {
-      return badinfo;
-    }
+  if (femcrate >= fNFEMCrates || !fFEMCrateMapped[femcrate]) {
+    femcrate = 1;  // a hack -- ununderstood crates get mapped to crate 1
   }
-  auto& m1 = fm1->second;
-  auto fm2 = m1.find(fem);
-  if (fm2 == m1.end()) return badinfo;
-  auto& m2 = fm2->second;
-  auto fm3 = m2.find(femchan);
-  if (fm3 == m2.end()) return badinfo;    
-  return fm3->second;
+  const int index = FEMIndex(femcrate, fem, femchan);
+  if (index < 0) return fBadInfo;
+  return fChanInfo[index];
 }
 
 
-SBND::TPCChannelMapService::ChanInfo_t SBND::TPCChannelMapService::GetChanInfoFromOfflChan(unsigned int offlineChannel) const {
+const SBND::TPCChannelMapService::ChanInfo_t& SBND::TPCChannelMapService::GetChanInfoFromOfflChan(unsigned int offlineChannel) const {
 
-  SBND::TPCChannelMapService::ChanInfo_t badinfo{};
-  badinfo.valid = false;
-  auto fm = fChanInfoFromOfflChan.find(offlineChannel);
-  if (fm == fChanInfoFromOfflChan.end()) return badinfo;
-  return fm->second;
+  if (offlineChannel >= fChanIndexFromOfflChan.size()) return fBadInfo;
+  const int index = fChanIndexFromOfflChan[offlineChannel];
+  if (index < 0) return fBadInfo;
+  return fChanInfo[index];
 }
 
 DEFINE_ART_SERVICE(SBND::TPCChannelMapService)
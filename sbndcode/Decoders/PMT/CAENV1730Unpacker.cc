@@ -0,0 +1,53 @@
+////////////////////////////////////////////////////////////////////////
+// File:        CAENV1730Unpacker.cc
+////////////////////////////////////////////////////////////////////////
+
+#include "CAENV1730Unpacker.h"
+
+#include "sbndaq-artdaq-core/Overlays/Common/CAENV1730Fragment.hh"
+
+uint32_t sbndaq::V1730WaveformLength(const artdaq::Fragment & frag){
+    CAENV1730Fragment bb(frag);
+    auto const* md = bb.Metadata();
+    auto nch = md->nChannels;    
+
+    CAENV1730Event const* event_ptr = bb.Event();
+    CAENV1730EventHeader header = event_ptr->Header;
+    uint32_t ev_size_quad_bytes = header.eventSize;
+    uint32_t evt_header_size_quad_bytes = sizeof(CAENV1730EventHeader)/sizeof(uint32_t);
+    uint32_t data_size_double_bytes = 2*(ev_size_quad_bytes - evt_header_size_quad_bytes);
+    uint32_t wvfm_length = data_size_double_bytes/nch;
+
+    return wvfm_length;
+}
+
+void sbndaq::V1730WaveformSpans(const artdaq::Fragment & frag, std::vector<V1730WaveformSpan> & spans){
+    CAENV1730Fragment bb(frag);
+    auto nch = bb.Metadata()->nChannels;
+    uint32_t wvfm_length = V1730WaveformLength(frag);
+
+    const uint16_t* data_begin = reinterpret_cast<const uint16_t*>(frag.dataBeginBytes() 
+                                   + sizeof(CAENV1730EventHeader));
+
+    for (size_t i_ch=0; i_ch<nch; ++i_ch){
+        auto ch_offset = (size_t)(i_ch * wvfm_length);      
+        spans.push_back({data_begin + ch_offset, wvfm_length});
+    }
+}
+
+size_t sbndaq::V1730CombinedLength(const std::vector<V1730WaveformSpan> & spans,
+                                   const std::vector<std::vector<V1730WaveformSpan>> & extended_spans,
+                                   size_t ich){
+    size_t length = spans[ich].length;
+    for (auto const& jspans : extended_spans) length += jspans[ich].length;
+    return length;
+}
+
+void sbndaq::V1730CombineWaveform(const std::vector<V1730WaveformSpan> & spans,
+                                  const std::vector<std::vector<V1730WaveformSpan>> & extended_spans,
+                                  size_t ich, std::vector<uint16_t> & combined){
+    combined.reserve(combined.size() + V1730CombinedLength(spans, extended_spans, ich));
+    combined.insert(combined.end(), spans[ich].data, spans[ich].data + spans[ich].length);
+    for (auto const& jspans : extended_spans)
+        combined.insert(combined.end(), jspans[ich].data, jspans[ich].data + jspans[ich].length);
+}
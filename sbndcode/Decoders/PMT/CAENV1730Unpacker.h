@@ -0,0 +1,50 @@
+#ifndef CAENV1730Unpacker_h
+#define CAENV1730Unpacker_h
+////////////////////////////////////////////////////////////////////////
+// File:        CAENV1730Unpacker.h
+//
+// Access to the waveforms of a CAEN V1730 fragment without copying.
+//
+// The fragment data is the CAENV1730EventHeader followed by the 16 bit
+// samples of each channel in turn, nChannels blocks of the same length.
+// Each channel is returned as a span into the fragment data so that the
+// samples are copied only once, into their final storage: the waveform of
+// a trigger combined with those of its extended triggers.
+// See test/Decoders/caen_v1730_unpacker_test.cxx.
+////////////////////////////////////////////////////////////////////////
+
+#include "artdaq-core/Data/Fragment.hh"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sbndaq {
+
+  // samples of one channel, pointing into the data of a fragment
+  struct V1730WaveformSpan {
+    const uint16_t* data;
+    size_t length;
+  };
+
+  // number of samples of each channel of the fragment
+  uint32_t V1730WaveformLength(const artdaq::Fragment & frag);
+
+  // append one span per channel of the fragment, in board channel order;
+  // the spans point into the fragment data, which must outlive them
+  void V1730WaveformSpans(const artdaq::Fragment & frag, std::vector<V1730WaveformSpan> & spans);
+
+  // number of samples of channel ich in a trigger followed by its extended triggers
+  size_t V1730CombinedLength(const std::vector<V1730WaveformSpan> & spans,
+                             const std::vector<std::vector<V1730WaveformSpan>> & extended_spans,
+                             size_t ich);
+
+  // append the samples of channel ich in a trigger, followed by those in each
+  // of its extended triggers, to the combined waveform
+  void V1730CombineWaveform(const std::vector<V1730WaveformSpan> & spans,
+                            const std::vector<std::vector<V1730WaveformSpan>> & extended_spans,
+                            size_t ich, std::vector<uint16_t> & combined);
+
+}
+
+#endif /* CAENV1730Unpacker_h */
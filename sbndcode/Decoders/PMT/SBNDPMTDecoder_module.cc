@@ -33,6 +33,8 @@
 
 #include "lardataobj/RawData/OpDetWaveform.h"
 
+#include "sbndcode/Decoders/PMT/CAENV1730Unpacker.h"
+
 #include <algorithm>
 #include <cassert>
 #include <cmath>
@@ -43,6 +45,8 @@
 #include <bitset>
 #include <memory>
 
+#include "tbb/parallel_for.h"
+
 namespace sbndaq {
     class SBNDPMTDecoder;
 }
@@ -60,16 +64,21 @@ public:
     SBNDPMTDecoder& operator=(SBNDPMTDecoder const&) = delete;
     SBNDPMTDecoder& operator=(SBNDPMTDecoder&&) = delete;
 
+    // fragments of one [flash] trigger, owned once unpacked from their container
+    using FragmentPtrs = std::vector<std::unique_ptr<const artdaq::Fragment>>;
+
+    using WaveformSpan = V1730WaveformSpan;
+
     // Required functions.
     void produce(art::Event& e) override;
-    bool check_fragments(std::vector<artdaq::Fragment> &frag_v, uint32_t& trig_ttt, uint32_t& trig_len);
-    void get_waveforms(artdaq::Fragment & frag, std::vector<std::vector<uint16_t>> & wvfm_v);
+    bool check_fragments(const FragmentPtrs &frag_v, uint32_t& trig_ttt, uint32_t& trig_len);
+    void get_waveforms(const artdaq::Fragment & frag, std::vector<WaveformSpan> & wvfm_v);
 
-    uint32_t get_length(artdaq::Fragment & frag);
-    uint32_t get_ttt(artdaq::Fragment & frag);
-    uint32_t get_boardid(artdaq::Fragment & frag);
+    uint32_t get_length(const artdaq::Fragment & frag);
+    uint32_t get_ttt(const artdaq::Fragment & frag);
+    uint32_t get_boardid(const artdaq::Fragment & frag);
 
-    void get_timing(artdaq::Fragment & frag, uint32_t & ttt, uint32_t & len, int & tick);
+    void get_timing(const artdaq::Fragment & frag, uint32_t & ttt, uint32_t & len, int & tick);
     
 
 private:
@@ -153,7 +162,7 @@ void sbndaq::SBNDPMTDecoder::produce(art::Event& evt)
 
     evt_counter++;
 
-    std::vector<std::vector<artdaq::Fragment>>  trig_frag_v; // every entry should correspond to 1 [flash] trigger 
+    std::vector<FragmentPtrs>  trig_frag_v; // every entry should correspond to 1 [flash] trigger 
     trig_frag_v.resize(fn_maxflashes);
     for (auto &v : trig_frag_v)
         v.reserve(fn_caenboards);
@@ -177,7 +186,7 @@ void sbndaq::SBNDPMTDecoder::produce(art::Event& evt)
             found_caen = true;
 
         if (fragmentHandle->front().type() == artdaq::Fragment::ContainerFragmentType){
-            for (auto cont : *fragmentHandle){
+            for (auto const& cont : *fragmentHandle){
                 artdaq::ContainerFragment contf(cont);
                 ncont++;
 
@@ -192,8 +201,8 @@ void sbndaq::SBNDPMTDecoder::produce(art::Event& evt)
                             std::cout << "WARNING! number of CAEN fragments in container " << ncont << " does not match the first container. Missing board fragments?" << std::endl;
                     }
                     for (size_t ii = 0; ii < contf.block_count(); ++ii){
-                        auto frag = *contf[ii].get();                        
-                        auto fragid = frag.fragmentID() - ffragid_offset;
+                        auto frag = contf[ii];
+                        auto fragid = frag->fragmentID() - ffragid_offset;
                         // ignore boards that are not in the list of boards to ignore
                         if (std::find(fignore_fragid.begin(), fignore_fragid.end(), fragid) != fignore_fragid.end())
                             continue;
@@ -201,7 +210,7 @@ void sbndaq::SBNDPMTDecoder::produce(art::Event& evt)
                             if (fdebug>0) std::cout << "Warning: more than " << fn_maxflashes << " flash triggers found, update the fcl! Skipping the rest." << std::endl;
                             break;
                         }
-                        trig_frag_v[ii].push_back(frag);
+                        trig_frag_v[ii].push_back(std::move(frag));
 
                     }
                 }
@@ -234,10 +243,10 @@ void sbndaq::SBNDPMTDecoder::produce(art::Event& evt)
         }
         else{
             if (fdebug>1) std::cout << "SPECTDC (decoded) products found: " << std::endl;
-            const std::vector<sbnd::timing::DAQTimestamp> tdc_v(*tdcHandle);
+            const std::vector<sbnd::timing::DAQTimestamp> &tdc_v(*tdcHandle);
 
             for (size_t i=0; i<tdc_v.size(); i++){
-                auto tdc = tdc_v[i];
+                auto const& tdc = tdc_v[i];
                 const uint32_t  ch = tdc.Channel();
                 const uint64_t  ts = tdc.Timestamp();
                 const uint64_t  offset = tdc.Offset();
@@ -266,15 +275,15 @@ void sbndaq::SBNDPMTDecoder::produce(art::Event& evt)
             timing_type++;
         }
         else{
-            const std::vector<raw::ptb::sbndptb> ptb_v(*ptbHandle);
+            const std::vector<raw::ptb::sbndptb> &ptb_v(*ptbHandle);
             for (size_t i=0; i<ptb_v.size(); i++){
-                auto ptb = ptb_v[i];
-                auto hltrigs = ptb.GetHLTriggers();
+                auto const& ptb = ptb_v[i];
+                auto const& hltrigs = ptb.GetHLTriggers();
 
                 if (!hltrigs.empty()){
                     if (fdebug>1) std::cout << "PTB (decoded) HLTs found: " << std::endl;
                     for (size_t j=0; j < hltrigs.size(); j++){
-                        raw::ptb::Trigger trig = hltrigs.at(j);
+                        raw::ptb::Trigger const& trig = hltrigs.at(j);
                         if (fdebug>1){
                             std::cout << "      PTB HLT " <<  j << "-> " 
                                       << "ts (ns): " << (trig.timestamp * 20)%(uint(1e9)) 
@@ -306,7 +315,7 @@ void sbndaq::SBNDPMTDecoder::produce(art::Event& evt)
 
     for (size_t i=0; i < trig_frag_v.size(); i++){
         // frag_v contains all fragments for a single trigger 
-        auto frag_v = trig_frag_v.at(i);
+        auto const& frag_v = trig_frag_v.at(i);
         if (fdebug >1) std::cout << "CAEN Trigger " << i << " has " << frag_v.size() << " fragments" << std::endl;
         if (frag_v.empty()) continue;
         uint32_t trig_ttt = 0;
@@ -333,7 +342,7 @@ void sbndaq::SBNDPMTDecoder::produce(art::Event& evt)
 
         auto ittt = trig_ttt_v.at(itrig);
         auto ilen = trig_len_v.at(itrig);
-        auto ifrag_v = trig_frag_v.at(itrig);
+        auto const& ifrag_v = trig_frag_v.at(itrig);
 
         std::vector<uint> fragid_v(ifrag_v.size(),0);
 
@@ -341,16 +350,16 @@ void sbndaq::SBNDPMTDecoder::produce(art::Event& evt)
         
         if (ilen < fnominal_length) continue;
 
-        // store the waveform itself
+        // store where the waveform itself is in the fragments
         // store the waveform start time (for OpDetWaveform timestamp)
         // store the time at the end of the waveform (for extended trigger condition)
-        std::vector<std::vector<uint16_t>> iwvfm_v;
+        std::vector<WaveformSpan> iwvfm_spans;
         std::vector<int> iwvfm_start_v(ifrag_v.size(),0);
         auto iwvfm_end = ittt;
 
         for (size_t idx=0; idx<ifrag_v.size(); idx++){
-            auto frag = ifrag_v.at(idx);
-            get_waveforms(frag, iwvfm_v);
+            auto const& frag = *ifrag_v.at(idx);
+            get_waveforms(frag, iwvfm_spans);
             fragid_v.at(idx) = frag.fragmentID() - ffragid_offset;
             iwvfm_start_v.at(idx) = get_ttt(frag) - 2*(get_length(frag));
 
@@ -371,20 +380,23 @@ void sbndaq::SBNDPMTDecoder::produce(art::Event& evt)
                           << std::endl;
             }
         }
+        // waveforms of the extended triggers to append, one span per channel
+        std::vector<std::vector<WaveformSpan>> ewvfm_spans;
+
         // if there exist fragments that may be part of the same trigger 
         if (extended_flag){
             for (size_t jtrig=itrig+1; jtrig < ntrig; jtrig++){
                 bool pass_checks = true;
                 auto jttt = trig_ttt_v.at(jtrig);
                 auto jlen = trig_len_v.at(jtrig);
-                auto jfrag_v = trig_frag_v.at(jtrig);
+                auto const& jfrag_v = trig_frag_v.at(jtrig);
 
                 // if the next trigger is more than 10 us away than the end of the wvfm or is equal to the nominal length, stop looking
                 if (((signed)(jttt - iwvfm_end) > 1e4) || (jlen >= fnominal_length)) break; 
                 else if (((jttt - iwvfm_end) < 1e4) && (jlen < fnominal_length)){
-                    std::vector<std::vector<uint16_t>> jwvfm_v;
+                    std::vector<WaveformSpan> jwvfm_v;
                     for (size_t idx=0; idx<jfrag_v.size(); idx++){
-                        auto frag = jfrag_v.at(idx);
+                        auto const& frag = *jfrag_v.at(idx);
                         if (fragid_v.at(idx) != (uint)(frag.fragmentID() - ffragid_offset)){
                             // check that the two fragments originated from the same board
                             std::cout << "Error: fragment IDs do not match between triggers " << itrig << " and " << jtrig << std::endl;
@@ -394,35 +406,42 @@ void sbndaq::SBNDPMTDecoder::produce(art::Event& evt)
                         get_waveforms(frag, jwvfm_v);
                     }
                     // check that the number of waveforms are the same 
-                    if (jwvfm_v.size() != iwvfm_v.size()){
+                    if (jwvfm_v.size() != iwvfm_spans.size()){
                         std::cout << "Error: number of channels in extended fragment " << jtrig << " does not match number of channels in original fragment " << itrig << std::endl;
                         pass_checks=false;
                     }
                     if (pass_checks==false) continue;
-                    // combine the waveforms
-                    for (size_t ich=0; ich < iwvfm_v.size(); ich++){
-                        std::vector<uint16_t>& orig_wvfm = iwvfm_v.at(ich);
-                        std::vector<uint16_t>  extd_wvfm = jwvfm_v.at(ich); // extended waveform 
-                        orig_wvfm.insert( orig_wvfm.end(), extd_wvfm.begin(), extd_wvfm.end());
-                    }
+                    // keep the waveforms to be combined
+                    ewvfm_spans.push_back(std::move(jwvfm_v));
                     // update the end time of the waveform
                     iwvfm_end = jttt;
                 } // extended trigger found 
             } // loop over subsequent triggers
         }
 
+        // the combined waveform of a channel is its waveform in this trigger
+        // followed by those of the extended triggers
+        auto combine = [&](size_t ich, std::vector<uint16_t>& combined_wvfm){
+            V1730CombineWaveform(iwvfm_spans, ewvfm_spans, ich, combined_wvfm);
+        };
+
         if (fdebug>0){
             std::cout << "Obtained waveforms for TTT with TTT " << ittt << "\n" 
-                        << "\tNumber of channels: " << iwvfm_v.size() << "\n"
-                        << "\tNumber of entries: " << iwvfm_v.at(0).size() << "\n"
+                        << "\tNumber of channels: " << iwvfm_spans.size() << "\n"
+                        << "\tNumber of entries: " << (iwvfm_spans.empty() ? 0 : V1730CombinedLength(iwvfm_spans, ewvfm_spans, 0)) << "\n"
                         << "\tTimestamp (ns): " << int(iwvfm_start_v.at(0)) - int(event_trigger_time) << std::endl;
         }
-        for (size_t i = 0; i < iwvfm_v.size(); i++){
-            auto combined_wvfm = iwvfm_v[i];
+
+        // output waveform of each channel (collection and index), none if not stored
+        std::vector<std::pair<std::vector<raw::OpDetWaveform>*, size_t>> owvfm_v(iwvfm_spans.size(), {nullptr, 0});
+
+        for (size_t i = 0; i < iwvfm_spans.size(); i++){
             int board_idx = int(i)/fnch; // integer division to get the board index
 
             if (evt_counter==fhist_evt){
                 if (fdebug>2) std::cout << "Creating histograms for event " << evt_counter << std::endl;
+                std::vector<uint16_t> combined_wvfm;
+                combine(i, combined_wvfm);
                 // histo: save waveforms section for combined waveforms
                 histname.str(std::string());
                 histname << "evt" << evt.event() << "_frag" << fragid_v.at(board_idx) << "_ch" << i%fnch << "_combined_wvfm";
@@ -439,15 +458,28 @@ void sbndaq::SBNDPMTDecoder::produce(art::Event& evt)
             else
                 ch = fch_map.at(fragid_v.at(board_idx)*15 + i%fnch);
             
-            raw::OpDetWaveform waveform(time_diff, ch, combined_wvfm);
-
+            // the samples are filled in below
+            std::vector<raw::OpDetWaveform>* out = nullptr;
             if (i%fnch == 15){
-                if (foutput_ftrig_wvfm) twvfmVec->push_back(waveform);
+                if (foutput_ftrig_wvfm) out = twvfmVec.get();
             }
             else 
-                wvfmVec->push_back(waveform);
+                out = wvfmVec.get();
+
+            if (out){
+                out->emplace_back(time_diff, ch, std::vector<uint16_t>());
+                owvfm_v[i] = {out, out->size()-1};
+            }
         }
 
+        // combine the waveforms straight into the output: each one is copied
+        // once into storage of its final length; channels are independent, so
+        // fill them in parallel
+        tbb::parallel_for(size_t(0), owvfm_v.size(), [&](size_t ich){
+            auto [out, idx] = owvfm_v[ich];
+            if (out) combine(ich, (*out)[idx]);
+        });
+
     } // loop over triggers 
     trig_frag_v.clear(); 
 
@@ -455,7 +487,7 @@ void sbndaq::SBNDPMTDecoder::produce(art::Event& evt)
     evt.put(std::move(twvfmVec),ftr_instance_name);
 }
 
-bool sbndaq::SBNDPMTDecoder::check_fragments(std::vector<artdaq::Fragment> &frag_v, uint32_t& trig_ttt, uint32_t& trig_len){
+bool sbndaq::SBNDPMTDecoder::check_fragments(const FragmentPtrs &frag_v, uint32_t& trig_ttt, uint32_t& trig_len){
     bool pass = true;
     uint32_t this_ttt = 0; 
     uint32_t this_len = 0;
@@ -463,9 +495,9 @@ bool sbndaq::SBNDPMTDecoder::check_fragments(std::vector<artdaq::Fragment> &frag
     for (size_t ifrag=0; ifrag<frag_v.size(); ifrag++){
 
         // assuming that the timing CAEN has fragmentId==8, skip it 
-        if ((frag_v.at(ifrag).fragmentID() - ffragid_offset) == 8 )
+        if ((frag_v.at(ifrag)->fragmentID() - ffragid_offset) == 8 )
             continue;
-        CAENV1730Fragment bb(frag_v.at(ifrag));
+        CAENV1730Fragment bb(*frag_v.at(ifrag));
         CAENV1730Event const* event_ptr = bb.Event();
         auto const * md = bb.Metadata();
         CAENV1730EventHeader header = event_ptr->Header;
@@ -495,39 +527,13 @@ bool sbndaq::SBNDPMTDecoder::check_fragments(std::vector<artdaq::Fragment> &frag
     trig_len = this_len;
     return pass;
 }
-void sbndaq::SBNDPMTDecoder::get_waveforms(artdaq::Fragment & frag, std::vector<std::vector<uint16_t>> & wvfm_v){
-    CAENV1730Fragment bb(frag);
-    auto const* md = bb.Metadata();
-    auto nch = md->nChannels;    
-
-    CAENV1730Event const* event_ptr = bb.Event();
-    CAENV1730EventHeader header = event_ptr->Header;
-    uint32_t ev_size_quad_bytes = header.eventSize;
-    uint32_t evt_header_size_quad_bytes = sizeof(CAENV1730EventHeader)/sizeof(uint32_t);
-    uint32_t data_size_double_bytes = 2*(ev_size_quad_bytes - evt_header_size_quad_bytes);
-    uint32_t wvfm_length = data_size_double_bytes/nch;
-
-    const uint16_t* data_begin = reinterpret_cast<const uint16_t*>(frag.dataBeginBytes() 
-                                   + sizeof(CAENV1730EventHeader));
-    const uint16_t* value_ptr =  data_begin;
-    uint16_t value = 0;
-
-    for (size_t i_ch=0; i_ch<nch; ++i_ch){
-        auto ch_offset = (size_t)(i_ch * wvfm_length);      
-        std::vector<uint16_t> wvfm(wvfm_length,0);
-
-        //--loop over waveform entries
-        for(size_t i_t=0; i_t<wvfm_length; ++i_t){ 
-            value_ptr = data_begin + ch_offset + i_t; 
-            value = *(value_ptr);
-            wvfm.at(i_t) = value;
-        }
-        wvfm_v.push_back(wvfm);
-    }
+// the spans point into the fragment data, which must outlive them
+void sbndaq::SBNDPMTDecoder::get_waveforms(const artdaq::Fragment & frag, std::vector<WaveformSpan> & wvfm_v){
+    V1730WaveformSpans(frag, wvfm_v);
 }
 
 
-void sbndaq::SBNDPMTDecoder::get_timing(artdaq::Fragment & frag, 
+void sbndaq::SBNDPMTDecoder::get_timing(const artdaq::Fragment & frag, 
                                        uint32_t & frag_ttt, 
                                        uint32_t & frag_len, 
                                        int & frag_tick){
@@ -568,22 +574,11 @@ void sbndaq::SBNDPMTDecoder::get_timing(artdaq::Fragment & frag,
     }
 }
 
-uint32_t sbndaq::SBNDPMTDecoder::get_length(artdaq::Fragment & frag){
-    CAENV1730Fragment bb(frag);
-    auto const* md = bb.Metadata();
-    auto nch = md->nChannels;    
-
-    CAENV1730Event const* event_ptr = bb.Event();
-    CAENV1730EventHeader header = event_ptr->Header;
-    uint32_t ev_size_quad_bytes = header.eventSize;
-    uint32_t evt_header_size_quad_bytes = sizeof(CAENV1730EventHeader)/sizeof(uint32_t);
-    uint32_t data_size_double_bytes = 2*(ev_size_quad_bytes - evt_header_size_quad_bytes);
-    uint32_t wvfm_length = data_size_double_bytes/nch;
-
-    return wvfm_length;
+uint32_t sbndaq::SBNDPMTDecoder::get_length(const artdaq::Fragment & frag){
+    return V1730WaveformLength(frag);
 }
 
-uint32_t sbndaq::SBNDPMTDecoder::get_ttt(artdaq::Fragment & frag){
+uint32_t sbndaq::SBNDPMTDecoder::get_ttt(const artdaq::Fragment & frag){
     CAENV1730Fragment bb(frag);
     CAENV1730Event const* event_ptr = bb.Event();
     CAENV1730EventHeader header = event_ptr->Header;
@@ -591,7 +586,7 @@ uint32_t sbndaq::SBNDPMTDecoder::get_ttt(artdaq::Fragment & frag){
     return ttt;
 }
 
-uint32_t sbndaq::SBNDPMTDecoder::get_boardid(artdaq::Fragment & frag){
+uint32_t sbndaq::SBNDPMTDecoder::get_boardid(const artdaq::Fragment & frag){
     CAENV1730Fragment bb(frag);
     CAENV1730Event const* event_ptr = bb.Event();
     CAENV1730EventHeader header = event_ptr->Header;
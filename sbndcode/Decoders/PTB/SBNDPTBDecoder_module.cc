@@ -16,6 +16,7 @@
 #include "messagefacility/MessageLogger/MessageLogger.h"
 
 #include <memory>
+#include <utility>
 
 #include "sbndaq-artdaq-core/Overlays/SBND/PTBFragment.hh"
 #include "artdaq-core/Data/ContainerFragment.hh"
@@ -95,8 +96,8 @@ void SBNDPTBDecoder::produce(art::Event & evt)
 	    {
               ptbsv_t sout;  // output structures
 	      _process_PTB_AUX(*cont_frag[ii], sout);
-              raw::ptb::sbndptb ptbdp(sout.HLTrigs,sout.LLTrigs,sout.ChStats,sout.Feedbacks,sout.Miscs,sout.WordIndexes);
-              sbndptbs.push_back(ptbdp);
+              sbndptbs.emplace_back(std::move(sout.HLTrigs),std::move(sout.LLTrigs),std::move(sout.ChStats),
+                                    std::move(sout.Feedbacks),std::move(sout.Miscs),std::move(sout.WordIndexes));
 	    }
 	}
     }
@@ -109,8 +110,8 @@ void SBNDPTBDecoder::produce(art::Event & evt)
 	{
           ptbsv_t sout;  // output structures
 	  _process_PTB_AUX(frag, sout);
-          raw::ptb::sbndptb ptbdp(sout.HLTrigs,sout.LLTrigs,sout.ChStats,sout.Feedbacks,sout.Miscs,sout.WordIndexes);
-          sbndptbs.push_back(ptbdp);
+          sbndptbs.emplace_back(std::move(sout.HLTrigs),std::move(sout.LLTrigs),std::move(sout.ChStats),
+                                std::move(sout.Feedbacks),std::move(sout.Miscs),std::move(sout.WordIndexes));
 	}
     }
 
@@ -122,94 +123,95 @@ void SBNDPTBDecoder::_process_PTB_AUX(const artdaq::Fragment& frag, ptbsv_t &sou
   sbndaq::CTBFragment ctbfrag(frag);   // somehow the name CTBFragment stuck
 
   // use the same logic in sbndaq-artdaq-core/Overlays/SBND/PTBFragment.cc: operator<<
-  // but separate out the HLTs and LLTs
+  // but separate out the HLTs and LLTs.  Each word is fetched once and dispatched
+  // on its word type, instead of trying each of the typed accessors in turn
   if (fDebugLevel > 0)
     {
       std::cout << "SBNDPTBDecoder_module: got into aux" << std::endl;
     }
-  
-  for (size_t iword = 0; iword < ctbfrag.NWords(); ++iword)
+
+  const size_t nwords = ctbfrag.NWords();
+  sout.WordIndexes.reserve(nwords);
+
+  for (size_t iword = 0; iword < nwords; ++iword)
     {
       if (fDebugLevel > 0)
         {
           std::cout << "SBNDPTBDecoder_module: start processing word: " << iword << std::endl;
 	}
       size_t ix=0;
-      uint32_t wt = 0;
-      if (ctbfrag.Trigger(iword))
-	{
-	  raw::ptb::Trigger tstruct;
-	  tstruct.word_type = ctbfrag.Trigger(iword)->word_type;
-	  wt = tstruct.word_type;
-	  tstruct.trigger_word = ctbfrag.Trigger(iword)->trigger_word;
-	  tstruct.timestamp = ctbfrag.Trigger(iword)->timestamp;
-	  if (ctbfrag.Trigger(iword)->IsHLT()) 
-	    {
-	      ix = sout.HLTrigs.size();
-	      sout.HLTrigs.push_back(tstruct);
-	      if (fDebugLevel > 0)
-		{
-		  std::cout << "SBNDPTBDecoder_module: found HLT: " << wt << " " << ix << std::endl;
-		}
-	    }
-	  else if (ctbfrag.Trigger(iword)->IsLLT())
-	    {
-	      ix = sout.LLTrigs.size();
-	      sout.LLTrigs.push_back(tstruct);
-	      if (fDebugLevel > 0)
-		{
-		  std::cout << "SBNDPTBDecoder_module: found LLT: " << wt << " " << ix << std::endl;
-		}
-	    }
-	}
-      else if (ctbfrag.ChStatus(iword))
+      const uint32_t wt = ctbfrag.Word(iword)->word_type;
+      switch (wt)
 	{
-	  raw::ptb::ChStatus cstruct;
-	  cstruct.timestamp = ctbfrag.ChStatus(iword)->timestamp;
-	  cstruct.beam = ctbfrag.ChStatus(iword)->beam;
-	  cstruct.crt = ctbfrag.ChStatus(iword)->crt;
-	  cstruct.pds = ctbfrag.ChStatus(iword)->pds;
-	  cstruct.mtca = ctbfrag.ChStatus(iword)->mtca;
-	  cstruct.nim = ctbfrag.ChStatus(iword)->nim;
-	  cstruct.auxpds = ctbfrag.ChStatus(iword)->auxpds;
-	  cstruct.word_type = ctbfrag.ChStatus(iword)->word_type;
-	  wt = cstruct.word_type;
-	  ix = sout.ChStats.size();
-	  sout.ChStats.push_back(cstruct);
-	  if (fDebugLevel > 0)
-	    {
-	      std::cout << "SBNDPTBDecoder_module: found CHStat: " << wt << " " << ix << std::endl;
-	    }
-	}
-      else if (ctbfrag.Feedback(iword))
-	{
-	  raw::ptb::Feedback fstruct;
-	  fstruct.timestamp = ctbfrag.Feedback(iword)->timestamp;
-	  fstruct.code = ctbfrag.Feedback(iword)->code;
-	  fstruct.source = ctbfrag.Feedback(iword)->source;
-	  fstruct.payload = ctbfrag.Feedback(iword)->payload;  // broken in two in Tereza's version
-	  fstruct.word_type = ctbfrag.Feedback(iword)->word_type;
-	  wt = fstruct.word_type;
-	  ix = sout.Feedbacks.size();
-	  sout.Feedbacks.push_back(fstruct);
-	  if (fDebugLevel > 0)
-	    {
-	      std::cout << "SBNDPTBDecoder_module: found Feedback: " << wt << " " << ix << std::endl;
-	    }
-	}
-      else
-	{
-	  raw::ptb::Misc mstruct;
-	  mstruct.timestamp = ctbfrag.Word(iword)->timestamp;
-	  mstruct.payload = ctbfrag.Word(iword)->payload;
-	  mstruct.word_type = ctbfrag.Word(iword)->word_type;
-	  wt = mstruct.word_type;
-	  ix = sout.Miscs.size();
-	  sout.Miscs.push_back(mstruct);
-	  if (fDebugLevel > 0)
-	    {
-	      std::cout << "SBNDPTBDecoder_module: found Misc: " << wt << " " << ix << std::endl;
-	    }
+	case ::ptb::content::word::t_gt:
+	case ::ptb::content::word::t_lt:
+	  {
+	    const auto *trig = ctbfrag.Trigger(iword);
+	    raw::ptb::Trigger tstruct;
+	    tstruct.word_type = wt;
+	    tstruct.trigger_word = trig->trigger_word;
+	    tstruct.timestamp = trig->timestamp;
+	    auto &trigs = (wt == (uint32_t) ::ptb::content::word::t_gt) ? sout.HLTrigs : sout.LLTrigs;
+	    ix = trigs.size();
+	    trigs.push_back(tstruct);
+	    if (fDebugLevel > 0)
+	      {
+		std::cout << "SBNDPTBDecoder_module: found " << ((wt == (uint32_t) ::ptb::content::word::t_gt) ? "HLT: " : "LLT: ")
+			  << wt << " " << ix << std::endl;
+	      }
+	    break;
+	  }
+	case ::ptb::content::word::t_ch:
+	  {
+	    const auto *chstat = ctbfrag.ChStatus(iword);
+	    raw::ptb::ChStatus cstruct;
+	    cstruct.timestamp = chstat->timestamp;
+	    cstruct.beam = chstat->beam;
+	    cstruct.crt = chstat->crt;
+	    cstruct.pds = chstat->pds;
+	    cstruct.mtca = chstat->mtca;
+	    cstruct.nim = chstat->nim;
+	    cstruct.auxpds = chstat->auxpds;
+	    cstruct.word_type = wt;
+	    ix = sout.ChStats.size();
+	    sout.ChStats.push_back(cstruct);
+	    if (fDebugLevel > 0)
+	      {
+		std::cout << "SBNDPTBDecoder_module: found CHStat: " << wt << " " << ix << std::endl;
+	      }
+	    break;
+	  }
+	case ::ptb::content::word::t_fback:
+	  {
+	    const auto *fback = ctbfrag.Feedback(iword);
+	    raw::ptb::Feedback fstruct;
+	    fstruct.timestamp = fback->timestamp;
+	    fstruct.code = fback->code;
+	    fstruct.source = fback->source;
+	    fstruct.payload = fback->payload;  // broken in two in Tereza's version
+	    fstruct.word_type = wt;
+	    ix = sout.Feedbacks.size();
+	    sout.Feedbacks.push_back(fstruct);
+	    if (fDebugLevel > 0)
+	      {
+		std::cout << "SBNDPTBDecoder_module: found Feedback: " << wt << " " << ix << std::endl;
+	      }
+	    break;
+	  }
+	default:
+	  {
+	    const auto *word = ctbfrag.Word(iword);
+	    raw::ptb::Misc mstruct;
+	    mstruct.timestamp = word->timestamp;
+	    mstruct.payload = word->payload;
+	    mstruct.word_type = wt;
+	    ix = sout.Miscs.size();
+	    sout.Miscs.push_back(mstruct);
+	    if (fDebugLevel > 0)
+	      {
+		std::cout << "SBNDPTBDecoder_module: found Misc: " << wt << " " << ix << std::endl;
+	      }
+	  }
 	}
 
       raw::ptb::WordIndex wstruct;
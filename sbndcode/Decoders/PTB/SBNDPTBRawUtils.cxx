@@ -5,6 +5,8 @@
 #include "SBNDPTBRawUtils.h"
 #include "sbndaq-artdaq-core/Overlays/SBND/PTB_content.h"
 
+#include <algorithm>
+
 namespace raw {
   namespace ptb {
     const std::vector<raw::ptb::ChStatus>  GetChStatusBeforeHLTs(const raw::ptb::sbndptb &pdata)
@@ -25,43 +27,88 @@ namespace raw {
       const auto &hlts = pdata.GetHLTriggers();
       const auto &idxs = pdata.GetIndexes();
       const auto &chst = pdata.GetChStatuses();
-      
-      for (size_t i=0; i<hlts.size(); ++i)
+
+      // one pass over the word indexes to find the HLT words, ordered by HLT
+      // (the decoder writes them in that order already)
+      std::vector<std::pair<size_t, size_t>> hltwords;  // (HLT index, word index)
+      for (size_t j=0; j<idxs.size(); ++j)
+	{
+	  if (idxs[j].word_type == (uint32_t) ::ptb::content::word::t_gt && idxs[j].index < hlts.size())
+	    {
+	      hltwords.emplace_back(idxs[j].index, j);
+	    }
+	}
+      std::stable_sort(hltwords.begin(), hltwords.end(),
+		       [](auto const &a, auto const &b) { return a.first < b.first; });
+
+      chs.reserve(hltwords.size());
+      for (auto const &hw : hltwords)
 	{
-	  for (size_t j=0; j<idxs.size(); ++j)
+	  size_t kstatindex = hw.second;
+	  if (kstatindex > 0)
 	    {
-	      if (idxs.at(j).word_type == (uint32_t) ::ptb::content::word::t_gt && idxs.at(j).index == i)
+	      kstatindex --;  // it's the word before the HLT that has the chstat
+	      if (idxs[kstatindex].word_type == (uint32_t) ::ptb::content::word::t_ch)
 		{
-		  size_t kstatindex = j;
-		  if (kstatindex > 0)
+		  size_t kstat = idxs[kstatindex].index;
+
+		  if (kstat < chst.size())
 		    {
-		      kstatindex --;  // it's the word before the HLT that has the chstat
-		      if (idxs.at(kstatindex).word_type == (uint32_t) ::ptb::content::word::t_ch)
-			{
-			  size_t kstat = idxs.at(kstatindex).index;
-		      
-			  if (kstat < chst.size())
-			    {
-			      chs.push_back(chst.at(kstat));
-			    }
-			  else
-			    {
-			      chs.push_back(emptychstat);
-			    }
-			}
-		      else
-			{
-			  chs.push_back(emptychstat);
-			}
+		      chs.push_back(chst[kstat]);
 		    }
 		  else
 		    {
 		      chs.push_back(emptychstat);
 		    }
 		}
+	      else
+		{
+		  chs.push_back(emptychstat);
+		}
 	    }
-	}  
+	  else
+	    {
+	      chs.push_back(emptychstat);
+	    }
+	}
       return chs;
     }
+
+    HLTBitIndex::HLTBitIndex(const raw::ptb::sbndptb &pdata)
+    {
+      const auto &hlts = pdata.GetHLTriggers();
+      for (size_t i=0; i<hlts.size(); ++i)
+	{
+	  // visit only the set bits of the trigger word
+	  for (ULong64_t bits = hlts[i].trigger_word; bits != 0; bits &= bits - 1)
+	    {
+	      fByBit[__builtin_ctzll(bits)].emplace_back(hlts[i].timestamp, i);
+	    }
+	}
+      for (auto &entries : fByBit)
+	{
+	  std::stable_sort(entries.begin(), entries.end(),
+			   [](auto const &a, auto const &b) { return a.first < b.first; });
+	}
+    }
+
+    int HLTBitIndex::FirstHLTWithBit(unsigned bit, ULong64_t tmin, ULong64_t tmax) const
+    {
+      if (bit >= kNBits) return -1;
+      const auto &entries = fByBit[bit];
+      auto it = std::lower_bound(entries.begin(), entries.end(), tmin,
+				 [](auto const &e, ULong64_t t) { return e.first < t; });
+      if (it == entries.end() || it->first > tmax) return -1;
+      return it->second;
+    }
+
+    std::vector<size_t> HLTBitIndex::HLTsWithBit(unsigned bit) const
+    {
+      std::vector<size_t> out;
+      if (bit >= kNBits) return out;
+      out.reserve(fByBit[bit].size());
+      for (auto const &e : fByBit[bit]) out.push_back(e.second);
+      return out;
+    }
   }
 }
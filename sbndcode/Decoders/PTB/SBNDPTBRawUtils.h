@@ -9,9 +9,35 @@
 #include "sbndcode/Decoders/PTB/sbndptb.h"
 #include "sbndaq-artdaq-core/Overlays/SBND/PTB_content.h"
 
+#include <utility>
+#include <vector>
+
 namespace raw {
   namespace ptb {
     const std::vector<raw::ptb::ChStatus>  GetChStatusBeforeHLTs(const raw::ptb::sbndptb &pdata);
+
+    /// Lookup table of the HLTs of an sbndptb product by trigger word bit, built once
+    /// so that repeated queries do not re-walk the HLT list
+    class HLTBitIndex
+    {
+    public:
+
+      static constexpr unsigned kNBits = 64;
+
+      explicit HLTBitIndex(const raw::ptb::sbndptb &pdata);
+
+      /// index in GetHLTriggers() of the earliest HLT with trigger word bit `bit` set and
+      /// timestamp in [tmin, tmax], -1 if there is none
+      int FirstHLTWithBit(unsigned bit, ULong64_t tmin, ULong64_t tmax) const;
+
+      /// indices in GetHLTriggers() of the HLTs with trigger word bit `bit` set, in time order
+      std::vector<size_t> HLTsWithBit(unsigned bit) const;
+
+    private:
+
+      // for each bit, (timestamp, HLT index) of the HLTs with that bit set, sorted by timestamp
+      std::vector<std::pair<ULong64_t, size_t>> fByBit[kNBits];
+    };
   }
 }
 
@@ -11,6 +11,7 @@
 
 #include "RtypesCore.h"
 #include <stdint.h>
+#include <utility>
 #include <vector>
 
 namespace raw {
@@ -75,6 +76,21 @@ namespace raw {
       fMiscs(m),
       fIndexes(wordindexes) {};
 
+      // constructor taking over the vectors, as filled by the decoder
+
+      sbndptb(std::vector<raw::ptb::Trigger> &&HLtrigs,
+	    std::vector<raw::ptb::Trigger> &&LLtrigs,
+	    std::vector<raw::ptb::ChStatus> &&chstats,
+	    std::vector<raw::ptb::Feedback> &&fbs,
+	    std::vector<raw::ptb::Misc> &&m,
+	    std::vector<raw::ptb::WordIndex> &&wordindexes) :
+      fHLTriggers(std::move(HLtrigs)),
+      fLLTriggers(std::move(LLtrigs)),
+      fChStatuses(std::move(chstats)),
+      fFeedbacks(std::move(fbs)),
+      fMiscs(std::move(m)),
+      fIndexes(std::move(wordindexes)) {};
+
       const std::vector<raw::ptb::Trigger>&     GetHLTriggers() const;   
       const std::vector<raw::ptb::Trigger>&     GetLLTriggers() const;   
       const std::vector<raw::ptb::ChStatus>&    GetChStatuses() const; 
@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////////////////
+// Class:       NevisTPCUnpacker
+// File:        NevisTPCUnpacker.cc
+////////////////////////////////////////////////////////////////////////
+
+#include "NevisTPCUnpacker.h"
+
+#include <algorithm>
+#include <utility>
+
+daq::NevisTPCUnpacker::NevisTPCUnpacker() {
+  fChannels.reserve(kNChannels);
+}
+
+// Builds, once, the decoded differences of every possible 15 bit Huffman payload
+const std::vector<daq::NevisTPCUnpacker::HuffmanEntry>& daq::NevisTPCUnpacker::HuffmanTable() {
+
+  static const std::vector<HuffmanEntry> table = [] {
+    std::vector<HuffmanEntry> t(1u << 15);
+
+    for (uint32_t payload = 0; payload < t.size(); ++payload) {
+      HuffmanEntry entry{};
+      unsigned zeros = 0;
+
+      for (unsigned bit = 0; bit < 15; ++bit) {
+        if (payload & (1u << bit)) {
+          // codes longer than the table do not correspond to a sample
+          if (zeros < kHuffmanDiffs.size()) {
+            entry.diffs[entry.n_samples++] = kHuffmanDiffs[zeros];
+          }
+          zeros = 0;
+        }
+        else {
+          ++zeros;
+        }
+      }
+
+      t[payload] = entry;
+    }
+
+    return t;
+  }();
+
+  return table;
+}
+
+std::vector<int16_t> daq::NevisTPCUnpacker::TakeWaveform(uint16_t channel) {
+  std::vector<int16_t> ret;
+  std::swap(ret, fWaveforms[channel]);
+  return ret;
+}
+
+uint32_t daq::NevisTPCUnpacker::Unpack(const uint16_t *data, size_t n_words) {
+
+  for (auto channel: fChannels) fWaveforms[channel].clear();
+  fChannels.clear();
+  fCompressed = false;
+
+  auto const &huffman = HuffmanTable();
+
+  uint32_t checksum = 0;
+  std::vector<int16_t> *current = nullptr;
+
+  size_t i_word = 0;
+  while (i_word < n_words) {
+    const uint16_t word = data[i_word];
+
+    // run of uncompressed samples: the top nibble is zero so the words are
+    // the samples themselves, copy them in bulk
+    if ((word & 0xF000) == 0x0000) {
+      size_t end = i_word + 1;
+      while (end < n_words && (data[end] & 0xF000) == 0x0000) ++end;
+
+      for (size_t i = i_word; i < end; ++i) checksum += data[i];
+
+      if (current) current->insert(current->end(), data + i_word, data + end);
+
+      i_word = end;
+      continue;
+    }
+
+    checksum += word;
+    ++i_word;
+
+    // Huffman word: differences to the previous sample
+    if (word & 0x8000) {
+      fCompressed = true;
+      if (!current || current->empty()) continue;
+
+      auto const &entry = huffman[word & 0x7FFF];
+      int16_t last = current->back();
+
+      for (unsigned i = 0; i < entry.n_samples; ++i) {
+        last += entry.diffs[i];
+        current->push_back(last);
+      }
+    }
+    // channel header: start (or restart) the waveform of this channel
+    else if ((word & 0xF000) == 0x4000) {
+      const uint16_t channel = word & 0x3F;
+
+      if (std::find(fChannels.begin(), fChannels.end(), channel) == fChannels.end()) {
+        fChannels.push_back(channel);
+      }
+
+      current = &fWaveforms[channel];
+      current->clear();
+    }
+    // channel ending
+    else if ((word & 0xF000) == 0x5000) {
+      current = nullptr;
+    }
+  }
+
+  // only the lower 24 bits of the checksum are used
+  return checksum & 0xFFFFFF;
+}
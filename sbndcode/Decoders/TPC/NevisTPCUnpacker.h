@@ -0,0 +1,80 @@
+#ifndef NevisTPCUnpacker_h
+#define NevisTPCUnpacker_h
+////////////////////////////////////////////////////////////////////////
+// Class:       NevisTPCUnpacker
+// File:        NevisTPCUnpacker.h
+//
+// Single-pass unpacker for the data words of a Nevis TPC fragment.
+//
+// The data block is a sequence of 16 bit words:
+//   0100 xxxx xxcc cccc  channel header, c = channel number (0-63)
+//   0101 xxxx xxcc cccc  channel ending
+//   0000 aaaa aaaa aaaa  uncompressed 12 bit ADC sample
+//   1hhh hhhh hhhh hhhh  Huffman word, 15 bits of sample differences
+//
+// Huffman codes are read from the least significant bit: each code is
+// a run of n zeros closed by a one, encoding the difference to the
+// previous sample given by kHuffmanDiffs[n]. Zeros above the last one
+// are padding.
+//
+// Runs of uncompressed samples are copied in bulk, Huffman words are
+// decoded through a table covering every 15 bit payload, and the
+// fragment checksum is accumulated in the same pass. The result must
+// match sbndaq::NevisTPCFragment::decode_data sample for sample, see
+// test/Decoders/nevis_tpc_unpacker_test.cxx.
+////////////////////////////////////////////////////////////////////////
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace daq {
+  class NevisTPCUnpacker;
+}
+
+
+class daq::NevisTPCUnpacker {
+public:
+
+  static constexpr unsigned kNChannels = 64;
+
+  // difference to the previous sample for a code of n zeros followed by a one
+  static constexpr std::array<int16_t, 7> kHuffmanDiffs = { 0, -1, 1, -2, 2, -3, 3 };
+
+  NevisTPCUnpacker();
+
+  // unpack n_words data words, replacing the previous content;
+  // returns the checksum of the words (lower 24 bits of their sum)
+  uint32_t Unpack(const uint16_t *data, size_t n_words);
+
+  // channels found in the data, in the order of their headers
+  const std::vector<uint16_t>& Channels() const { return fChannels; }
+
+  // samples of a channel found in the data
+  const std::vector<int16_t>& Waveform(uint16_t channel) const { return fWaveforms[channel]; }
+
+  // hand over the samples of a channel, leaving it empty
+  std::vector<int16_t> TakeWaveform(uint16_t channel);
+
+  // whether the data unpacked last had Huffman words; the checksum in the
+  // fragment header only covers uncompressed data
+  bool Compressed() const { return fCompressed; }
+
+private:
+
+  // decoded content of one Huffman payload
+  struct HuffmanEntry {
+    uint8_t n_samples;                 // number of complete codes
+    std::array<int8_t, 15> diffs;      // difference of each sample to the previous one
+  };
+
+  static const std::vector<HuffmanEntry>& HuffmanTable();
+
+  std::array<std::vector<int16_t>, kNChannels> fWaveforms;
+  std::vector<uint16_t> fChannels;
+  bool fCompressed = false;
+
+};
+
+#endif /* NevisTPCUnpacker_h */
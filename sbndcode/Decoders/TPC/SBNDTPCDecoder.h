@@ -21,8 +21,14 @@
 
 #include "sbndaq-artdaq-core/Overlays/SBND/NevisTPCFragment.hh"
 
+#include "sbndcode/ChannelMaps/TPC/TPCChannelMapService.h"
+
 #include "TPCDecodeAna.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
 /*
   * The Decoder module takes as input "NevisTPCFragments" and
   * outputs raw::RawDigits. It also handles in and all issues
@@ -59,6 +65,7 @@ private:
     bool baseline_calc;
     unsigned n_mode_skip;
     bool subtract_pedestal;
+    bool use_nevis_unpacker;
 
     unsigned channel_per_slot;
     unsigned min_slot_no;
@@ -75,25 +82,65 @@ private:
   typedef art::Assns<raw::RawDigit,raw::RDTimeStamp> RDTsAssocs;
   typedef art::PtrMaker<raw::RawDigit> RDPmkr;
   typedef art::PtrMaker<raw::RDTimeStamp> TSPmkr;
+
+  // the output of one decoded fragment, fragments are decoded independently
+  // and assembled into the event collections afterwards
+  struct DecodedFragment {
+    tpcAnalysis::TPCDecodeAna header;
+    RawDigits digits;
+  };
+
+  // counting histogram of the ADC values of one waveform; the samples are
+  // 12 bit, so the median and the spread follow from the bin counts without
+  // sorting. Samples outside the 12 bit range are flagged as overflow.
+  struct ADCHistogram {
+    static constexpr int kNBins = 4096;
+
+    std::vector<uint32_t> counts = std::vector<uint32_t>(kNBins, 0);
+    size_t n = 0;
+    int64_t sum = 0;
+    int min = kNBins;
+    int max = -1;
+    bool overflow = false;
+
+    void fill(int16_t adc) {
+      if (adc < 0 || adc >= kNBins) {
+        overflow = true;
+        return;
+      }
+      ++counts[adc];
+      ++n;
+      sum += adc;
+      min = std::min<int>(min, adc);
+      max = std::max<int>(max, adc);
+    }
+
+    // only the bins between the lowest and highest sample need resetting
+    void clear() {
+      if (max >= min) std::fill(counts.begin() + min, counts.begin() + max + 1, 0);
+      n = 0;
+      sum = 0;
+      min = kNBins;
+      max = -1;
+      overflow = false;
+    }
+  };
     
-  // process an individual fragment inside an art event
-  void process_fragment(art::Event &event,
-			const artdaq::Fragment &frag,
-                        std::unique_ptr<RawDigits> &rd_collection,
-                        std::unique_ptr<std::vector<tpcAnalysis::TPCDecodeAna>> &header_collection,
-			RDPmkr &rdpm,
-			TSPmkr &tspm,
-			std::unique_ptr<RDTimeStamps> &rdts_collection,
-			std::unique_ptr<RDTsAssocs> &rdtsassoc_collection);
+  // process an individual fragment, does not touch the art event so that
+  // fragments can be processed concurrently
+  void process_fragment(const artdaq::Fragment &frag,
+                        const SBND::TPCChannelMapService &channelMap,
+                        DecodedFragment &decoded) const;
 
 
   // build a TPCDecodeAna object from the Nevis Header
-  tpcAnalysis::TPCDecodeAna Fragment2TPCDecodeAna(art::Event &event, const artdaq::Fragment &frag);
+  tpcAnalysis::TPCDecodeAna Fragment2TPCDecodeAna(const artdaq::Fragment &frag) const;
 
   art::InputTag _tag;
   Config _config;
 
-  void getMedianSigma(const std::vector<int16_t> &v_adc, float &median, float &sigma);
+  static void getMedianSigma(const std::vector<int16_t> &v_adc, float &median, float &sigma);
+  static void getMedianSigma(const ADCHistogram &hist, float &median, float &sigma);
 
 };
 
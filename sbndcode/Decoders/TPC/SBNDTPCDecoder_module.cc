@@ -9,7 +9,7 @@
 ////////////////////////////////////////////////////////////////////////
 
 #include "SBNDTPCDecoder.h"
-#include "sbndcode/ChannelMaps/TPC/TPCChannelMapService.h"
+#include "NevisTPCUnpacker.h"
 
 #include "art/Framework/Principal/Event.h"
 #include "art/Framework/Principal/Handle.h"
@@ -24,6 +24,10 @@
 #include <stdlib.h>
 #include <chrono>
 #include <thread>
+#include <algorithm>
+#include <cmath>
+
+#include "tbb/parallel_for.h"
 
 #include "TMath.h"
 
@@ -40,7 +44,7 @@ DEFINE_ART_MODULE(daq::SBNDTPCDecoder)
 
 // constructs a header data object from a nevis header
 // construct from a nevis header
-tpcAnalysis::TPCDecodeAna daq::SBNDTPCDecoder::Fragment2TPCDecodeAna(art::Event &event, const artdaq::Fragment &frag) {
+tpcAnalysis::TPCDecodeAna daq::SBNDTPCDecoder::Fragment2TPCDecodeAna(const artdaq::Fragment &frag) const {
   sbndaq::NevisTPCFragment fragment(frag);
 
   const sbndaq::NevisTPCHeader *raw_header = fragment.header();
@@ -92,6 +96,10 @@ daq::SBNDTPCDecoder::Config::Config(fhicl::ParameterSet const & param) {
   // should be 1/(2MHz) = 0.5mus
   frame_to_dt = param.get<double>("frame_to_dt", 1);
 
+  // unpack the data words with the in-repo NevisTPCUnpacker instead of
+  // the fragment's decode_data
+  use_nevis_unpacker = param.get<bool>("use_nevis_unpacker", false);
+
   // number of channels in each slot
   channel_per_slot = param.get<unsigned>("channel_per_slot", 0);
   // index of 0th slot
@@ -112,8 +120,40 @@ void daq::SBNDTPCDecoder::produce(art::Event & event)
   std::unique_ptr<std::vector<tpcAnalysis::TPCDecodeAna>> header_collection(new std::vector<tpcAnalysis::TPCDecodeAna>);
 
   if ( daq_handle.isValid() ) {
-    for (auto const &rawfrag: *daq_handle) {
-      process_fragment(event, rawfrag, rawdigit_collection, header_collection, rdpm, tspm, rdts_collection, rdtsassoc_collection);
+    art::ServiceHandle<SBND::TPCChannelMapService> channelMap;
+    const SBND::TPCChannelMapService &channelMapRef = *channelMap;
+
+    // fragments (one per FEM) are independent: decode them in parallel, each
+    // into its own output buffer
+    auto const& fragments = *daq_handle;
+    std::vector<DecodedFragment> decoded(fragments.size());
+
+    tbb::parallel_for(size_t(0), fragments.size(), [&](size_t i) {
+      process_fragment(fragments[i], channelMapRef, decoded[i]);
+    });
+
+    // assemble the output collections in fragment order
+    size_t n_digits = 0;
+    for (auto const &frag_output: decoded) n_digits += frag_output.digits.size();
+
+    rawdigit_collection->reserve(n_digits);
+    rdts_collection->reserve(n_digits);
+    if (_config.produce_header) header_collection->reserve(decoded.size());
+
+    for (auto &frag_output: decoded) {
+      if (_config.produce_header) {
+        header_collection->push_back(frag_output.header);
+      }
+
+      for (auto &digit: frag_output.digits) {
+        rawdigit_collection->push_back(std::move(digit));
+
+        // construct the RDTimeStamp object and make the association
+        rdts_collection->emplace_back(frag_output.header.timestamp,0);
+        auto const rawdigitptr = rdpm(rawdigit_collection->size()-1);
+        auto const rdtimestampptr = tspm(rdts_collection->size()-1);
+        rdtsassoc_collection->addSingle(rawdigitptr,rdtimestampptr);
+      }
     }
   }
   else
@@ -138,61 +178,108 @@ void daq::SBNDTPCDecoder::produce(art::Event & event)
 }
 
 
-void daq::SBNDTPCDecoder::process_fragment(art::Event &event, const artdaq::Fragment &frag, 
-					   std::unique_ptr<RawDigits> &rd_collection,
-					   std::unique_ptr<std::vector<tpcAnalysis::TPCDecodeAna>> &header_collection,
-					   RDPmkr &rdpm,
-					   TSPmkr &tspm,
-					   std::unique_ptr<RDTimeStamps> &rdts_collection,
-					   std::unique_ptr<RDTsAssocs> &rdtsassoc_collection) {
+void daq::SBNDTPCDecoder::process_fragment(const artdaq::Fragment &frag,
+					   const SBND::TPCChannelMapService &channelMap,
+					   DecodedFragment &decoded) const {
 
-  art::ServiceHandle<SBND::TPCChannelMapService> channelMap;
-  
   // convert fragment to Nevis fragment
   sbndaq::NevisTPCFragment fragment(frag);
 
-  std::unordered_map<uint16_t,sbndaq::NevisTPC_Data_t> waveform_map;
-  size_t n_waveforms = fragment.decode_data(waveform_map);
-  (void)n_waveforms;
-
   // need to retrieve the timestamp from the Nevis header and save it in the art event only on request
   
-  auto header_data = Fragment2TPCDecodeAna(event, frag);
-  if (_config.produce_header) {
-    header_collection->push_back(header_data);
-  }
+  decoded.header = Fragment2TPCDecodeAna(frag);
 
   unsigned int FEMCrate = (frag.fragmentID() >> 8) & 0xF;
   unsigned int FEMSlot = fragment.header()->getSlot()-_config.min_slot_no + 1;
-  
-  for (auto waveform: waveform_map) {
-    auto chanInfo = channelMap->GetChanInfoFromFEMElements(FEMCrate,
-							   FEMSlot,
-							   waveform.first); // nevis_channel_id    
-    if (!chanInfo.valid) continue;
 
-    std::vector<int16_t> raw_digits_waveform;
-    raw::ChannelID_t wire_id = chanInfo.offlchan;
+  // ADC histogram of the current channel, filled along with its samples
+  // when the pedestal is calculated
+  ADCHistogram hist;
 
-    for (auto digit: waveform.second) {
-      raw_digits_waveform.push_back( (int16_t) digit);
-    }
+  // builds the RawDigit of one channel, handing over its samples
+  auto add_digit = [&](uint16_t nevis_channel, std::vector<int16_t> &&raw_digits_waveform) {
+    auto const& chanInfo = channelMap.GetChanInfoFromFEMElements(FEMCrate,
+							  FEMSlot,
+							  nevis_channel); // nevis_channel_id    
+    if (!chanInfo.valid) return;
+
+    raw::ChannelID_t wire_id = chanInfo.offlchan;
 
     float median = 0;
     float sigma = 0; 
     if (_config.baseline_calc) {
-      getMedianSigma(raw_digits_waveform, median, sigma);
+      // samples outside the 12 bit range can't be histogrammed, sort them instead
+      if (hist.overflow) getMedianSigma(raw_digits_waveform, median, sigma);
+      else getMedianSigma(hist, median, sigma);
     }
 
     // construct the next RawDigit object
-    rd_collection->emplace_back(wire_id, raw_digits_waveform.size(), raw_digits_waveform);
-    (*rd_collection)[rd_collection->size() - 1].SetPedestal( median, sigma );
-
-    // construct the RDTimeStamp object and make the association
-    rdts_collection->emplace_back(header_data.timestamp,0);
-    auto const rawdigitptr = rdpm(rd_collection->size()-1);
-    auto const rdtimestampptr = tspm(rdts_collection->size()-1);
-    rdtsassoc_collection->addSingle(rawdigitptr,rdtimestampptr);       
+    const size_t n_samples = raw_digits_waveform.size();
+    decoded.digits.emplace_back(wire_id, n_samples, std::move(raw_digits_waveform));
+    decoded.digits.back().SetPedestal( median, sigma );
+  };
+
+  if (_config.use_nevis_unpacker) {
+    // RETURN VALUE OF getADCWordCount IS OFF BY 1
+    const size_t n_words = fragment.header()->getADCWordCount() + 1;
+
+    NevisTPCUnpacker unpacker;
+    const uint32_t checksum = unpacker.Unpack(fragment.data(), n_words);
+
+    // the header checksum can only be checked on uncompressed data
+    if (!unpacker.Compressed() && checksum != (decoded.header.checksum & 0xFFFFFF)) {
+      mf::LogWarning("SBNDTPCDecoder_module") << "Checksum mismatch for FEM crate " << FEMCrate
+                                              << " slot " << FEMSlot << ": header " << decoded.header.checksum
+                                              << ", data " << checksum;
+    }
+
+    // visit the channels in nevis channel order so that the output does not
+    // depend on the data layout
+    std::vector<uint16_t> nevis_channels = unpacker.Channels();
+    std::sort(nevis_channels.begin(), nevis_channels.end());
+
+    decoded.digits.reserve(nevis_channels.size());
+
+    for (auto nevis_channel: nevis_channels) {
+      std::vector<int16_t> waveform = unpacker.TakeWaveform(nevis_channel);
+      if (_config.baseline_calc) {
+        hist.clear();
+        for (auto adc: waveform) hist.fill(adc);
+      }
+      add_digit(nevis_channel, std::move(waveform));
+    }
+
+    return;
+  }
+
+  std::unordered_map<uint16_t,sbndaq::NevisTPC_Data_t> waveform_map;
+  size_t n_waveforms = fragment.decode_data(waveform_map);
+  (void)n_waveforms;
+
+  // visit the channels in nevis channel order so that the output does not
+  // depend on the hash map layout
+  std::vector<uint16_t> nevis_channels;
+  nevis_channels.reserve(waveform_map.size());
+  for (auto const &waveform: waveform_map) nevis_channels.push_back(waveform.first);
+  std::sort(nevis_channels.begin(), nevis_channels.end());
+
+  decoded.digits.reserve(nevis_channels.size());
+  
+  for (auto nevis_channel: nevis_channels) {
+    auto const &waveform = waveform_map.at(nevis_channel);
+    std::vector<int16_t> samples(waveform.size());
+    if (_config.baseline_calc) {
+      // copy the samples and histogram them in the same pass
+      hist.clear();
+      for (size_t i = 0; i < waveform.size(); ++i) {
+        samples[i] = waveform[i];
+        hist.fill(samples[i]);
+      }
+    }
+    else {
+      std::copy(waveform.begin(), waveform.end(), samples.begin());
+    }
+    add_digit(nevis_channel, std::move(samples));
   }
 }
 
@@ -250,3 +337,57 @@ void daq::SBNDTPCDecoder::getMedianSigma(const std::vector<int16_t> &v_adc, floa
     }
   }
 }
+
+// getMedianSigma from the ADC histogram of the waveform: the order statistics
+// and moments are read off the bin counts, in time linear in the samples
+void daq::SBNDTPCDecoder::getMedianSigma(const ADCHistogram &hist, float &median,
+					       float &sigma) {
+  const size_t asiz = hist.n;
+  if (asiz == 0) {
+    median = 0;
+    sigma = 0;
+    return;
+  }
+
+  // value of the k-th smallest sample (k from 0); successive calls must have
+  // increasing k, as the scan resumes from the bin of the previous one
+  int bin = hist.min;
+  size_t below = 0;
+  auto kth = [&](size_t k) {
+    while (below + hist.counts[bin] <= k) below += hist.counts[bin++];
+    return bin;
+  };
+
+  // as TMath::Median: the middle sample, or the mean of the two middle samples
+  double dmed;
+  if (asiz % 2 == 0) {
+    const int lo = kth(asiz/2 - 1);
+    const int hi = kth(asiz/2);
+    dmed = 0.5*(lo + hi);
+  }
+  else {
+    dmed = kth(asiz/2);
+  }
+  const int imed = dmed + 0.01;  // add an offset to make sure the floor gets the right integer
+  median = imed;
+
+  // as TMath::RMS: the standard deviation with n-1 degrees of freedom. The
+  // sum runs over bins rather than samples, so the result agrees with
+  // TMath::RMS to floating point rounding, not bit for bit; the median is exact
+  const double mean = (double) hist.sum / asiz;
+  double tot = 0;
+  size_t s1 = 0;
+  for (int v = hist.min; v <= hist.max; ++v) {
+    if (hist.counts[v] == 0) continue;
+    tot += hist.counts[v]*(v - mean)*(v - mean);
+    if (v < imed) s1 += hist.counts[v];
+  }
+  sigma = (asiz > 1) ? std::sqrt(tot/(asiz - 1)) : 0.;
+
+  // add in a correction suggested by David Adams, May 6, 2019
+  const size_t sm = hist.counts[imed];
+  if (sm > 0) {
+    float mcorr = (-0.5 + (0.5*(float) asiz - (float) s1)/ ((float) sm) );
+    median += mcorr;
+  }
+}
@@ -7,36 +7,209 @@
 #include "sbndcode/Geometry/ChannelMapSBNDAlg.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+  // Returns whether the point, in the local frame of the (trapezoidal) volume, is inside it
+  template <typename Geo, typename LocalPoint>
+  bool IsInsideVolume(Geo const& geo, LocalPoint const& localPoint, double tolerance)
+  {
+    const double HalfCenterWidth = 0.5 * (geo.HalfWidth1() + geo.HalfWidth2());
+
+    return localPoint.Z() >= - (geo.Length()/2 + tolerance) &&
+           localPoint.Z() <=   (geo.Length()/2 + tolerance) &&
+           localPoint.Y() >= - geo.HalfHeight() - tolerance &&
+           localPoint.Y() <=   geo.HalfHeight() + tolerance &&
+           // if AuxDet a is a box, then HalfSmallWidth = HalfWidth
+           localPoint.X() >= - HalfCenterWidth + localPoint.Z()*(HalfCenterWidth - geo.HalfWidth2())/(0.5 * geo.Length()) - tolerance &&
+           localPoint.X() <=   HalfCenterWidth - localPoint.Z()*(HalfCenterWidth - geo.HalfWidth2())/(0.5 * geo.Length()) + tolerance;
+  }
+
+  // Returns the world bounding box of the (trapezoidal) volume, padded against rounding
+  template <typename Geo>
+  std::array<double, 6> WorldBox(Geo const& geo)
+  {
+    constexpr double padding = 1e-3; // cm
+
+    const double halfWidth  = std::max(geo.HalfWidth1(), geo.HalfWidth2());
+    const double halfHeight = geo.HalfHeight();
+    const double halfLength = geo.Length() / 2;
+
+    std::array<double, 6> box = { std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest(),
+                                  std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest(),
+                                  std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest() };
+
+    for(int i = 0; i < 8; ++i) {
+      typename Geo::LocalPoint_t const corner((i & 1 ? 1 : -1) * halfWidth,
+                                              (i & 2 ? 1 : -1) * halfHeight,
+                                              (i & 4 ? 1 : -1) * halfLength);
+      auto const world = geo.toWorldCoords(corner);
+      const double coords[3] = { world.X(), world.Y(), world.Z() };
+
+      for(int c = 0; c < 3; ++c) {
+        box[2*c]   = std::min(box[2*c],   coords[c] - padding);
+        box[2*c+1] = std::max(box[2*c+1], coords[c] + padding);
+      }
+    }
+
+    return box;
+  }
+
+} // local namespace
+
 namespace geo {
-  
-  size_t ChannelMapSBNDAlg::NearestAuxDet(Point_t const& point, std::vector<geo::AuxDetGeo> const& auxDets, double tolerance) const
+
+  void ChannelMapSBNDAlg::BoxGrid::Build(std::vector<Box_t> const& boxes)
+  {
+    fNBoxes = boxes.size();
+    fCellOffsets.clear();
+    fCellBoxes.clear();
+    fNCells = { 0, 0, 0 };
+
+    if(boxes.empty())
+      return;
+
+    std::array<double, 3> max;
+    for(int c = 0; c < 3; ++c) {
+      fMin[c] = std::numeric_limits<double>::max();
+      max[c]  = std::numeric_limits<double>::lowest();
+    }
+
+    for(auto const& box : boxes) {
+      for(int c = 0; c < 3; ++c) {
+        fMin[c] = std::min(fMin[c], box[2*c]);
+        max[c]  = std::max(max[c],  box[2*c+1]);
+      }
+    }
+
+    // Aim for a few cells per box, with cubic cells
+    double volume = 1.;
+    for(int c = 0; c < 3; ++c)
+      volume *= std::max(max[c] - fMin[c], 1.);
+
+    const double targetSize = std::cbrt(volume / (8. * boxes.size()));
+
+    size_t nCellsTotal = 1;
+    for(int c = 0; c < 3; ++c) {
+      const double extent = std::max(max[c] - fMin[c], 1.);
+      fNCells[c]   = std::clamp<size_t>(static_cast<size_t>(std::ceil(extent / targetSize)), 1, 128);
+      fCellSize[c] = extent / fNCells[c];
+      nCellsTotal *= fNCells[c];
+    }
+
+    auto const cellRange = [this](double lo, double hi, int c) {
+      const size_t first = std::clamp<double>(std::floor((lo - fMin[c]) / fCellSize[c]), 0, fNCells[c] - 1);
+      const size_t last  = std::clamp<double>(std::floor((hi - fMin[c]) / fCellSize[c]), 0, fNCells[c] - 1);
+      return std::make_pair(first, last);
+    };
+
+    // Count the boxes in each cell, then fill them in increasing box order
+    std::vector<unsigned> counts(nCellsTotal, 0);
+
+    for(int pass = 0; pass < 2; ++pass) {
+      if(pass == 1) {
+        fCellOffsets.assign(nCellsTotal + 1, 0);
+        for(size_t cell = 0; cell < nCellsTotal; ++cell)
+          fCellOffsets[cell+1] = fCellOffsets[cell] + counts[cell];
+        fCellBoxes.resize(fCellOffsets.back());
+        std::fill(counts.begin(), counts.end(), 0);
+      }
+
+      for(size_t b = 0; b < boxes.size(); ++b) {
+        auto const [x0, x1] = cellRange(boxes[b][0], boxes[b][1], 0);
+        auto const [y0, y1] = cellRange(boxes[b][2], boxes[b][3], 1);
+        auto const [z0, z1] = cellRange(boxes[b][4], boxes[b][5], 2);
+
+        for(size_t x = x0; x <= x1; ++x)
+          for(size_t y = y0; y <= y1; ++y)
+            for(size_t z = z0; z <= z1; ++z) {
+              const size_t cell = (x * fNCells[1] + y) * fNCells[2] + z;
+              if(pass == 1)
+                fCellBoxes[fCellOffsets[cell] + counts[cell]] = b;
+              ++counts[cell];
+            }
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  std::pair<unsigned const*, unsigned const*> ChannelMapSBNDAlg::BoxGrid::Candidates(Point_t const& point) const
+  {
+    if(fCellOffsets.empty())
+      return { nullptr, nullptr };
+
+    const double coords[3] = { point.X(), point.Y(), point.Z() };
+    size_t index[3];
+
+    for(int c = 0; c < 3; ++c) {
+      const double cell = std::floor((coords[c] - fMin[c]) / fCellSize[c]);
+      if(!(cell >= 0.) || cell >= fNCells[c])
+        return { nullptr, nullptr };
+      index[c] = cell;
+    }
+
+    const size_t cell = (index[0] * fNCells[1] + index[1]) * fNCells[2] + index[2];
+
+    return { fCellBoxes.data() + fCellOffsets[cell], fCellBoxes.data() + fCellOffsets[cell+1] };
+  }
+
+  //----------------------------------------------------------------------------
+  void ChannelMapSBNDAlg::Initialize(GeometryData_t const& geodata)
   {
-    double HalfCenterWidth = 0.;
+    ChannelMapStandardAlg::Initialize(geodata);
+
+    auto const& auxDets = geodata.auxDets;
+
+    std::vector<BoxGrid::Box_t> boxes;
+    boxes.reserve(auxDets.size());
+    for(auto const& adg : auxDets)
+      boxes.push_back(WorldBox(adg));
+
+    fAuxDetGrid.Build(boxes);
 
+    fSensitiveGrids.clear();
+    fSensitiveGrids.resize(auxDets.size());
 
     for(size_t a = 0; a < auxDets.size(); ++a) {
+      boxes.clear();
+      for(size_t s = 0; s < auxDets[a].NSensitiveVolume(); ++s)
+        boxes.push_back(WorldBox(auxDets[a].SensitiveVolume(s)));
 
-      auto const localPoint = auxDets[a].toLocalCoords(point);
+      fSensitiveGrids[a].Build(boxes);
+    }
+  }
 
-      HalfCenterWidth = 0.5 * (auxDets[a].HalfWidth1() + auxDets[a].HalfWidth2());
-      
-      if( localPoint.Z() >= - (auxDets[a].Length()/2 + tolerance) &&
-          localPoint.Z() <=   (auxDets[a].Length()/2 + tolerance) &&
-          localPoint.Y() >= - auxDets[a].HalfHeight() - tolerance &&
-          localPoint.Y() <=   auxDets[a].HalfHeight() + tolerance &&
-          // if AuxDet a is a box, then HalfSmallWidth = HalfWidth
-          localPoint.X() >= - HalfCenterWidth + localPoint.Z()*(HalfCenterWidth - auxDets[a].HalfWidth2())/(0.5 * auxDets[a].Length()) - tolerance &&
-          localPoint.X() <=   HalfCenterWidth - localPoint.Z()*(HalfCenterWidth - auxDets[a].HalfWidth2())/(0.5 * auxDets[a].Length()) + tolerance
-          ) return a;
+  //----------------------------------------------------------------------------
+  size_t ChannelMapSBNDAlg::NearestAuxDet(Point_t const& point, std::vector<geo::AuxDetGeo> const& auxDets, double tolerance) const
+  {
+    // The grid boxes only cover the volumes themselves, so fall back to
+    // the full scan with a tolerance or for a different set of AuxDets
+    if(tolerance == 0 && fAuxDetGrid.NBoxes() == auxDets.size()) {
+
+      auto const [begin, end] = fAuxDetGrid.Candidates(point);
+
+      for(auto it = begin; it != end; ++it) {
+        if(IsInsideVolume(auxDets[*it], auxDets[*it].toLocalCoords(point), tolerance))
+          return *it;
+      }
+    }
+    else {
 
-    }// for loop over AudDet a
+      for(size_t a = 0; a < auxDets.size(); ++a) {
+        if(IsInsideVolume(auxDets[a], auxDets[a].toLocalCoords(point), tolerance))
+          return a;
+      }// for loop over AudDet a
+    }
 
     // log a message because we couldn't find the aux det volume, exception in base class
     mf::LogDebug("ChannelMapSBND") << "Can't find AuxDet for position ("
                                    << point.X() << ","
                                    << point.Y() << ","
                                    << point.Z() << ")\n";
-    
+
     return UINT_MAX;
 
   }
@@ -44,8 +217,6 @@ namespace geo {
   //----------------------------------------------------------------------------
   size_t ChannelMapSBNDAlg::NearestSensitiveAuxDet(Point_t const& point, std::vector<geo::AuxDetGeo> const& auxDets, double tolerance) const
   {
-    double HalfCenterWidth = 0.;
-
     size_t auxDetIdx = this->NearestAuxDet(point, auxDets, tolerance);
 
     if(auxDetIdx == UINT_MAX)
@@ -53,29 +224,32 @@ namespace geo {
 
     geo::AuxDetGeo const& adg = auxDets[auxDetIdx];
 
-    for(size_t a = 0; a < adg.NSensitiveVolume(); ++a) {
+    if(tolerance == 0 && fSensitiveGrids.size() == auxDets.size() &&
+       fSensitiveGrids[auxDetIdx].NBoxes() == adg.NSensitiveVolume()) {
 
-      geo::AuxDetSensitiveGeo const& adsg = adg.SensitiveVolume(a);
-      auto const localPoint = adsg.toLocalCoords(point);
+      auto const [begin, end] = fSensitiveGrids[auxDetIdx].Candidates(point);
 
-      HalfCenterWidth = 0.5 * (adsg.HalfWidth1() + adsg.HalfWidth2());
+      for(auto it = begin; it != end; ++it) {
+        geo::AuxDetSensitiveGeo const& adsg = adg.SensitiveVolume(*it);
+        if(IsInsideVolume(adsg, adsg.toLocalCoords(point), tolerance))
+          return *it;
+      }
+    }
+    else {
 
-      if( localPoint.Z() >= - (adsg.Length()/2 + tolerance) &&
-          localPoint.Z() <=   (adsg.Length()/2 + tolerance) &&
-          localPoint.Y() >= - adsg.HalfHeight() - tolerance &&
-          localPoint.Y() <=   adsg.HalfHeight() + tolerance &&
-          // if AuxDet a is a box, then HalfSmallWidth = HalfWidth
-          localPoint.X() >= - HalfCenterWidth + localPoint.Z()*(HalfCenterWidth - adsg.HalfWidth2())/(0.5 * adsg.Length()) - tolerance &&
-          localPoint.X() <=   HalfCenterWidth - localPoint.Z()*(HalfCenterWidth - adsg.HalfWidth2())/(0.5 * adsg.Length()) + tolerance
-          ) return a;
-    }// for loop over AuxDetSensitive a
+      for(size_t a = 0; a < adg.NSensitiveVolume(); ++a) {
+        geo::AuxDetSensitiveGeo const& adsg = adg.SensitiveVolume(a);
+        if(IsInsideVolume(adsg, adsg.toLocalCoords(point), tolerance))
+          return a;
+      }// for loop over AuxDetSensitive a
+    }
 
     // log a message because we couldn't find the sensitive aux det volume, exception in base class
     mf::LogDebug("ChannelMapSBND") << "Can't find AuxDetSensitive for position ("
                                    << point.X() << ","
                                    << point.Y() << ","
                                    << point.Z() << ")\n";
-    
+
     return UINT_MAX;
   }
 
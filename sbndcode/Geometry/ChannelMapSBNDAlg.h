@@ -18,6 +18,11 @@
 // LArSoft libraries
 #include "larcorealg/Geometry/ChannelMapStandardAlg.h"
 
+// C/C++ standard libraries
+#include <array>
+#include <utility>
+#include <vector>
+
 
 namespace geo {
   
@@ -27,12 +32,45 @@ namespace geo {
    * This uses the standard channel mapping, and the custom sorter
    * `GeoObjectSortersbnd`.
    *
-   * 
+   * The auxiliary detector lookups use uniform grids over the world
+   * bounding boxes of the auxiliary detectors and of their sensitive
+   * volumes, built at initialization, so that only the few volumes
+   * overlapping the cell of a point are tested.
    */
   class ChannelMapSBNDAlg : public ChannelMapStandardAlg {
     
+    /// Uniform grid over a set of axis-aligned world bounding boxes.
+    class BoxGrid {
+        public:
+
+      /// Bounding box as { minX, maxX, minY, maxY, minZ, maxZ }.
+      using Box_t = std::array<double, 6>;
+
+      /// Fills the grid with the specified boxes, replacing any previous ones.
+      void Build(std::vector<Box_t> const& boxes);
+
+      /// Number of boxes in the grid.
+      size_t NBoxes() const { return fNBoxes; }
+
+      /// Range of the indices of the boxes which may contain the point,
+      /// in increasing order (empty if the point is outside the grid).
+      std::pair<unsigned const*, unsigned const*> Candidates(Point_t const& point) const;
+
+        private:
+
+      size_t fNBoxes = 0;                  ///< Number of boxes in the grid.
+      std::array<double, 3> fMin;          ///< Lower corner of the grid.
+      std::array<double, 3> fCellSize;     ///< Cell size on each axis.
+      std::array<size_t, 3> fNCells {};    ///< Number of cells on each axis.
+      std::vector<unsigned> fCellOffsets;  ///< Start of each cell in fCellBoxes.
+      std::vector<unsigned> fCellBoxes;    ///< Indices of the boxes overlapping each cell.
+    }; // class BoxGrid
+
     geo::GeoObjectSorterSBND fSBNDsorter; ///< Sorts geo::XXXGeo objects.
     
+    BoxGrid fAuxDetGrid; ///< Grid over the auxiliary detectors.
+    std::vector<BoxGrid> fSensitiveGrids; ///< Grids over the sensitive volumes of each auxiliary detector.
+    
       public:
     
     ChannelMapSBNDAlg(fhicl::ParameterSet const& p)
@@ -40,6 +78,9 @@ namespace geo {
       , fSBNDsorter(p)
       {}
     
+    /// Initializes the standard channel map and the auxiliary detector grids.
+    virtual void Initialize(GeometryData_t const& geodata) override;
+    
     /// Returns a custom SBND sorter.
     virtual geo::GeoObjectSorter const& Sorter() const override 
       { return fSBNDsorter; }
@@ -1,5 +1,28 @@
 #include "CRTGeoAlg.h"
 
+namespace {
+
+  // Reorders the objects by name, the order the former name-keyed std::map
+  // containers iterated in, and returns the old ID -> new ID table
+  template<typename Geo, typename ID>
+  std::vector<ID> SortByName(std::vector<Geo> &objects, std::map<std::string, ID> &index)
+  {
+    std::vector<ID>  newIDs(objects.size());
+    std::vector<Geo> sorted;
+    sorted.reserve(objects.size());
+
+    for(auto &[name, id] : index)
+      {
+        newIDs[id] = sorted.size();
+        sorted.push_back(std::move(objects[id]));
+        id = newIDs[id];
+      }
+
+    objects = std::move(sorted);
+    return newIDs;
+  }
+}
+
 namespace sbnd::crt {
 
   CRTGeoAlg::CRTGeoAlg(fhicl::ParameterSet const &p) :
@@ -32,14 +55,15 @@ namespace sbnd::crt {
     fChannelInversion         = std::map<unsigned, bool>(fChannelInversionVector.begin(),
                                                          fChannelInversionVector.end());
 
-    // Record used objects
-    std::vector<std::string> usedTaggers;
-    std::vector<std::string> usedModules;
-    std::vector<std::string> usedStrips;
-
     // Loop through aux dets
     const std::vector<geo::AuxDetGeo> &auxDets = fAuxDetGeoCore->AuxDetGeoVec();
 
+    // Each aux det holds 16 strips with two SiPMs each, SiPMs are stored by channel
+    fSiPMs.resize(32 * auxDets.size());
+    fNSiPMs = 0;
+
+    fAuxDetModules.resize(auxDets.size(), std::numeric_limits<uint16_t>::max());
+
     for(unsigned ad_i = 0; ad_i < auxDets.size(); ++ad_i)
       {
         const geo::AuxDetGeo &auxDet = auxDets[ad_i];
@@ -73,17 +97,19 @@ namespace sbnd::crt {
 
             // Fill the tagger information
             const std::string taggerName = nodeTagger->GetName();
-            if(std::find(usedTaggers.begin(), usedTaggers.end(), taggerName) == usedTaggers.end())
+            auto taggerIt = fTaggerIndex.find(taggerName);
+            if(taggerIt == fTaggerIndex.end())
               {
-                usedTaggers.push_back(taggerName);
-                CRTTaggerGeo tagger  = CRTTaggerGeo(nodeTagger, nodeDet);
-                fTaggers.insert(std::pair<std::string, CRTTaggerGeo>(taggerName, tagger));
+                taggerIt = fTaggerIndex.emplace(taggerName, fTaggers.size()).first;
+                fTaggers.emplace_back(nodeTagger, nodeDet);
               }
+            const uint16_t taggerID = taggerIt->second;
 
             // Fill the module information
             const std::string moduleName = nodeModule->GetName();
             const bool invert = fChannelInversion.size() ? fChannelInversion.at(ad_i) : false;
-            if(std::find(usedModules.begin(), usedModules.end(), moduleName) == usedModules.end())
+            auto moduleIt = fModuleIndex.find(moduleName);
+            if(moduleIt == fModuleIndex.end())
               {
                 const int32_t t0CableDelayCorrection = fT0CableLengthCorrections.size() ?
                   fT0CableLengthCorrections.at(ad_i) : 0;
@@ -93,25 +119,27 @@ namespace sbnd::crt {
                 const std::string stripName = nodeStrip->GetVolume()->GetName();
                 const bool minos = stripName.find("MINOS") != std::string::npos ? true : false;
 
-                usedModules.push_back(moduleName);
-                CRTModuleGeo module  = CRTModuleGeo(nodeModule, auxDet, ad_i, taggerName,
-                                                    t0CableDelayCorrection, t1CableDelayCorrection,
-                                                    invert, minos);
-                fModules.insert(std::pair<std::string, CRTModuleGeo>(moduleName, module));
+                moduleIt = fModuleIndex.emplace(moduleName, fModules.size()).first;
+                fModules.emplace_back(nodeModule, auxDet, ad_i, taggerName, taggerID,
+                                      t0CableDelayCorrection, t1CableDelayCorrection,
+                                      invert, minos);
               }
+            const uint16_t moduleID = moduleIt->second;
+            fAuxDetModules[ad_i]    = moduleID;
 
             // Fill the strip information
             const std::string stripName = nodeStrip->GetName();
             // Some modules need their channel numbers counted in reverse as they're inverted relative to the geometry
             const uint32_t channel0 = invert ? 32 * ad_i + (31 - 2 * ads_i) : 32 * ad_i + 2 * ads_i;
             const uint32_t channel1 = invert ? 32 * ad_i + (31 - 2 * ads_i -1) : 32 * ad_i + 2 * ads_i + 1;
-            if(std::find(usedStrips.begin(), usedStrips.end(), stripName) == usedStrips.end())
+            auto stripIt = fStripIndex.find(stripName);
+            if(stripIt == fStripIndex.end())
               {
-                usedStrips.push_back(stripName);
-                CRTStripGeo strip  = CRTStripGeo(nodeStrip, auxDetSensitive, ads_i, moduleName,
-                                                 channel0, channel1);
-                fStrips.insert(std::pair<std::string, CRTStripGeo>(stripName, strip));
+                stripIt = fStripIndex.emplace(stripName, fStrips.size()).first;
+                fStrips.emplace_back(nodeStrip, auxDetSensitive, ads_i, moduleName, moduleID,
+                                     channel0, channel1);
               }
+            const uint32_t stripID = stripIt->second;
 
             double halfWidth  = auxDetSensitive.HalfWidth1();
             double halfHeight = auxDetSensitive.HalfHeight();
@@ -120,7 +148,7 @@ namespace sbnd::crt {
             // SiPM0 is on the left in local coordinates
             const double sipm0Y = -halfHeight;
             const double sipm1Y = halfHeight;
-            const double sipmX  = fModules.at(moduleName).top ? halfWidth : -halfWidth;
+            const double sipmX  = fModules[moduleID].top ? halfWidth : -halfWidth;
 
             // Find world coordinates
             geo::AuxDetSensitiveGeo::LocalPoint_t const sipm0XYZ{sipmX, sipm0Y, 0};
@@ -135,18 +163,55 @@ namespace sbnd::crt {
             const double gain0 = fSiPMGains.size() ? fSiPMGains.at(channel0) : fDefaultGain;
             const double gain1 = fSiPMGains.size() ? fSiPMGains.at(channel1) : fDefaultGain;
 
-            // Fill SiPM information
-            CRTSiPMGeo sipm0 = CRTSiPMGeo(stripName, channel0, sipm0XYZWorld, pedestal0, gain0);
-            CRTSiPMGeo sipm1 = CRTSiPMGeo(stripName, channel1, sipm1XYZWorld, pedestal1, gain1);
-            fSiPMs.insert(std::pair<uint16_t, CRTSiPMGeo>(channel0, sipm0));
-            fSiPMs.insert(std::pair<uint16_t, CRTSiPMGeo>(channel1, sipm1));
+            // Fill SiPM information, the first strip to claim a channel keeps it
+            if(fSiPMs.at(channel0).null)
+              {
+                fSiPMs[channel0] = CRTSiPMGeo(stripName, stripID, channel0, sipm0XYZWorld, pedestal0, gain0);
+                ++fNSiPMs;
+              }
+            if(fSiPMs.at(channel1).null)
+              {
+                fSiPMs[channel1] = CRTSiPMGeo(stripName, stripID, channel1, sipm1XYZWorld, pedestal1, gain1);
+                ++fNSiPMs;
+              }
           }
       }
+
+    // Keep the name ordering of the bulk accessors, which callers iterating
+    // over taggers (e.g. WhichTagger) rely on, and renumber the IDs to match
+    const std::vector<uint16_t> taggerIDs = SortByName(fTaggers, fTaggerIndex);
+    const std::vector<uint16_t> moduleIDs = SortByName(fModules, fModuleIndex);
+    const std::vector<uint32_t> stripIDs  = SortByName(fStrips, fStripIndex);
+
+    for(auto &module : fModules)
+      module.taggerID = taggerIDs[module.taggerID];
+
+    for(auto &strip : fStrips)
+      strip.moduleID = moduleIDs[strip.moduleID];
+
+    for(auto &sipm : fSiPMs)
+      {
+        if(!sipm.null)
+          sipm.stripID = stripIDs[sipm.stripID];
+      }
+
+    for(auto &moduleID : fAuxDetModules)
+      {
+        if(moduleID < moduleIDs.size())
+          moduleID = moduleIDs[moduleID];
+      }
+
+    fCRTLimits = CalculateCRTLimits();
   }
 
   CRTGeoAlg::~CRTGeoAlg() {}
 
-  std::vector<double> CRTGeoAlg::CRTLimits() const {
+  std::vector<double> CRTGeoAlg::CRTLimits() const
+  {
+    return fCRTLimits;
+  }
+
+  std::vector<double> CRTGeoAlg::CalculateCRTLimits() const {
     std::vector<double> limits;
 
     std::vector<double> minXs;
@@ -156,12 +221,12 @@ namespace sbnd::crt {
     std::vector<double> maxYs;
     std::vector<double> maxZs;
     for(auto const& tagger : fTaggers){
-      minXs.push_back(tagger.second.minX);
-      minYs.push_back(tagger.second.minY);
-      minZs.push_back(tagger.second.minZ);
-      maxXs.push_back(tagger.second.maxX);
-      maxYs.push_back(tagger.second.maxY);
-      maxZs.push_back(tagger.second.maxZ);
+      minXs.push_back(tagger.minX);
+      minYs.push_back(tagger.minY);
+      minZs.push_back(tagger.minZ);
+      maxXs.push_back(tagger.maxX);
+      maxYs.push_back(tagger.maxY);
+      maxZs.push_back(tagger.maxZ);
     }
     limits.push_back(*std::min_element(minXs.begin(), minXs.end()));
     limits.push_back(*std::min_element(minYs.begin(), minYs.end()));
@@ -190,86 +255,100 @@ namespace sbnd::crt {
 
   size_t CRTGeoAlg::NumSiPMs() const
   {
-    return fSiPMs.size();
+    return fNSiPMs;
   }
 
-  std::map<std::string, CRTTaggerGeo> CRTGeoAlg::GetTaggers() const
+  const std::vector<CRTTaggerGeo>& CRTGeoAlg::GetTaggers() const
   {
     return fTaggers;
   }
 
-  std::map<std::string, CRTModuleGeo> CRTGeoAlg::GetModules() const
+  const std::vector<CRTModuleGeo>& CRTGeoAlg::GetModules() const
   {
     return fModules;
   }
 
-  std::map<std::string, CRTStripGeo> CRTGeoAlg::GetStrips() const
+  const std::vector<CRTStripGeo>& CRTGeoAlg::GetStrips() const
   {
     return fStrips;
   }
 
-  std::map<uint16_t, CRTSiPMGeo> CRTGeoAlg::GetSiPMs() const
+  const std::vector<CRTSiPMGeo>& CRTGeoAlg::GetSiPMs() const
   {
     return fSiPMs;
   }
 
-  CRTTaggerGeo CRTGeoAlg::GetTagger(const std::string taggerName) const
+  const CRTTaggerGeo& CRTGeoAlg::GetTaggerByID(const uint16_t taggerID) const
   {
-    return fTaggers.at(taggerName);
+    return fTaggers.at(taggerID);
   }
 
-  CRTModuleGeo CRTGeoAlg::GetModule(const std::string moduleName) const
+  const CRTModuleGeo& CRTGeoAlg::GetModuleByID(const uint16_t moduleID) const
   {
-    return fModules.at(moduleName);
+    return fModules.at(moduleID);
   }
 
-  CRTModuleGeo CRTGeoAlg::GetModule(const uint16_t channel) const
+  const CRTStripGeo& CRTGeoAlg::GetStripByID(const uint32_t stripID) const
   {
-    return fModules.at(fStrips.at(fSiPMs.at(channel).stripName).moduleName);
+    return fStrips.at(stripID);
   }
 
-  CRTModuleGeo CRTGeoAlg::GetModuleByAuxDetIndex(const unsigned ad_i) const
+  const CRTTaggerGeo& CRTGeoAlg::GetTagger(const std::string &taggerName) const
   {
-    for(auto const &[name, module] : fModules)
-      {
-        if(module.adID == ad_i)
-          return module;
-      }
+    return fTaggers[fTaggerIndex.at(taggerName)];
+  }
 
-    CRTModuleGeo void_return;
-    return void_return;
+  const CRTModuleGeo& CRTGeoAlg::GetModule(const std::string &moduleName) const
+  {
+    return fModules[fModuleIndex.at(moduleName)];
   }
 
-  CRTStripGeo CRTGeoAlg::GetStrip(const std::string stripName) const
+  const CRTModuleGeo& CRTGeoAlg::GetModule(const uint16_t channel) const
   {
-    return fStrips.at(stripName);
+    return fModules[GetStrip(channel).moduleID];
   }
 
-  CRTStripGeo CRTGeoAlg::GetStrip(const uint16_t channel) const
+  const CRTModuleGeo& CRTGeoAlg::GetModuleByAuxDetIndex(const unsigned ad_i) const
   {
-    return fStrips.at(fSiPMs.at(channel).stripName);
+    if(ad_i < fAuxDetModules.size() && fAuxDetModules[ad_i] < fModules.size())
+      return fModules[fAuxDetModules[ad_i]];
+
+    return fNullModule;
   }
 
-  CRTStripGeo CRTGeoAlg::GetStripByAuxDetIndices(const unsigned ad_i, const unsigned ads_i) const
+  const CRTStripGeo& CRTGeoAlg::GetStrip(const std::string &stripName) const
   {
-    const CRTModuleGeo module = GetModule(ad_i);
+    return fStrips[fStripIndex.at(stripName)];
+  }
+
+  const CRTStripGeo& CRTGeoAlg::GetStrip(const uint16_t channel) const
+  {
+    // Throws for channels without a SiPM, as the map lookup used to
+    return fStrips.at(fSiPMs.at(channel).stripID);
+  }
+
+  const CRTStripGeo& CRTGeoAlg::GetStripByAuxDetIndices(const unsigned ad_i, const unsigned ads_i) const
+  {
+    // The module must be found by aux det index, the channel lookup would
+    // pick up the module of aux det ad_i / 32 and its channel ordering
+    const CRTModuleGeo &module = GetModuleByAuxDetIndex(ad_i);
     const uint16_t channel =
       module.invertedOrdering ? 32 * ad_i + (31 -2 *ads_i) : 32 * ad_i + 2 * ads_i;
 
     return GetStrip(channel);
   }
 
-  CRTSiPMGeo CRTGeoAlg::GetSiPM(const uint16_t channel) const
+  const CRTSiPMGeo& CRTGeoAlg::GetSiPM(const uint16_t channel) const
   {
     return fSiPMs.at(channel);
   }
 
   std::string CRTGeoAlg::GetTaggerName(const std::string name) const
   {
-    if(fStrips.find(name) != fStrips.end())
-      return fModules.at(fStrips.at(name).moduleName).taggerName;
-    else if(fModules.find(name) != fModules.end())
-      return fModules.at(name).taggerName;
+    if(fStripIndex.find(name) != fStripIndex.end())
+      return GetModuleByID(GetStrip(name).moduleID).taggerName;
+    else if(fModuleIndex.find(name) != fModuleIndex.end())
+      return GetModule(name).taggerName;
     
     return "";
   }
@@ -281,17 +360,17 @@ namespace sbnd::crt {
 
   std::string CRTGeoAlg::ChannelToTaggerName(const uint16_t channel) const
   {
-    return fModules.at(fStrips.at(fSiPMs.at(channel).stripName).moduleName).taggerName;
+    return GetModule(channel).taggerName;
   }
 
   enum CRTTagger CRTGeoAlg::ChannelToTaggerEnum(const uint16_t channel) const
   {
-    return CRTCommonUtils::GetTaggerEnum(ChannelToTaggerName(channel));
+    return GetModule(channel).tagger;
   }
 
   size_t CRTGeoAlg::ChannelToOrientation(const uint16_t channel) const
   {
-    return fModules.at(fStrips.at(fSiPMs.at(channel).stripName).moduleName).orientation;
+    return GetModule(channel).orientation;
   }
 
   std::array<double, 6> CRTGeoAlg::StripHit3DPos(const uint16_t channel, const double x,
@@ -300,7 +379,7 @@ namespace sbnd::crt {
     const CRTStripGeo &strip = GetStrip(channel);
 
     const uint16_t adsID = strip.adsID;
-    const uint16_t adID  = fModules.at(strip.moduleName).adID;
+    const uint16_t adID  = fModules[strip.moduleID].adID;
 
     const geo::AuxDetSensitiveGeo &auxDetSensitive = fAuxDetGeoCore->AuxDetGeoVec()[adID].SensitiveVolume(adsID);
 
@@ -324,7 +403,7 @@ namespace sbnd::crt {
                                                       const double y, const double z)
   {
     const uint16_t adsID = strip.adsID;
-    const uint16_t adID  = fModules.at(strip.moduleName).adID;
+    const uint16_t adID  = fModules[strip.moduleID].adID;
 
     const geo::AuxDetSensitiveGeo &auxDetSensitive = fAuxDetGeoCore->AuxDetGeoVec()[adID].SensitiveVolume(adsID);
 
@@ -338,8 +417,7 @@ namespace sbnd::crt {
   std::vector<double> CRTGeoAlg::StripWorldToLocalPos(const uint16_t channel, const double x,
                                                       const double y, const double z)
   {
-    const CRTStripGeo strip = GetStrip(channel);
-    return StripWorldToLocalPos(strip, x, y, z);
+    return StripWorldToLocalPos(GetStrip(channel), x, y, z);
   }
 
   std::array<double, 6> CRTGeoAlg::FEBWorldPos(const CRTModuleGeo &module)
@@ -414,7 +492,7 @@ namespace sbnd::crt {
 
   std::pair<int, int> CRTGeoAlg::GetStripSipmChannels(const std::string stripName) const
   {
-    const CRTStripGeo &strip = fStrips.at(stripName);
+    const CRTStripGeo &strip = GetStrip(stripName);
     return std::make_pair(strip.channel0, strip.channel1);
   }
 
@@ -425,7 +503,11 @@ namespace sbnd::crt {
     // three world axes. This would potentially not always be the case... e.g. using
     // an A-frame. We would need to amend this in that scenario.
 
-    const CRTStripGeo &strip = fStrips.at(stripName);
+    return DistanceDownStrip(position, GetStrip(stripName));
+  }
+
+  double CRTGeoAlg::DistanceDownStrip(const geo::Point_t position, const CRTStripGeo &strip) const
+  {
     double distance = std::numeric_limits<double>::max();
 
     const geo::Point_t pos = ChannelToSipmPosition(strip.channel0);
@@ -443,15 +525,13 @@ namespace sbnd::crt {
 
   double CRTGeoAlg::DistanceDownStrip(const geo::Point_t position, const uint16_t channel) const
   {
-    const CRTSiPMGeo sipm = fSiPMs.at(channel);
-
-    return DistanceDownStrip(position, sipm.stripName);
+    return DistanceDownStrip(position, GetStrip(channel));
   }
 
   bool CRTGeoAlg::CheckOverlap(const CRTStripGeo &strip1, const CRTStripGeo &strip2, const double overlap_buffer)
   {
-    const CRTTagger tagger1 = CRTCommonUtils::GetTaggerEnum(ChannelToTaggerName(strip1.channel0));
-    const CRTTagger tagger2 = CRTCommonUtils::GetTaggerEnum(ChannelToTaggerName(strip2.channel0));
+    const CRTTagger tagger1 = fModules[strip1.moduleID].tagger;
+    const CRTTagger tagger2 = fModules[strip2.moduleID].tagger;
 
     if(tagger1 != tagger2)
       return false;
@@ -480,18 +560,15 @@ namespace sbnd::crt {
 
   bool CRTGeoAlg::CheckOverlap(const uint16_t channel1, const uint16_t channel2, const double overlap_buffer)
   {
-    CRTStripGeo strip1 = GetStrip(channel1);
-    CRTStripGeo strip2 = GetStrip(channel2);
-
-    return CheckOverlap(strip1, strip2, overlap_buffer);
+    return CheckOverlap(GetStrip(channel1), GetStrip(channel2), overlap_buffer);
   }
 
   bool CRTGeoAlg::AdjacentStrips(const CRTStripGeo &strip1, const CRTStripGeo &strip2, const double overlap_buffer)
   {
-    CRTModuleGeo module1 = GetModule(strip1.channel0);
-    CRTModuleGeo module2 = GetModule(strip2.channel0);
+    const CRTModuleGeo &module1 = fModules[strip1.moduleID];
+    const CRTModuleGeo &module2 = fModules[strip2.moduleID];
 
-    if(module1.taggerName != module2.taggerName || module1.orientation != module2.orientation)
+    if(module1.taggerID != module2.taggerID || module1.orientation != module2.orientation)
       return false;
 
     const double minX = std::max(strip1.minX, strip2.minX);
@@ -516,23 +593,20 @@ namespace sbnd::crt {
 
   bool CRTGeoAlg::AdjacentStrips(const uint16_t channel1, const uint16_t channel2, const double overlap_buffer)
   {
-    CRTStripGeo strip1 = GetStrip(channel1);
-    CRTStripGeo strip2 = GetStrip(channel2);
-
-    return AdjacentStrips(strip1, strip2, overlap_buffer);
+    return AdjacentStrips(GetStrip(channel1), GetStrip(channel2), overlap_buffer);
   }
 
   bool CRTGeoAlg::DifferentOrientations(const CRTStripGeo &strip1, const CRTStripGeo &strip2)
   {
-    const CRTModuleGeo module1 = GetModule(strip1.moduleName);
-    const CRTModuleGeo module2 = GetModule(strip2.moduleName);
+    const CRTModuleGeo &module1 = fModules[strip1.moduleID];
+    const CRTModuleGeo &module2 = fModules[strip2.moduleID];
 
     return module1.orientation != module2.orientation;
   }
 
   enum CRTTagger CRTGeoAlg::WhichTagger(const double &x, const double &y, const double &z, const double &buffer)
   {
-    for(auto const& [name, tagger] : fTaggers)
+    for(auto const& tagger : fTaggers)
       {
         if(x > tagger.minX - buffer &&
            x < tagger.maxX + buffer &&
@@ -540,16 +614,16 @@ namespace sbnd::crt {
            y < tagger.maxY + buffer &&
            z > tagger.minZ - buffer &&
            z < tagger.maxZ + buffer)
-          return CRTCommonUtils::GetTaggerEnum(name);
+          return tagger.tagger;
       }
     return kUndefinedTagger;
   }
 
   enum CoordSet CRTGeoAlg::GlobalConstrainedCoordinates(const uint16_t channel)
   {
-    const std::string taggerName = ChannelToTaggerName(channel);
-    const CRTTagger tagger       = CRTCommonUtils::GetTaggerEnum(taggerName);
-    const uint16_t orientation   = GetModule(channel).orientation;
+    const CRTModuleGeo &module = GetModule(channel);
+    const CRTTagger tagger     = module.tagger;
+    const uint16_t orientation = module.orientation;
 
     const CoordSet widthdir    = CRTCommonUtils::GetStripWidthGlobalCoordinate(tagger, orientation);
     const CoordSet taggercoord = CRTCommonUtils::GetTaggerDefinedCoordinate(tagger);
@@ -559,7 +633,7 @@ namespace sbnd::crt {
 
   bool CRTGeoAlg::IsPointInsideCRTLimits(const geo::Point_t &point)
   {
-    const std::vector<double> lims = CRTLimits();
+    const std::vector<double> &lims = fCRTLimits;
 
     return point.X() > lims[0] &&
            point.X() < lims[3] &&
@@ -30,6 +30,8 @@
 
 // c++
 #include <vector>
+#include <map>
+#include <limits>
 
 // ROOT
 #include "larcoreobj/SimpleTypesAndConstants/geo_vectors.h"
@@ -41,10 +43,23 @@
 namespace sbnd::crt {
 
   struct CRTSiPMGeo{
-    CRTSiPMGeo(const std::string &_stripName, const uint32_t _channel, const geo::Point_t location,
-               const uint32_t _pedestal, const double _gain)
+    CRTSiPMGeo()
+    : stripName("")
+    , stripID(std::numeric_limits<uint32_t>::max())
+    , channel(std::numeric_limits<uint16_t>::max())
+    , x(0.)
+    , y(0.)
+    , z(0.)
+    , null(true)
+    , pedestal(0)
+    , gain(0.)
+    {}
+
+    CRTSiPMGeo(const std::string &_stripName, const uint32_t _stripID, const uint32_t _channel,
+               const geo::Point_t location, const uint32_t _pedestal, const double _gain)
     {
       stripName = _stripName;
+      stripID   = _stripID;
       channel   = _channel;
       x         = location.X();
       y         = location.Y();
@@ -54,6 +69,7 @@ namespace sbnd::crt {
       null      = false;
     }
     std::string stripName;
+    uint32_t    stripID;
     uint16_t    channel;
     double      x;
     double      y;
@@ -66,11 +82,12 @@ namespace sbnd::crt {
   // CRT strip geometry struct contains dimensions and mother module
   struct CRTStripGeo{
     CRTStripGeo(const TGeoNode *stripNode, const geo::AuxDetSensitiveGeo &auxDetSensitive, 
-                const uint16_t _adsID, const std::string &_moduleName,
+                const uint16_t _adsID, const std::string &_moduleName, const uint16_t _moduleID,
                 const uint16_t _channel0, const uint16_t _channel1)
     {
       name       = stripNode->GetName();
       moduleName = _moduleName;
+      moduleID   = _moduleID;
       channel0   = _channel0;
       channel1   = _channel1;
 
@@ -102,6 +119,7 @@ namespace sbnd::crt {
     }
     std::string name;
     std::string moduleName;
+    uint16_t    moduleID;
     uint16_t    channel0;
     uint16_t    channel1;
     double      minX;
@@ -120,6 +138,8 @@ namespace sbnd::crt {
     CRTModuleGeo()
     : name("")
     , taggerName("")
+    , taggerID(std::numeric_limits<uint16_t>::max())
+    , tagger(kUndefinedTagger)
     , minX(-std::numeric_limits<double>::max())
     , maxX(std::numeric_limits<double>::max())
     , minY(-std::numeric_limits<double>::max())
@@ -137,7 +157,7 @@ namespace sbnd::crt {
     {}
 
     CRTModuleGeo(const TGeoNode *moduleNode, const geo::AuxDetGeo &auxDet,
-                 const uint16_t _adID, const std::string &_taggerName,
+                 const uint16_t _adID, const std::string &_taggerName, const uint16_t _taggerID,
                  const int32_t _t0CableDelayCorrection,
                  const int32_t _t1CableDelayCorrection,
                  const bool _invertedOrdering,
@@ -145,6 +165,8 @@ namespace sbnd::crt {
     {
       name       = moduleNode->GetName();
       taggerName = _taggerName;
+      taggerID   = _taggerID;
+      tagger     = CRTCommonUtils::GetTaggerEnum(taggerName);
 
       // Module Dimensions
       double halfWidth  = auxDet.HalfWidth1();
@@ -169,7 +191,7 @@ namespace sbnd::crt {
         orientation = (modulePosMother[2] > 0);
 
       // Location of SiPMs
-      if(CRTCommonUtils::GetTaggerEnum(taggerName) == kBottomTagger)
+      if(tagger == kBottomTagger)
         top = (orientation == 1) ? (modulePosMother[1] > 0) : (modulePosMother[0] < 0);
       else
         top = (orientation == 0) ? (modulePosMother[1] > 0) : (modulePosMother[0] < 0);
@@ -193,6 +215,8 @@ namespace sbnd::crt {
     }
     std::string   name;
     std::string   taggerName;
+    uint16_t      taggerID;
+    CRTTagger     tagger;
     double        minX;
     double        maxX;
     double        minY;
@@ -214,7 +238,8 @@ namespace sbnd::crt {
     CRTTaggerGeo(const TGeoNode *taggerNode, const TGeoNode *detNode)
     {
       // Fill name
-      name = taggerNode->GetName();
+      name   = taggerNode->GetName();
+      tagger = CRTCommonUtils::GetTaggerEnum(name);
 
       // Tagger Dimensions
       double halfWidth  = ((TGeoBBox*)taggerNode->GetVolume()->GetShape())->GetDX();
@@ -245,6 +270,7 @@ namespace sbnd::crt {
       null = false;
     }
     std::string name;
+    CRTTagger   tagger;
     double      minX;
     double      maxX;
     double      minY;
@@ -255,6 +281,11 @@ namespace sbnd::crt {
   };
 
 
+  // Taggers, modules and strips are stored contiguously, sorted by name, and
+  // addressed by the integer IDs held in the daughter structs (taggerID,
+  // moduleID, stripID).
+  // SiPMs are addressed directly by channel number. Name lookups go through
+  // a secondary index and are only meant for configuration-time use.
   class CRTGeoAlg {
   public:
 
@@ -275,29 +306,36 @@ namespace sbnd::crt {
 
     size_t NumSiPMs() const;
 
-    std::map<std::string, CRTTaggerGeo> GetTaggers() const;
+    const std::vector<CRTTaggerGeo>& GetTaggers() const;
+
+    const std::vector<CRTModuleGeo>& GetModules() const;
 
-    std::map<std::string, CRTModuleGeo> GetModules() const;
+    const std::vector<CRTStripGeo>& GetStrips() const;
 
-    std::map<std::string, CRTStripGeo> GetStrips() const;
+    // Indexed by channel, channels without a SiPM are flagged null
+    const std::vector<CRTSiPMGeo>& GetSiPMs() const;
 
-    std::map<uint16_t, CRTSiPMGeo> GetSiPMs() const;
+    const CRTTaggerGeo& GetTaggerByID(const uint16_t taggerID) const;
 
-    CRTTaggerGeo GetTagger(const std::string taggerName) const;
+    const CRTModuleGeo& GetModuleByID(const uint16_t moduleID) const;
 
-    CRTModuleGeo GetModule(const std::string moduleName) const;
+    const CRTStripGeo& GetStripByID(const uint32_t stripID) const;
 
-    CRTModuleGeo GetModule(const uint16_t channel) const;
+    const CRTTaggerGeo& GetTagger(const std::string &taggerName) const;
 
-    CRTModuleGeo GetModuleByAuxDetIndex(const unsigned ad_i) const;
+    const CRTModuleGeo& GetModule(const std::string &moduleName) const;
 
-    CRTStripGeo GetStrip(const std::string stripName) const;
+    const CRTModuleGeo& GetModule(const uint16_t channel) const;
 
-    CRTStripGeo GetStrip(const uint16_t channel) const;
+    const CRTModuleGeo& GetModuleByAuxDetIndex(const unsigned ad_i) const;
 
-    CRTStripGeo GetStripByAuxDetIndices(const unsigned ad_i, const unsigned ads_i) const;
+    const CRTStripGeo& GetStrip(const std::string &stripName) const;
 
-    CRTSiPMGeo GetSiPM(const uint16_t channel) const;
+    const CRTStripGeo& GetStrip(const uint16_t channel) const;
+
+    const CRTStripGeo& GetStripByAuxDetIndices(const unsigned ad_i, const unsigned ads_i) const;
+
+    const CRTSiPMGeo& GetSiPM(const uint16_t channel) const;
 
     std::string GetTaggerName(const std::string name) const;
 
@@ -329,6 +367,8 @@ namespace sbnd::crt {
 
     double DistanceDownStrip(const geo::Point_t position, const uint16_t channel) const;
 
+    double DistanceDownStrip(const geo::Point_t position, const CRTStripGeo &strip) const;
+
     bool CheckOverlap(const CRTStripGeo &strip1, const CRTStripGeo &strip2, const double overlap_buffer = 0.);
 
     bool CheckOverlap(const uint16_t channel1, const uint16_t channel2, const double overlap_buffer = 0.);
@@ -347,10 +387,23 @@ namespace sbnd::crt {
 
   private:
 
-    std::map<std::string, CRTTaggerGeo> fTaggers;
-    std::map<std::string, CRTModuleGeo> fModules;
-    std::map<std::string, CRTStripGeo>  fStrips;
-    std::map<uint16_t, CRTSiPMGeo>      fSiPMs;
+    std::vector<double> CalculateCRTLimits() const;
+
+    std::vector<CRTTaggerGeo> fTaggers;
+    std::vector<CRTModuleGeo> fModules;
+    std::vector<CRTStripGeo>  fStrips;
+    std::vector<CRTSiPMGeo>   fSiPMs;
+    size_t                    fNSiPMs;
+
+    std::map<std::string, uint16_t> fTaggerIndex;
+    std::map<std::string, uint16_t> fModuleIndex;
+    std::map<std::string, uint32_t> fStripIndex;
+
+    std::vector<uint16_t> fAuxDetModules;
+
+    CRTModuleGeo fNullModule;
+
+    std::vector<double> fCRTLimits;
 
     geo::GeometryCore const       *fGeometryService;
     const geo::AuxDetGeometryCore *fAuxDetGeoCore;
@@ -91,9 +91,10 @@ namespace opdet {
     double start_time,
     unsigned n_samples)
   {
-    std::vector<double> waves(n_samples, fParams.Baseline);
+    std::vector<double>& waves = fWaveBuffer;
+    waves.assign(n_samples, fParams.Baseline);
     CreatePDWaveform(simphotons, start_time, waves, pdtype,is_daphne);
-    waveform = std::vector<short unsigned int> (waves.begin(), waves.end());
+    waveform.assign(waves.begin(), waves.end());
   }
 
 
@@ -108,7 +109,8 @@ namespace opdet {
     sim::SimPhotons auxphotons;
     bool is_daphne = true; // for now ~rodrigoa
     int nCT = 1;
-    std::vector<double> wave(n_samples, fParams.Baseline);
+    std::vector<double>& wave = fWaveBuffer;
+    wave.assign(n_samples, fParams.Baseline);
         //direct light
     if(auto it{ DirectPhotonsMap.find(ch) }; it != std::end(DirectPhotonsMap) )
     {auxphotons = it->second;}
@@ -125,7 +127,7 @@ namespace opdet {
           if(timeBin < wave.size()) {
             if (!is_daphne) {AddSPE(timeBin, wave, fWaveformSP, nCT);
             }
-            else{ AddSPE(timeBin, wave, (std::vector<double>) (fWaveformSP_Daphne_HD[wvf_shift]), nCT);}
+            else{ AddSPE(timeBin, wave, fWaveformSP_Daphne_HD[wvf_shift], nCT);}
           }
         }
     }
@@ -145,7 +147,7 @@ namespace opdet {
           if(timeBin < wave.size()) {
             if (!is_daphne) {AddSPE(timeBin, wave, fWaveformSP, nCT);
             }
-            else{ AddSPE(timeBin, wave, (std::vector<double>) (fWaveformSP_Daphne_HD[wvf_shift]), nCT);}
+            else{ AddSPE(timeBin, wave, fWaveformSP_Daphne_HD[wvf_shift], nCT);}
           }
         }
     }
@@ -154,7 +156,7 @@ namespace opdet {
     else            AddDarkNoise(wave,fWaveformSP_Daphne_HD[0]);
     CreateSaturation(wave);
 
-    waveform = std::vector<short unsigned int> (wave.begin(), wave.end());
+    waveform.assign(wave.begin(), wave.end());
   }
 
 
@@ -167,14 +169,15 @@ namespace opdet {
     double start_time,
     unsigned n_samples)
   {
-    std::vector<double> waves(n_samples, fParams.Baseline);
+    std::vector<double>& waves = fWaveBuffer;
+    waves.assign(n_samples, fParams.Baseline);
     std::map<int, int> const& photonMap = litesimphotons.DetectedPhotons;
     CreatePDWaveformLite(photonMap, start_time, waves, pdtype,is_daphne);
     // std::ofstream ofs("True_PE.log",std::ofstream::out | std::ofstream::app);
     // ofs<<ch<<"\t"<<P_truth<<std::endl;
     // ofs.close();
     // P_truth=0;
-    waveform = std::vector<short unsigned int> (waves.begin(), waves.end());
+    waveform.assign(waves.begin(), waves.end());
   }
 
 
@@ -199,7 +202,7 @@ namespace opdet {
           if(timeBin < wave.size()) {
             if (!is_daphne) {AddSPE(timeBin, wave, fWaveformSP, nCT);
             }
-            else{ AddSPE(timeBin, wave, (std::vector<double>) (fWaveformSP_Daphne_HD[wvf_shift]), nCT);}
+            else{ AddSPE(timeBin, wave, fWaveformSP_Daphne_HD[wvf_shift], nCT);}
           }
         }
       }
@@ -217,7 +220,7 @@ namespace opdet {
           if(timeBin < wave.size()) {
             if (!is_daphne) {AddSPE(timeBin, wave, fWaveformSP, nCT);
             }
-            else{ AddSPE(timeBin, wave, (std::vector<double>) (fWaveformSP_Daphne_HD[wvf_shift]), nCT);
+            else{ AddSPE(timeBin, wave, fWaveformSP_Daphne_HD[wvf_shift], nCT);
             }
           }
         }
@@ -273,7 +276,8 @@ namespace opdet {
     unsigned n_samples
     )
   {
-    std::vector<double> wave(n_samples, fParams.Baseline);
+    std::vector<double>& wave = fWaveBuffer;
+    wave.assign(n_samples, fParams.Baseline);
     double meanPhotons;
     size_t acceptedPhotons;
     double tphoton;
@@ -299,7 +303,7 @@ namespace opdet {
               // P_truth=P_truth+nCT;
               if (!is_daphne) {AddSPE(timeBin, wave, fWaveformSP, nCT);
               }
-              else{ AddSPE(timeBin, wave, (std::vector<double>) (fWaveformSP_Daphne_HD[wvf_shift]), nCT);}
+              else{ AddSPE(timeBin, wave, fWaveformSP_Daphne_HD[wvf_shift], nCT);}
             }
           }
         }
@@ -324,7 +328,7 @@ namespace opdet {
               // P_truth=P_truth+nCT;
               if (!is_daphne) {AddSPE(timeBin, wave, fWaveformSP, nCT);
               }
-              else{ AddSPE(timeBin, wave, (std::vector<double>) (fWaveformSP_Daphne_HD[wvf_shift]), nCT);}
+              else{ AddSPE(timeBin, wave, fWaveformSP_Daphne_HD[wvf_shift], nCT);}
             }
           }
       }
@@ -334,7 +338,7 @@ namespace opdet {
     if(fParams.BaselineRMS > 0.0) AddLineNoise(wave);
     if(fParams.DarkNoiseRate > 0.0) AddDarkNoise(wave,fWaveformSP_Daphne_HD[0]);
     CreateSaturation(wave);
-    waveform = std::vector<short unsigned int> (wave.begin(), wave.end());
+    waveform.assign(wave.begin(), wave.end());
 
   }
 
@@ -371,7 +375,7 @@ namespace opdet {
             // P_truth=P_truth+nCT;
             if (!is_daphne) {AddSPE(timeBin, wave, fWaveformSP, nCT);
             }
-            else{ AddSPE(timeBin, wave, (std::vector<double>) (fWaveformSP_Daphne_HD[wvf_shift]), nCT);}
+            else{ AddSPE(timeBin, wave, fWaveformSP_Daphne_HD[wvf_shift], nCT);}
           }
       }
     }
@@ -408,7 +412,7 @@ namespace opdet {
             // P_truth=P_truth+nCT;
             if (!is_daphne) {AddSPE(timeBin, wave, fWaveformSP, nCT);
             }
-            else{ AddSPE(timeBin, wave, (std::vector<double>) (fWaveformSP_Daphne_HD[wvf_shift]), nCT);}
+            else{ AddSPE(timeBin, wave, fWaveformSP_Daphne_HD[wvf_shift], nCT);}
           }
       }
     }
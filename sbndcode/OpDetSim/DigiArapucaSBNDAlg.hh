@@ -139,6 +139,7 @@ namespace opdet {
     std::vector<double> fWaveformSP; //single photon pulse vector
     std::vector<double> fWaveformSP_Daphne; //single photon pulse vector
     std::vector<std::vector<double>> fWaveformSP_Daphne_HD; //single photon pulse vector
+    std::vector<double> fWaveBuffer; //auxiliary waveform, reused across channels and events
     
     std::unordered_map< raw::Channel_t, std::vector<double> > fFullWaveforms;
 
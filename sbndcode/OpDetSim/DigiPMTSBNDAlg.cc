@@ -61,6 +61,10 @@ namespace opdet {
       fPMTHDOpticalWaveformsPtr->produceSER_HD(fSinglePEWave_HD,fSinglePEWave);
 
       pulsesize = fSinglePEWave_HD[0].size();
+
+      // single precision copy of the SER templates for the float accumulation mode
+      for(auto const& ser : fSinglePEWave_HD)
+        fSinglePEWaveF_HD.emplace_back(ser.begin(), ser.end());
       mf::LogDebug("DigiPMTSBNDAlg")<<"HD wvfs size: "<<pulsesize;
     }
     else {
@@ -98,6 +102,50 @@ namespace opdet {
   DigiPMTSBNDAlg::~DigiPMTSBNDAlg(){}
 
 
+  template<typename Create>
+  void DigiPMTSBNDAlg::FillWaveform(
+    std::vector<short unsigned int>& waveform,
+    unsigned n_sample,
+    Create create)
+  {
+    // the signal is accumulated on top of the baseline, in single or double
+    // precision; the double path keeps the summation order of the former
+    // std::vector<double> buffer, so its ADC output is unchanged
+    if(fParams.PMTFloatAccumulation){
+      fWaveBufferF.assign(n_sample, static_cast<float>(fParams.PMTBaseline));
+      create(fWaveBufferF);
+      Digitize(fWaveBufferF, waveform);
+    }
+    else{
+      fWaveBuffer.assign(n_sample, fParams.PMTBaseline);
+      create(fWaveBuffer);
+      Digitize(fWaveBuffer, waveform);
+    }
+  }
+
+
+  template<typename Sample_t>
+  void DigiPMTSBNDAlg::Digitize(
+    std::vector<Sample_t> const& wave,
+    std::vector<short unsigned int>& waveform) const
+  {
+    // single pass: clamp at the ADC saturation and convert (truncating,
+    // as the former std::vector conversion did) straight into the output buffer
+    waveform.resize(wave.size());
+    const Sample_t saturation = fADCSaturation;
+    if(fPositivePolarity){
+      for(size_t i=0; i<wave.size(); i++){
+        waveform[i] = static_cast<short unsigned int>(wave[i] > saturation ? saturation : wave[i]);
+      }
+    }
+    else{
+      for(size_t i=0; i<wave.size(); i++){
+        waveform[i] = static_cast<short unsigned int>(wave[i] < saturation ? saturation : wave[i]);
+      }
+    }
+  }
+
+
   void DigiPMTSBNDAlg::ConstructWaveformUncoatedPMT(
     int ch,
     sim::SimPhotons const& simphotons,
@@ -106,9 +154,8 @@ namespace opdet {
     double start_time,
     unsigned n_sample)
   {
-    std::vector<double> waves(n_sample, fParams.PMTBaseline);
-    CreatePDWaveformUncoatedPMT(simphotons, start_time, waves, ch, pdtype);
-    waveform = std::vector<short unsigned int> (waves.begin(), waves.end());
+    FillWaveform(waveform, n_sample,
+                 [&](auto& wave) { CreatePDWaveformUncoatedPMT(simphotons, start_time, wave, ch, pdtype); });
   }
 
 
@@ -120,9 +167,8 @@ namespace opdet {
     double start_time,
     unsigned n_sample)
   {
-    std::vector<double> waves(n_sample, fParams.PMTBaseline);
-    CreatePDWaveformCoatedPMT(ch, start_time, waves, DirectPhotonsMap, ReflectedPhotonsMap);
-    waveform = std::vector<short unsigned int> (waves.begin(), waves.end());
+    FillWaveform(waveform, n_sample,
+                 [&](auto& wave) { CreatePDWaveformCoatedPMT(ch, start_time, wave, DirectPhotonsMap, ReflectedPhotonsMap); });
   }
 
 
@@ -134,9 +180,8 @@ namespace opdet {
     double start_time,
     unsigned n_sample)
   {
-    std::vector<double> waves(n_sample, fParams.PMTBaseline);
-    CreatePDWaveformLiteUncoatedPMT(litesimphotons, start_time, waves, ch, pdtype);
-    waveform = std::vector<short unsigned int> (waves.begin(), waves.end());
+    FillWaveform(waveform, n_sample,
+                 [&](auto& wave) { CreatePDWaveformLiteUncoatedPMT(litesimphotons, start_time, wave, ch, pdtype); });
   }
 
 
@@ -148,16 +193,16 @@ namespace opdet {
     double start_time,
     unsigned n_sample)
   {
-    std::vector<double> waves(n_sample, fParams.PMTBaseline);
-    CreatePDWaveformLiteCoatedPMT(ch, start_time, waves, DirectPhotonsMap, ReflectedPhotonsMap);
-    waveform = std::vector<short unsigned int> (waves.begin(), waves.end());
+    FillWaveform(waveform, n_sample,
+                 [&](auto& wave) { CreatePDWaveformLiteCoatedPMT(ch, start_time, wave, DirectPhotonsMap, ReflectedPhotonsMap); });
   }
 
 
+  template<typename Sample_t>
   void DigiPMTSBNDAlg::CreatePDWaveformUncoatedPMT(
     sim::SimPhotons const& simphotons,
     double t_min,
-    std::vector<double>& wave,
+    std::vector<Sample_t>& wave,
     int ch,
     std::string pdtype)
   {
@@ -168,7 +213,8 @@ namespace opdet {
     // we want to keep the 1 ns SimPhotonLite resolution
     // digitizer sampling period is 2 ns
     // create a PE accumulator vector with size x2 the waveform size
-    std::vector<unsigned int> nPE_v( (size_t) fSamplingPeriod*wave.size(), 0);
+    std::vector<unsigned int>& nPE_v = fPEBuffer;
+    nPE_v.assign( (size_t) fSamplingPeriod*wave.size(), 0);
 
     for(size_t i = 0; i < simphotons.size(); i++) { //simphotons is here reflected light. To be added for all PMTs
       if(fFlatGen.fire(1.0) < fPMTUncoatedEff) {
@@ -183,27 +229,18 @@ namespace opdet {
       }
     }
 
-    for(size_t t=0; t<nPE_v.size(); t++){
-      if(nPE_v[t] > 0) {
-        if(fParams.SimulateNonLinearity){
-          AddSPE(t, wave, fPMTNonLinearityPtr->NObservedPE(t, nPE_v) );
-        }
-        else{
-          AddSPE(t, wave, nPE_v[t]);
-        }
-      }
-    }
+    AddPhotoelectrons(nPE_v, wave);
 
     if(fParams.PMTBaselineRMS > 0.0) AddLineNoise(wave);
     if(fParams.PMTDarkNoiseRate > 0.0) AddDarkNoise(wave);
-    CreateSaturation(wave);
   }
 
 
+  template<typename Sample_t>
   void DigiPMTSBNDAlg::CreatePDWaveformCoatedPMT(
     int ch,
     double t_min,
-    std::vector<double>& wave,
+    std::vector<Sample_t>& wave,
     std::unordered_map<int, sim::SimPhotons>& DirectPhotonsMap,
     std::unordered_map<int, sim::SimPhotons>& ReflectedPhotonsMap)
   {
@@ -216,7 +253,8 @@ namespace opdet {
     // we want to keep the 1 ns SimPhotonLite resolution
     // digitizer sampling period is 2 ns
     // create a PE accumulator vector with size x2 the waveform size
-    std::vector<unsigned int> nPE_v( (size_t) fSamplingPeriod*wave.size(), 0);
+    std::vector<unsigned int>& nPE_v = fPEBuffer;
+    nPE_v.assign( (size_t) fSamplingPeriod*wave.size(), 0);
 
     //direct light
     if(auto it{ DirectPhotonsMap.find(ch) }; it != std::end(DirectPhotonsMap) )
@@ -250,28 +288,19 @@ namespace opdet {
       }
     }
 
-    for(size_t t=0; t<nPE_v.size(); t++){
-      if(nPE_v[t] > 0) {
-        if(fParams.SimulateNonLinearity){
-          AddSPE(t, wave, fPMTNonLinearityPtr->NObservedPE(t, nPE_v) );
-        }
-        else{
-          AddSPE(t, wave, nPE_v[t]);
-        }
-      }
-    }
+    AddPhotoelectrons(nPE_v, wave);
 
-    //Adding noise and saturation
+    //Adding noise (saturation is applied when digitizing)
     if(fParams.PMTBaselineRMS > 0.0) AddLineNoise(wave);
     if(fParams.PMTDarkNoiseRate > 0.0) AddDarkNoise(wave);
-    CreateSaturation(wave);
   }
 
 
+  template<typename Sample_t>
   void DigiPMTSBNDAlg::CreatePDWaveformLiteUncoatedPMT(
     sim::SimPhotonsLite const& litesimphotons,
     double t_min,
-    std::vector<double>& wave,
+    std::vector<Sample_t>& wave,
     int ch,
     std::string pdtype)
   {
@@ -284,7 +313,8 @@ namespace opdet {
     // we want to keep the 1 ns SimPhotonLite resolution
     // digitizer sampling period is 2 ns
     // create a PE accumulator vector with size x2 the waveform size
-    std::vector<unsigned int> nPE_v( (size_t) fSamplingPeriod*wave.size(), 0);
+    std::vector<unsigned int>& nPE_v = fPEBuffer;
+    nPE_v.assign( (size_t) fSamplingPeriod*wave.size(), 0);
 
     // here litesimphotons corresponds only to reflected light
     std::map<int, int> const& photonMap = litesimphotons.DetectedPhotons;
@@ -305,27 +335,18 @@ namespace opdet {
       }
     }
 
-    for(size_t t=0; t<nPE_v.size(); t++){
-      if(nPE_v[t] > 0) {
-        if(fParams.SimulateNonLinearity){
-          AddSPE(t, wave, fPMTNonLinearityPtr->NObservedPE(t, nPE_v) );
-        }
-        else{
-          AddSPE(t, wave, nPE_v[t]);
-        }
-      }
-    }
+    AddPhotoelectrons(nPE_v, wave);
     
     if(fParams.PMTBaselineRMS > 0.0) AddLineNoise(wave);
     if(fParams.PMTDarkNoiseRate > 0.0) AddDarkNoise(wave);
-    CreateSaturation(wave);
   }
 
 
+  template<typename Sample_t>
   void DigiPMTSBNDAlg::CreatePDWaveformLiteCoatedPMT(
     int ch,
     double t_min,
-    std::vector<double>& wave,
+    std::vector<Sample_t>& wave,
     std::unordered_map<int, sim::SimPhotonsLite>& DirectPhotonsMap,
     std::unordered_map<int, sim::SimPhotonsLite>& ReflectedPhotonsMap)
   {
@@ -339,7 +360,8 @@ namespace opdet {
     // we want to keep the 1 ns SimPhotonLite resolution
     // digitizer sampling period is 2 ns
     // create a PE accumulator vector with size x2 the waveform size
-    std::vector<unsigned int> nPE_v( (size_t) fSamplingPeriod*wave.size(), 0);
+    std::vector<unsigned int>& nPE_v = fPEBuffer;
+    nPE_v.assign( (size_t) fSamplingPeriod*wave.size(), 0);
 
     // direct light
     if ( auto it{ DirectPhotonsMap.find(ch) }; it != std::end(DirectPhotonsMap) ){
@@ -381,21 +403,11 @@ namespace opdet {
       }
     }
     
-    for(size_t t=0; t<nPE_v.size(); t++){
-      if(nPE_v[t] > 0) {
-        if(fParams.SimulateNonLinearity){
-          AddSPE(t, wave, fPMTNonLinearityPtr->NObservedPE(t, nPE_v) );
-        }
-        else{
-          AddSPE(t, wave, nPE_v[t]);
-        }
-      }
-    }
+    AddPhotoelectrons(nPE_v, wave);
 
-    //Adding noise and saturation
+    //Adding noise (saturation is applied when digitizing)
     if(fParams.PMTBaselineRMS > 0.0) AddLineNoise(wave);
     if(fParams.PMTDarkNoiseRate > 0.0) AddDarkNoise(wave);
-    CreateSaturation(wave);
   }
 
 
@@ -424,7 +436,8 @@ namespace opdet {
   }
 
 
-  void DigiPMTSBNDAlg::AddSPE(size_t time, std::vector<double>& wave, double npe)
+  template<typename Sample_t>
+  void DigiPMTSBNDAlg::AddSPE(size_t time, std::vector<Sample_t>& wave, double npe)
   {
     // time bin HD (double precision)
     // used to gert the time-shifted SER
@@ -442,25 +455,37 @@ namespace opdet {
     if(fParams.MakeGainFluctuations)
       npe_anode=fPMTGainFluctuationsPtr->GainFluctuation(npe, fEngine);
 
-    // add SER to the waveform
+    // add SER to the waveform, using the SER template of the same precision
+    auto const& ser = [&]() -> auto const& {
+      if constexpr (std::is_same_v<Sample_t, float>) return fSinglePEWaveF_HD[wvf_shift];
+      else return fSinglePEWave_HD[wvf_shift];
+    }();
     std::transform(min_it, max_it,
-                     fSinglePEWave_HD[wvf_shift].begin(), min_it,
-                     [npe_anode](auto a, auto b) { return a+npe_anode*b; });
+                     ser.begin(), min_it,
+                     [npe_anode](Sample_t a, Sample_t b) -> Sample_t { return a+npe_anode*b; });
   }
 
 
-  void DigiPMTSBNDAlg::CreateSaturation(std::vector<double>& wave)
+  template<typename Sample_t>
+  void DigiPMTSBNDAlg::AddPhotoelectrons(std::vector<unsigned int> const& nPE_v, std::vector<Sample_t>& wave)
   {
-    if(fPositivePolarity)
-      std::replace_if(wave.begin(), wave.end(),
-                      [&](auto w){return w > fADCSaturation;}, fADCSaturation);
-    else
-      std::replace_if(wave.begin(), wave.end(),
-                        [&](auto w){return w < fADCSaturation;}, fADCSaturation);
+    if(fParams.SimulateNonLinearity){
+      // rescale the whole PE vector in one go
+      fPMTNonLinearityPtr->NObservedPE(nPE_v, fObservedPE_v);
+      for(size_t t=0; t<nPE_v.size(); t++){
+        if(nPE_v[t] > 0) AddSPE(t, wave, fObservedPE_v[t]);
+      }
+    }
+    else{
+      for(size_t t=0; t<nPE_v.size(); t++){
+        if(nPE_v[t] > 0) AddSPE(t, wave, nPE_v[t]);
+      }
+    }
   }
 
 
-  void DigiPMTSBNDAlg::AddLineNoise(std::vector<double>& wave)
+  template<typename Sample_t>
+  void DigiPMTSBNDAlg::AddLineNoise(std::vector<Sample_t>& wave)
   {
     // TODO: after running the profiler I can see that this is where
     // most cycles are being used.  Potentially some improvement could
@@ -476,12 +501,13 @@ namespace opdet {
     // delete array;
     //
     std::transform(wave.begin(), wave.end(), wave.begin(),
-                   [this](double w) -> double {
+                   [this](Sample_t w) -> Sample_t {
                      return w + fGaussQGen.fire(0., fParams.PMTBaselineRMS) ; });
   }
 
 
-  void DigiPMTSBNDAlg::AddDarkNoise(std::vector<double>& wave)
+  template<typename Sample_t>
+  void DigiPMTSBNDAlg::AddDarkNoise(std::vector<Sample_t>& wave)
   {
     double timeBin;
     // Multiply by 10^9 since fParams.DarkNoiseRate is in Hz (conversion from s to ns)
@@ -588,6 +614,7 @@ namespace opdet {
     fBaseConfig.TTS                      = config.tts();
     fBaseConfig.CableTime                = config.cableTime();
     fBaseConfig.PMTDataFile              = config.pmtDataFile();
+    fBaseConfig.PMTFloatAccumulation     = config.pmtFloatAccumulation();
     fBaseConfig.MakeGainFluctuations = config.gainFluctuationsParams.get_if_present(fBaseConfig.GainFluctuationsParams);
     fBaseConfig.SimulateNonLinearity = config.nonLinearityParams.get_if_present(fBaseConfig.NonLinearityParams);
     config.hdOpticalWaveformParams.get_if_present(fBaseConfig.HDOpticalWaveformParams);
@@ -27,6 +27,7 @@
 #include <vector>
 #include <cmath>
 #include <string>
+#include <type_traits>
 #include <map>
 #include <unordered_map>
 #include <set>
@@ -67,6 +68,7 @@ namespace opdet {
       double PMTUncoatedEff; //PMT (uncoated) efficiency
       std::string PMTDataFile; //File containing timing emission structure for TPB, and single PE profile from data
       bool PMTSinglePEmodel; //Model for single pe response, false for ideal, true for test bench meas
+      bool PMTFloatAccumulation; //Accumulate the waveform in single (true) or double (false) precision
       bool MakeGainFluctuations; //Fluctuate PMT gain
       fhicl::ParameterSet GainFluctuationsParams;
       bool SimulateNonLinearity; //Fluctuate PMT gain
@@ -152,43 +154,63 @@ namespace opdet {
 
     //PMTNonLinearity
     std::unique_ptr<opdet::PMTNonLinearity> fPMTNonLinearityPtr;
+    std::vector<double> fObservedPE_v; // rescaled #PE per 1 ns bin, reused across channels
 
-    void AddSPE(size_t time, std::vector<double>& wave, double npe = 1); // add single pulse to auxiliary waveform
+    template<typename Sample_t>
+    void AddSPE(size_t time, std::vector<Sample_t>& wave, double npe = 1); // add single pulse to auxiliary waveform
+    template<typename Sample_t>
+    void AddPhotoelectrons(std::vector<unsigned int> const& nPE_v, std::vector<Sample_t>& wave); // add all the PE of the 1 ns PE vector
     void Pulse1PE(std::vector<double>& wave);
     double Transittimespread(double fwhm);
 
     std::vector<double> fSinglePEWave; // single photon pulse vector
     std::vector<std::vector<double>> fSinglePEWave_HD; // single photon pulse vector
+    std::vector<std::vector<float>> fSinglePEWaveF_HD; // single photon pulse vector, single precision
     int pulsesize; //size of 1PE waveform
+    std::vector<double> fWaveBuffer; // auxiliary waveform, reused across channels and events
+    std::vector<float> fWaveBufferF; // auxiliary waveform for the float accumulation mode
+    std::vector<unsigned int> fPEBuffer; // 1 ns PE accumulator, reused across channels and events
     std::unordered_map< raw::Channel_t, std::vector<double> > fFullWaveforms;
 
+    template<typename Sample_t>
     void CreatePDWaveformUncoatedPMT(
       sim::SimPhotons const& SimPhotons,
       double t_min,
-      std::vector<double>& wave,
+      std::vector<Sample_t>& wave,
       int ch,
       std::string pdtype);
+    template<typename Sample_t>
     void CreatePDWaveformCoatedPMT(
       int ch,
       double t_min,
-      std::vector<double>& wave,
+      std::vector<Sample_t>& wave,
       std::unordered_map<int, sim::SimPhotons>& DirectPhotonsMap,
       std::unordered_map<int, sim::SimPhotons>& ReflectedPhotonsMap);
+    template<typename Sample_t>
     void CreatePDWaveformLiteUncoatedPMT(
       sim::SimPhotonsLite const& litesimphotons,
       double t_min,
-      std::vector<double>& wave,
+      std::vector<Sample_t>& wave,
       int ch,
       std::string pdtype);
+    template<typename Sample_t>
     void CreatePDWaveformLiteCoatedPMT(
       int ch,
       double t_min,
-      std::vector<double>& wave,
+      std::vector<Sample_t>& wave,
       std::unordered_map<int, sim::SimPhotonsLite>& DirectPhotonsMap,
       std::unordered_map<int, sim::SimPhotonsLite>& ReflectedPhotonsMap);
-    void CreateSaturation(std::vector<double>& wave);//Including saturation effects (dynamic range)
-    void AddLineNoise(std::vector<double>& wave); //add noise to baseline
-    void AddDarkNoise(std::vector<double>& wave); //add dark noise
+    template<typename Sample_t>
+    void AddLineNoise(std::vector<Sample_t>& wave); //add noise to baseline
+    template<typename Sample_t>
+    void AddDarkNoise(std::vector<Sample_t>& wave); //add dark noise
+
+    // Runs create on the auxiliary waveform, initialised to the baseline, and digitizes it into waveform
+    template<typename Create>
+    void FillWaveform(std::vector<short unsigned int>& waveform, unsigned n_sample, Create create);
+    // Applies saturation (dynamic range) and converts to ADC in one pass
+    template<typename Sample_t>
+    void Digitize(std::vector<Sample_t> const& wave, std::vector<short unsigned int>& waveform) const;
     double FindMinimumTime(
       sim::SimPhotons const&,
       int ch,
@@ -283,6 +305,12 @@ namespace opdet {
         Comment("Model used for single PE response of PMT. =0 is ideal, =1 is testbench")
       };
 
+      fhicl::Atom<bool> pmtFloatAccumulation {
+        Name("PMTFloatAccumulation"),
+        Comment("Accumulate the PMT waveform in single instead of double precision"),
+        false
+      };
+
       fhicl::Atom<std::string> pmtDataFile {
         Name("PMTDataFile"),
         Comment("File containing timing emission distribution for TPB and single pe pulse from data")
@@ -7,7 +7,7 @@
 #ifndef SBND_PMTNonLinearity_H
 #define SBND_PMTNonLinearity_H
 
-
+#include <vector>
 
 namespace opdet {
   class PMTNonLinearity;
@@ -21,6 +21,16 @@ public:
 
   //Returns rescaled number of PE
   virtual double NObservedPE(size_t bin, std::vector<unsigned int> & pe_vector) = 0;
+
+  //Fills the rescaled number of PE for every bin of pe_vector
+  //Default implementation calls NObservedPE bin by bin
+  virtual void NObservedPE(std::vector<unsigned int> const& pe_vector, std::vector<double> & observed_pe){
+    std::vector<unsigned int> pe_copy(pe_vector);
+    observed_pe.assign(pe_vector.size(), 0.);
+    for(size_t bin=0; bin<pe_vector.size(); bin++){
+      if(pe_vector[bin]>0) observed_pe[bin] = NObservedPE(bin, pe_copy);
+    }
+  }
 };
 
 #endif
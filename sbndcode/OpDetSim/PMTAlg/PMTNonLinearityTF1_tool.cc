@@ -58,6 +58,10 @@ public:
   //Returns rescaled #pe after non linearity
   double NObservedPE(size_t bin, std::vector<unsigned int> & pe_vector) override;
 
+  //Fills rescaled #pe for the whole PE vector, keeping the
+  //occupancy window as a running sum (linear in the vector size)
+  void NObservedPE(std::vector<unsigned int> const& pe_vector, std::vector<double> & observed_pe) override;
+
 private:
   //Configuration parameters
   std::string fAttenuationForm;
@@ -65,12 +69,16 @@ private:
   unsigned int fAttenuationPreTime;
   std::vector<unsigned int> fNonLinearRange;
 
-  //TF1 for non linearity function
-  TF1 *fNonLinearTF1;
-
-  // Vector to store non linearity attenuation values
+  // Non linearity attenuation values tabulated from the TF1 for every
+  // integer #PE in the window, [0, NonLinearRange[1])
   std::vector<double> fPEAttenuation_V;
   int fPESaturationValue;
+
+  //Rescaled #pe given the #pe in the bin and in its occupancy window
+  double ObservedPE(unsigned int npe, unsigned int npe_acc) const {
+    if(npe_acc<fNonLinearRange[1]) return npe*fPEAttenuation_V[npe_acc];
+    else return fPESaturationValue;
+  }
 };
 
 
@@ -80,30 +88,44 @@ opdet::PMTNonLinearityTF1::PMTNonLinearityTF1(art::ToolConfigTable<Config> const
   , fAttenuationPreTime { config().attenuationPreTime() }
   , fNonLinearRange { config().nonLinearRange() }
 {
-  fNonLinearTF1 = new TF1("NonLinearTF1", fAttenuationForm.c_str());
+  // The window #PE is an integer, so the response only needs to be known
+  // at integer values: tabulate it once and drop the TF1
+  TF1 nonLinearTF1("NonLinearTF1", fAttenuationForm.c_str());
   for(size_t k=0; k<fAttenuationFormParams.size(); k++){
-    fNonLinearTF1->SetParameter(k, fAttenuationFormParams[k]);
+    nonLinearTF1.SetParameter(k, fAttenuationFormParams[k]);
   }
 
   // Initialize attenuation vector
   fPEAttenuation_V.resize(fNonLinearRange[1], 1);
   for(size_t pe=fNonLinearRange[0]; pe<fNonLinearRange[1]; pe++){
-    fPEAttenuation_V[pe] = fNonLinearTF1->Eval(pe)/pe;
+    fPEAttenuation_V[pe] = nonLinearTF1.Eval(pe)/pe;
   }
-  fPESaturationValue = fNonLinearTF1->Eval(fNonLinearRange[1]);
+  fPESaturationValue = nonLinearTF1.Eval(fNonLinearRange[1]);
 
 }
 
 double opdet::PMTNonLinearityTF1::NObservedPE(size_t bin, std::vector<unsigned int> & pe_vector){
 
   // get first bin
-  size_t start_bin = bin-fAttenuationPreTime;
-  
-  if(fAttenuationPreTime<0) start_bin=0;
-  unsigned int npe_acc = std::accumulate(pe_vector.begin()+start_bin,pe_vector.begin()+bin+1, 0);
+  size_t start_bin = bin>fAttenuationPreTime ? bin-fAttenuationPreTime : 0;
+
+  unsigned int npe_acc = std::accumulate(pe_vector.begin()+start_bin,pe_vector.begin()+bin+1, 0u);
 
-  if(npe_acc<fNonLinearRange[1]) return pe_vector[bin]*fPEAttenuation_V[npe_acc];
-  else return fPESaturationValue;
+  return ObservedPE(pe_vector[bin], npe_acc);
+}
+
+void opdet::PMTNonLinearityTF1::NObservedPE(std::vector<unsigned int> const& pe_vector, std::vector<double> & observed_pe){
+
+  observed_pe.assign(pe_vector.size(), 0.);
+
+  // #PE in [bin-fAttenuationPreTime, bin]
+  unsigned int npe_acc = 0;
+  for(size_t bin=0; bin<pe_vector.size(); bin++){
+    npe_acc += pe_vector[bin];
+    if(bin>fAttenuationPreTime) npe_acc -= pe_vector[bin-fAttenuationPreTime-1];
+
+    if(pe_vector[bin]>0) observed_pe[bin] = ObservedPE(pe_vector[bin], npe_acc);
+  }
 }
 
 
@@ -136,6 +136,9 @@ namespace opdet {
     // Required functions.
     void produce(art::Event & e) override;
 
+    // Build the digitizers of every worker once per job
+    void beginJob() override;
+
     opdet::sbndPDMapAlg map; //map for photon detector types
     unsigned int nChannels = map.size();
     std::vector<raw::OpDetWaveform> fWaveforms; // holder for un-triggered waveforms
@@ -262,14 +265,25 @@ namespace opdet {
 
   }
 
+  void opDetDigitizerSBND::beginJob()
+  {
+    auto const clockData = art::ServiceHandle<detinfo::DetectorClocksService const>()->DataForJob();
+    for (auto &worker : fWorkers) worker.InitializeDigitizers(clockData);
+  }
+
   void opDetDigitizerSBND::produce(art::Event & e)
   {
     std::unique_ptr< std::vector< raw::OpDetWaveform > > pulseVecPtr(std::make_unique< std::vector< raw::OpDetWaveform > > ());
     // Implementation of required member function here.
     mf::LogInfo("opDetDigitizer") << "Event: " << e.id().event() << std::endl;
 
-    // setup the waveforms
-    fWaveforms = std::vector<raw::OpDetWaveform> (nChannels);
+    // setup the waveforms: keep the buffers of the previous event,
+    // flagging every channel as empty ("NULL" channel number)
+    fWaveforms.resize(nChannels);
+    for (raw::OpDetWaveform &waveform : fWaveforms) {
+      waveform.clear();
+      waveform.SetChannelNumber(std::numeric_limits<raw::Channel_t>::max());
+    }
 
     auto const clockData = art::ServiceHandle<detinfo::DetectorClocksService const>()->DataFor(e);
     auto const detProp = art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataFor(e, clockData);
@@ -320,7 +334,7 @@ namespace opdet {
       }
       // clean up the vector
       for (unsigned i = 0; i < fTriggeredWaveforms.size(); i++) {
-        fTriggeredWaveforms[i] = std::vector<raw::OpDetWaveform>();
+        fTriggeredWaveforms[i].clear();
       }
 
       // put the waveforms in the event
@@ -331,18 +345,15 @@ namespace opdet {
     }
     else {
       // put the full waveforms in the event
-      for (const raw::OpDetWaveform &waveform : fWaveforms) {
+      for (raw::OpDetWaveform &waveform : fWaveforms) {
         if (waveform.ChannelNumber() == std::numeric_limits<raw::Channel_t>::max() /* "NULL" value*/) {
           continue;
         }
-        pulseVecPtr->push_back(waveform);
+        pulseVecPtr->push_back(std::move(waveform));
       }
       e.put(std::move(pulseVecPtr));
     }
 
-    // clear out the full waveforms
-    fWaveforms.clear();
-
   }//produce end
 
   DEFINE_ART_MODULE(opdet::opDetDigitizerSBND)
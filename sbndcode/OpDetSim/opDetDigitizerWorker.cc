@@ -15,7 +15,8 @@ opdet::opDetDigitizerWorker::opDetDigitizerWorker(unsigned no,
   fConfig(config),
   fThreadNo(no),
   fEngine(Engine),
-  fTriggerAlg(trigger_alg)
+  fTriggerAlg(trigger_alg),
+  fDigitizerFrequency(0.)
 {}
 
 void opdet::opDetDigitizerWorkerThread(const opdet::opDetDigitizerWorker &worker,
@@ -87,21 +88,47 @@ unsigned opdet::opDetDigitizerWorker::StartChannelToProcess(unsigned n) const
   return n_per_job * fThreadNo + leftover;
 }
 
-void opdet::opDetDigitizerWorker::Start(detinfo::DetectorClocksData const& clockData) const
+void opdet::opDetDigitizerWorker::InitializeDigitizers(detinfo::DetectorClocksData const& clockData)
+{
+  ResetDigitizers(clockData);
+}
+
+void opdet::opDetDigitizerWorker::ResetDigitizers(detinfo::DetectorClocksData const& clockData) const
 {
-  auto arapucaDigitizer = fConfig.makeArapucaDigi(
-                            *(lar::providerFrom<detinfo::LArPropertiesService>()),
-                            clockData,
-                            fEngine
-                          );
+  // the digitizers only depend on the event through the optical clock:
+  // (re)build them only the first time and if that ever changes
+  const double frequency = clockData.OpticalClock().Frequency();
+  if (fPMTDigitizer && fArapucaDigitizer && frequency == fDigitizerFrequency) return;
 
-  auto pmtDigitizer = fConfig.makePMTDigi(
+  fArapucaDigitizer = fConfig.makeArapucaDigi(
                         *(lar::providerFrom<detinfo::LArPropertiesService>()),
                         clockData,
                         fEngine
                       );
-  MakeWaveforms(pmtDigitizer.get(), arapucaDigitizer.get());
 
+  fPMTDigitizer = fConfig.makePMTDigi(
+                    *(lar::providerFrom<detinfo::LArPropertiesService>()),
+                    clockData,
+                    fEngine
+                  );
+  fDigitizerFrequency = frequency;
+  fWaveformBuffer.reserve(std::max(fConfig.Nsamples, fConfig.Nsamples_Daphne));
+}
+
+void opdet::opDetDigitizerWorker::Start(detinfo::DetectorClocksData const& clockData) const
+{
+  ResetDigitizers(clockData);
+  MakeWaveforms(fPMTDigitizer.get(), fArapucaDigitizer.get());
+}
+
+void opdet::opDetDigitizerWorker::StoreWaveform(unsigned ch, std::vector<short unsigned int> const& waveform) const
+{
+  // fill the pooled waveform in place, keeping its allocation
+  // including pre trigger window and transit time
+  raw::OpDetWaveform &wvf = fWaveforms->at(ch);
+  wvf.SetTimeStamp(fConfig.EnableWindow[0]);
+  wvf.SetChannelNumber(ch);
+  wvf.assign(waveform.begin(), waveform.end());
 }
 
 opdet::opDetDigitizerWorker::~opDetDigitizerWorker()
@@ -192,8 +219,7 @@ void opdet::opDetDigitizerWorker::MakeWaveforms(opdet::DigiPMTSBNDAlg *pmtDigiti
 
         auto const& litesimphotons = simphotons_map.second;
 
-        std::vector<short unsigned int> waveform;
-        waveform.reserve(fConfig.Nsamples);
+        std::vector<short unsigned int> &waveform = fWaveformBuffer;
         const unsigned ch = litesimphotons.OpChannel;
         const std::string pdtype = fConfig.pdsMap.pdType(ch);
 
@@ -224,10 +250,7 @@ void opdet::opDetDigitizerWorker::MakeWaveforms(opdet::DigiPMTSBNDAlg *pmtDigiti
                                               pdtype,
                                               startTime,
                                               fConfig.Nsamples);
-          // including pre trigger window and transit time
-          fWaveforms->at(ch) = raw::OpDetWaveform(fConfig.EnableWindow[0],
-                                                  (unsigned int)ch,
-                                                  waveform);
+          StoreWaveform(ch, waveform);
       	}
         // getting only xarapuca channels with appropriate type of light
         else if( (pdtype == "xarapuca_vis" && Reflected) ) {
@@ -240,10 +263,7 @@ void opdet::opDetDigitizerWorker::MakeWaveforms(opdet::DigiPMTSBNDAlg *pmtDigiti
                                                   is_daphne,
                                                   startTime,
                                                   fConfig.Nsamples_Daphne);
-            // including pre trigger window and transit time
-            fWaveforms->at(ch) = raw::OpDetWaveform(fConfig.EnableWindow[0],
-                                                  (unsigned int)ch,
-                                                  waveform);
+            StoreWaveform(ch, waveform);
             }
             else{
             arapucaDigitizer->ConstructWaveformLite(ch,
@@ -253,10 +273,7 @@ void opdet::opDetDigitizerWorker::MakeWaveforms(opdet::DigiPMTSBNDAlg *pmtDigiti
                                                   is_daphne,
                                                   startTime,
                                                   fConfig.Nsamples);
-            // including pre trigger window and transit time
-            fWaveforms->at(ch) = raw::OpDetWaveform(fConfig.EnableWindow[0],
-                                                  (unsigned int)ch,
-                                                  waveform);
+            StoreWaveform(ch, waveform);
           }
         }
       }
@@ -264,21 +281,15 @@ void opdet::opDetDigitizerWorker::MakeWaveforms(opdet::DigiPMTSBNDAlg *pmtDigiti
 
     //Constructing Waveforms for hybrid OpChannels (coated pmts)
     for(auto ch : coatedpmts_todigitize){
-      std::vector<short unsigned int> waveform;
-      waveform.reserve(fConfig.Nsamples);
+      std::vector<short unsigned int> &waveform = fWaveformBuffer;
       pmtDigitizer->ConstructWaveformLiteCoatedPMT(ch, waveform, DirectPhotonsMap, ReflectedPhotonsMap, startTime, fConfig.Nsamples);
-      fWaveforms->at(ch) = raw::OpDetWaveform(fConfig.EnableWindow[0],
-                                              (unsigned int)ch,
-                                              waveform);
+      StoreWaveform(ch, waveform);
     }
     //VUV XAs, sensible to VUV and visible light
     for(auto ch : vuvxarapucas_todigitize){
-      std::vector<short unsigned int> waveform;
-      waveform.reserve(fConfig.Nsamples_Daphne);
+      std::vector<short unsigned int> &waveform = fWaveformBuffer;
       arapucaDigitizer->ConstructWaveformLiteVUVXA(ch, waveform, XADirectPhotonsMap, XAReflectedPhotonsMap, startTime, fConfig.Nsamples_Daphne);
-      fWaveforms->at(ch) = raw::OpDetWaveform(fConfig.EnableWindow[0],
-                                              (unsigned int)ch,
-                                              waveform);
+      StoreWaveform(ch, waveform);
     }
   }
   else { // for SimPhotons
@@ -331,7 +342,7 @@ void opdet::opDetDigitizerWorker::MakeWaveforms(opdet::DigiPMTSBNDAlg *pmtDigiti
 
         auto const& simphotons = simphotons_map.second;
 
-        std::vector<short unsigned int> waveform;
+        std::vector<short unsigned int> &waveform = fWaveformBuffer;
         const unsigned ch = simphotons.OpChannel();
         const std::string pdtype = fConfig.pdsMap.pdType(ch);
         const bool is_daphne = fConfig.pdsMap.isElectronics(ch,"daphne");
@@ -354,10 +365,7 @@ void opdet::opDetDigitizerWorker::MakeWaveforms(opdet::DigiPMTSBNDAlg *pmtDigiti
                                           pdtype,
                                           startTime,
                                           fConfig.Nsamples);
-          // including pre trigger window and transit time
-          fWaveforms->at(ch) = raw::OpDetWaveform(fConfig.EnableWindow[0],
-                                                  (unsigned int)ch,
-                                                  waveform);
+          StoreWaveform(ch, waveform);
         }
         if( pdtype == "xarapuca_vuv" ){
           if(Reflected)
@@ -377,10 +385,7 @@ void opdet::opDetDigitizerWorker::MakeWaveforms(opdet::DigiPMTSBNDAlg *pmtDigiti
                                               is_daphne,
                                               startTime,
                                               fConfig.Nsamples_Daphne);
-            // including pre trigger window and transit time
-            fWaveforms->at(ch) = raw::OpDetWaveform(fConfig.EnableWindow[0],
-                                                    (unsigned int)ch,
-                                                  waveform);
+            StoreWaveform(ch, waveform);
             }
             else{
               arapucaDigitizer->ConstructWaveform(ch,
@@ -390,30 +395,21 @@ void opdet::opDetDigitizerWorker::MakeWaveforms(opdet::DigiPMTSBNDAlg *pmtDigiti
                                               is_daphne,
                                               startTime,
                                               fConfig.Nsamples);
-              // including pre trigger window and transit time
-              fWaveforms->at(ch) = raw::OpDetWaveform(fConfig.EnableWindow[0],
-                                                  (unsigned int)ch,
-                                                  waveform);
+              StoreWaveform(ch, waveform);
           }
         }
       }//optical channel loop
     }//type of light loop
     //Constructing Waveforms for hybrid OpChannels (coated pmts and VUV XAs)
     for(auto ch : coatedpmts_todigitize){
-      std::vector<short unsigned int> waveform;
-      waveform.reserve(fConfig.Nsamples);
+      std::vector<short unsigned int> &waveform = fWaveformBuffer;
       pmtDigitizer->ConstructWaveformCoatedPMT(ch, waveform, DirectPhotonsMap, ReflectedPhotonsMap, startTime, fConfig.Nsamples);
-      fWaveforms->at(ch) = raw::OpDetWaveform(fConfig.EnableWindow[0],
-                                              (unsigned int)ch,
-                                              waveform);
+      StoreWaveform(ch, waveform);
     }
     for(auto ch : vuvxarapucas_todigitize){
-      std::vector<short unsigned int> waveform;
-      waveform.reserve(fConfig.Nsamples_Daphne);
+      std::vector<short unsigned int> &waveform = fWaveformBuffer;
       arapucaDigitizer->ConstructWaveformVUVXA(ch, waveform, XADirectPhotonsMap, XAReflectedPhotonsMap, startTime, fConfig.Nsamples_Daphne);
-      fWaveforms->at(ch) = raw::OpDetWaveform(fConfig.EnableWindow[0],
-                                              (unsigned int)ch,
-                                              waveform);
+      StoreWaveform(ch, waveform);
     }
   }//simphotons end
 }
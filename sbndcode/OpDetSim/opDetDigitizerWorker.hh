@@ -12,7 +12,7 @@
 #include <vector>
 #include <mutex>
 #include <condition_variable>
-// #include <memory>
+#include <memory>
 
 #include "sbndcode/OpDetSim/sbndPDMapAlg.hh"
 #include "sbndcode/OpDetSim/DigiArapucaSBNDAlg.hh"
@@ -81,6 +81,9 @@ namespace opdet {
       fTriggeredWaveforms = Waveforms;
     }
 
+    // Builds the digitizers of this worker, once per job
+    void InitializeDigitizers(detinfo::DetectorClocksData const& clockData);
+
     void Start(detinfo::DetectorClocksData const& clockData) const;
     void ApplyTriggerLocations(detinfo::DetectorClocksData const& clockData) const;
 
@@ -93,6 +96,8 @@ namespace opdet {
     void CreateDirectPhotonMapLite(
       std::unordered_map<int, sim::SimPhotonsLite>& directPhotonsOnPMTS,
       std::vector<art::Handle<std::vector<sim::SimPhotonsLite>>> photon_handles) const;
+    void ResetDigitizers(detinfo::DetectorClocksData const& clockData) const;
+    void StoreWaveform(unsigned ch, std::vector<short unsigned int> const& waveform) const;
     void MakeWaveforms(
       opdet::DigiPMTSBNDAlg *pmtDigitizer,
       opdet::DigiArapucaSBNDAlg *arapucaDigitizer) const;
@@ -106,6 +111,13 @@ namespace opdet {
     const std::vector<art::Handle<std::vector<sim::SimPhotons>>> *fPhotonHandles;
     std::vector<raw::OpDetWaveform> *fWaveforms;
     std::vector<raw::OpDetWaveform> *fTriggeredWaveforms;
+
+    // Digitizers and scratch waveform, kept across events. Each worker
+    // (and hence each of these) is only ever used by its own thread.
+    mutable std::unique_ptr<opdet::DigiPMTSBNDAlg> fPMTDigitizer;
+    mutable std::unique_ptr<opdet::DigiArapucaSBNDAlg> fArapucaDigitizer;
+    mutable double fDigitizerFrequency; // optical clock frequency the digitizers were built with
+    mutable std::vector<short unsigned int> fWaveformBuffer;
   };
 
   void StartopDetDigitizerWorkers(unsigned n_workers, opDetDigitizerWorker::Semaphore &sem_start);
@@ -48,6 +48,7 @@
 #include "sbncode/OpT0Finder/flashmatch/Algorithms/PhotonLibHypothesis.h"
 
 #include "sbndcode/OpDetSim/sbndPDMapAlg.hh"
+#include "sbndcode/OpT0Finder/SliceChargeCache.h"
 #include "sbnobj/Common/Reco/OpT0FinderResult.h"
 
 #include "TFile.h"
@@ -56,6 +57,8 @@
 #include <memory>
 #include <algorithm>
 #include <cmath>
+#include <limits>
+#include <numeric>
 
 
 
@@ -88,6 +91,9 @@ private:
   /// Constructs all the LightClusters (TPC Objects) in a specified TPC
   bool ConstructLightClusters(art::Event& e, unsigned int tpc);
 
+  /// Removes flashes and clusters that cannot form any physical (flash, cluster) pair
+  void PruneCandidates(std::vector<::flashmatch::Flash_t> & flash_v, double drift_velocity);
+
   /// Convert from a list of PDS names to a list of op channels
   std::vector<int> PDNamesToList(std::vector<std::string> pd_names);
 
@@ -104,6 +110,8 @@ private:
   fhicl::ParameterSet _vuv_params;
   fhicl::ParameterSet _vis_params;
 
+  sbnd::opt0::SliceChargeCache _slice_cache; ///< Slice -> hit association graph, built once per event
+
   ::flashmatch::FlashMatchManager _mgr; ///< The flash matching manager
   std::vector<flashmatch::FlashMatch_t> _result_v; ///< Matching result will be stored here
 
@@ -119,6 +127,10 @@ private:
   double _flash_trange_start; ///< The time start from where to include flashes (to be set)
   double _flash_trange_end; ///< The time stop from where to stop including flashes (to be set)
 
+  bool   _prune_candidates; ///< Whether to run the coarse (flash, cluster) pre-filter before matching
+  double _prune_drift_tolerance; ///< Tolerance [cm] on the drift volume boundaries when checking the flash time
+  double _prune_max_centroid_dist; ///< Max distance [cm] in y-z between flash centre and charge centroid
+
   bool _select_nus;
   bool _collection_only;
   std::vector<float> _cal_area_const; 
@@ -166,6 +178,11 @@ private:
 
 SBNDOpT0Finder::SBNDOpT0Finder(fhicl::ParameterSet const& p)
   : EDProducer{p}
+  , _slice_cache(p.get<std::string>("SliceProducer"),
+                 p.get<std::string>("TrackProducer"),
+                 p.get<std::string>("ShowerProducer"),
+                 p.get<std::string>("CaloProducer"),
+                 !p.get<bool>("TrackConstantConversion"))
 {
   produces<std::vector<sbn::OpT0Finder>>();
   produces<art::Assns<recob::Slice, sbn::OpT0Finder>>();
@@ -188,6 +205,10 @@ SBNDOpT0Finder::SBNDOpT0Finder(fhicl::ParameterSet const& p)
   _flash_trange_start = p.get<double>("FlashVetoTimeStart", 0);
   _flash_trange_end = p.get<double>("FlashVetoTimeEnd", 2);
 
+  _prune_candidates        = p.get<bool>("PruneCandidates", false);
+  _prune_drift_tolerance   = p.get<double>("PruneDriftTolerance", 10.);
+  _prune_max_centroid_dist = p.get<double>("PruneMaxCentroidDistance", 1e9);
+
   _photo_detectors = p.get<std::vector<std::string>>("PhotoDetectors");
   _use_arapucas = this->UseArapucas(_photo_detectors);
   _opch_to_use = this->PDNamesToList(_photo_detectors);
@@ -274,6 +295,9 @@ void SBNDOpT0Finder::produce(art::Event& e)
   _subrun = e.id().subRun();
   _event  = e.id().event();
 
+  // Traverse the slice associations once, for all TPCs
+  _slice_cache.Build(e);
+
   // Loop over the specified TPCs
   for (auto tpc : _tpc_v) {
 
@@ -356,37 +380,53 @@ void SBNDOpT0Finder::DoMatch(art::Event& e,
   std::vector<recob::OpFlash> flash_comb_v;
   std::vector<bool> combine_v;
 
+  // Sort the arapuca flashes in time, so that the partner of each PMT flash
+  // is found with a binary search rather than a scan over all arapuca flashes
+  std::vector<size_t> ara_order(flash_ara_v.size());
+  std::iota(ara_order.begin(), ara_order.end(), 0);
+  std::sort(ara_order.begin(), ara_order.end(), [&flash_ara_v](size_t a, size_t b) {
+    return flash_ara_v[a]->Time() < flash_ara_v[b]->Time();
+  });
+  std::vector<double> ara_times;
+  ara_times.reserve(ara_order.size());
+  for (auto idx : ara_order) ara_times.push_back(flash_ara_v[idx]->Time());
+
   for (size_t i=0; i < flash_pmt_v.size(); i++){
     auto const& flash_pmt = *flash_pmt_v[i];
     // combine xara + pmt PE information
     if (_use_arapucas){
       std::vector<double> combined_pe(geo->NOpDets(), 0.0); 
       bool combine = false;
-      for (size_t j=0; j < flash_ara_v.size(); j++){
-        auto const& flash_ara = *flash_ara_v[j];
+      // among the arapuca flashes in the time window, take the first one in the input
+      // collection, as the linear search used to do
+      size_t j_match = flash_ara_v.size();
+      auto it = std::upper_bound(ara_times.begin(), ara_times.end(), flash_pmt.Time() - 0.05);
+      for (; it != ara_times.end() && *it < flash_pmt.Time() + 0.05; ++it) {
+        size_t j = ara_order[std::distance(ara_times.begin(), it)];
+        if (abs(flash_pmt.Time() - flash_ara_v[j]->Time()) < 0.05 && j < j_match) j_match = j;
+      }
+      if (j_match < flash_ara_v.size()){
+        auto const& flash_ara = *flash_ara_v[j_match];
         // if the ara and pmt flashes match: 
-        if (abs(flash_pmt.Time() - flash_ara.Time()) < 0.05){
-          combine = true;
-          if (flash_pmt.Time() > _flash_trange_start  && flash_pmt.Time() < _flash_trange_end)
-            mf::LogInfo("SBNDOpT0Finder") << "Combining PMT OpFlash (time: " 
-                                          << flash_pmt.Time() 
-                                          << "), with ARA OpFlash (time: " 
-                                          << flash_ara.Time() << ")" << std::endl;
-          // add the arapuca flash PE to the pmt flash PE (the PEs vector are different sizes for PMT and xARAPUCAs)
-          for(unsigned int pmt_ch = 0; pmt_ch < flash_pmt.PEs().size(); pmt_ch++)
-            combined_pe.at(pmt_ch) += flash_pmt.PEs().at(pmt_ch);
-          for(unsigned int ara_ch = 0; ara_ch < flash_ara.PEs().size(); ara_ch++)
-            combined_pe.at(ara_ch) += flash_ara.PEs().at(ara_ch);
-  
-          // create new flash with combined PE information and pmt flash information
-          recob::OpFlash new_flash(flash_pmt.Time(), flash_pmt.TimeWidth(), flash_pmt.AbsTime(),
-            flash_pmt.Frame(), combined_pe, flash_pmt.InBeamFrame(), flash_pmt.OnBeamTime(), 
-            flash_pmt.FastToTotal(), flash_pmt.XCenter(), flash_pmt.XWidth(), 
-            flash_pmt.YCenter(), flash_pmt.YWidth(), flash_pmt.ZCenter(), flash_pmt.ZWidth());
-        
-          flash_comb_v.push_back(new_flash);
-          break;
-        }
+        combine = true;
+        if (flash_pmt.Time() > _flash_trange_start  && flash_pmt.Time() < _flash_trange_end)
+          mf::LogInfo("SBNDOpT0Finder") << "Combining PMT OpFlash (time: " 
+                                        << flash_pmt.Time() 
+                                        << "), with ARA OpFlash (time: " 
+                                        << flash_ara.Time() << ")" << std::endl;
+        // add the arapuca flash PE to the pmt flash PE (the PEs vector are different sizes for PMT and xARAPUCAs)
+        for(unsigned int pmt_ch = 0; pmt_ch < flash_pmt.PEs().size(); pmt_ch++)
+          combined_pe.at(pmt_ch) += flash_pmt.PEs().at(pmt_ch);
+        for(unsigned int ara_ch = 0; ara_ch < flash_ara.PEs().size(); ara_ch++)
+          combined_pe.at(ara_ch) += flash_ara.PEs().at(ara_ch);
+
+        // create new flash with combined PE information and pmt flash information
+        recob::OpFlash new_flash(flash_pmt.Time(), flash_pmt.TimeWidth(), flash_pmt.AbsTime(),
+          flash_pmt.Frame(), combined_pe, flash_pmt.InBeamFrame(), flash_pmt.OnBeamTime(), 
+          flash_pmt.FastToTotal(), flash_pmt.XCenter(), flash_pmt.XWidth(), 
+          flash_pmt.YCenter(), flash_pmt.YWidth(), flash_pmt.ZCenter(), flash_pmt.ZWidth());
+      
+        flash_comb_v.push_back(new_flash);
       }
       // if no arapuca flashes are found
       if (combine == false){
@@ -476,6 +516,21 @@ void SBNDOpT0Finder::DoMatch(art::Event& e,
     return;
   }
 
+  // Drop the (flash, cluster) candidates that cannot possibly match
+  // before handing them to the (much more expensive) likelihood fit
+  if (_prune_candidates) {
+    auto const clock_data = art::ServiceHandle<detinfo::DetectorClocksService const>()->DataFor(e);
+    auto const det_prop = art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataFor(e, clock_data);
+    PruneCandidates(all_flashes, det_prop.DriftVelocity());
+
+    if (all_flashes.empty() || _light_cluster_v.empty()) {
+      mf::LogInfo("SBNDOpT0Finder") << "No compatible flash/slice candidates in TPC " << tpc << "." << std::endl;
+      _matchid = -4;
+      _tree2->Fill();
+      return;
+    }
+  }
+
   // Emplace flashes to Flash Matching Manager
   for (auto f : all_flashes) {
     _mgr.Emplace(std::move(f));
@@ -546,26 +601,7 @@ void SBNDOpT0Finder::DoMatch(art::Event& e,
     int slice_id = ptr_slice->ID();
     _sliceid = slice_id;
 
-    ::art::Handle<std::vector<recob::Slice>> slice_h;
-    e.getByLabel(_slice_producer, slice_h);
-    if(!slice_h.isValid() || slice_h->empty()) {
-      mf::LogWarning("SBNDOpT0Finder") << "Don't have good Slices." << std::endl;
-          }
-    // Construct the vector of Slices
-    std::vector<art::Ptr<recob::Slice>> slice_v;
-    art::fill_ptr_vector(slice_v, slice_h);
-    art::FindManyP<recob::PFParticle> slice_to_pfps (slice_h, e, _slice_producer);
-    for (size_t n_slice = 0; n_slice < slice_h->size(); n_slice++) {
-      auto slice = slice_v[n_slice];
-      if (slice->ID() != _sliceid) continue;
-
-      std::vector<art::Ptr<recob::PFParticle>> pfp_v = slice_to_pfps.at(n_slice);
-      for (size_t n_pfp = 0; n_pfp < pfp_v.size(); n_pfp++) {
-        auto pfp = pfp_v[n_pfp];
-        if (!pfp->IsPrimary()) continue;
-        _pfpid = pfp->Self();
-      }
-    }
+    _pfpid = _slice_cache.PrimaryPFParticle(_sliceid);
     _tree2->Fill();
   }
 
@@ -577,59 +613,48 @@ bool SBNDOpT0Finder::ConstructLightClusters(art::Event& e, unsigned int tpc) {
   // there get all the hits on the collection plane.
   // Use the charge on the collection plane to estimate the light, and the 3D spacepoint
   // position for the 3D location.
+  // The slice -> ... -> hit graph is read from the per-event cache, built once in produce.
 
   _light_cluster_v.clear();
 
+  if (!_slice_cache.Valid()) return false;
+
   auto const clock_data = art::ServiceHandle<detinfo::DetectorClocksService const>()->DataFor(e);
   auto const det_prop = art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataFor(e, clock_data);
   art::ServiceHandle<sim::LArG4Parameters const> g4param;
   ::art::ServiceHandle<geo::Geometry> geo;
 
-  ::art::Handle<std::vector<recob::Slice>> slice_h;
-  e.getByLabel(_slice_producer, slice_h);
-  if(!slice_h.isValid() || slice_h->empty()) {
-    mf::LogWarning("SBNDOpT0Finder") << "Don't have good Slices." << std::endl;
-    return false;
-  }
-
-  ::art::Handle<std::vector<recob::PFParticle>> pfp_h;
-  e.getByLabel(_slice_producer, pfp_h);
-  if(!pfp_h.isValid() || pfp_h->empty()) {
-    mf::LogWarning("SBNDOpT0Finder") << "Don't have good PFParticle." << std::endl;
-    return false;
-  }
-
-  ::art::Handle<std::vector<recob::SpacePoint>> spacepoint_h;
-  e.getByLabel(_slice_producer, spacepoint_h);
-  if(!spacepoint_h.isValid() || spacepoint_h->empty()) {
-    mf::LogWarning("SBNDOpT0Finder") << "Don't have good SpacePoint." << std::endl;
-    return false;
-  }
-
-  ::art::Handle<std::vector<recob::Track>> trk_h; 
-  e.getByLabel(_trk_producer, trk_h);
-
-  ::art::Handle<std::vector<recob::Shower>> shw_h;
-  e.getByLabel(_shw_producer, shw_h);
-
-  // Construct the vector of Slices
-  std::vector<art::Ptr<recob::Slice>> slice_v;
-  art::fill_ptr_vector(slice_v, slice_h);
-
-  // Get the associations between slice->pfp->spacepoint->hit
-  art::FindManyP<recob::PFParticle> slice_to_pfps (slice_h, e, _slice_producer);
-  // For using track calorimetry objects, get slice->pfp->track->calo 
-  art::FindManyP<recob::Track>  pfp_to_trks (pfp_h, e, _trk_producer);
-  art::FindManyP<anab::Calorimetry> trk_to_calo (trk_h, e, _calo_producer);
-  // For using track constant objects 
-  art::FindManyP<recob::SpacePoint> trk_to_spacepoints(trk_h, e, _trk_producer);
-  // Get spacepoint to Shower
-  art::FindManyP<recob::Shower> pfp_to_shws (pfp_h, e, _shw_producer);
-  art::FindManyP<recob::SpacePoint> shw_to_spacepoints(shw_h, e, _shw_producer);
-  art::FindManyP<recob::Hit> spacepoint_to_hits (spacepoint_h, e, _slice_producer);
+  // Constants of the charge estimate, evaluated once rather than per point
+  const double drift_length = 2.0*geo->DetHalfWidth();
+  const double drift_velocity = det_prop.DriftVelocity();
+  const double electron_lifetime = det_prop.ElectronLifetime();
+  const double wph = g4param->Wph()*1e-6;
+  auto atten_corr = [&](double x) {
+    double drift_time = (drift_length - std::abs(x))/drift_velocity; // cm / (cm/us)
+    return std::exp(drift_time/electron_lifetime); // exp(us/us)
+  };
+
+  auto const& cached_slices = _slice_cache.Slices();
+  auto const& cached_objects = _slice_cache.Objects();
+  auto const& cached_sps = _slice_cache.SpacePoints();
+  auto const& object_sps = _slice_cache.ObjectSpacePoints();
+  auto const& cached_hits = _slice_cache.Hits();
+
+  // Returns the view with most hits in this TPC (collection wins ties), -1 if none
+  auto best_plane_from_hits = [&](sbnd::opt0::CachedSpacePoint const& sp) {
+    int nhit[3] = {0, 0, 0};
+    for (size_t n_hit = sp.first_hit; n_hit < sp.first_hit + sp.n_hits; n_hit++) {
+      auto const& hit = cached_hits[n_hit];
+      if (hit.tpc == tpc && hit.view >= 0 && hit.view < 3) nhit[hit.view]++;
+    }
+    const int maxHits = std::max({ nhit[0], nhit[1], nhit[2] });
+    return ((nhit[2] == maxHits) ? 2 : (nhit[1] == maxHits) ? 1 : (nhit[0] == maxHits) ? 0 : -1);
+  };
 
   // Loop over the Slices
-  for (size_t n_slice = 0; n_slice < slice_h->size(); n_slice++) {
+  for (size_t n_slice = 0; n_slice < cached_slices.size(); n_slice++) {
+    auto const& cached_slice = cached_slices[n_slice];
+
     flashmatch::QCluster_t light_cluster;
     light_cluster.tpc_mask_v.resize(geo->NOpDets(), 0);
 
@@ -646,265 +671,158 @@ bool SBNDOpT0Finder::ConstructLightClusters(art::Event& e, unsigned int tpc) {
 
     std::vector<int> exit_opch; // mask of opch near the exit point for uncontained tracks
 
-    // Get the associated PFParticles
-    std::vector<art::Ptr<recob::PFParticle>> pfp_v = slice_to_pfps.at(n_slice);
-
-    if (_select_nus){
-      bool nu_pfp = false;
-      for (size_t n_pfp = 0; n_pfp < pfp_v.size(); n_pfp++) {
-        auto pfp = pfp_v[n_pfp];
-        unsigned pfpPDGC = std::abs(pfp->PdgCode());
-        if ((pfpPDGC == 12) || (pfpPDGC == 14) || (pfpPDGC == 16))
-          nu_pfp = true;
-      }
-      if (nu_pfp == false)
-        break;
-    }
+    if (_select_nus && !cached_slice.has_neutrino)
+      break;
 
-    for (size_t n_pfp = 0; n_pfp < pfp_v.size(); n_pfp++) {
-
-      auto pfp = pfp_v[n_pfp];      
-      auto pfpistrack = ::lar_pandora::LArPandoraHelper::IsTrack(pfp);
-      auto pfpisshower = ::lar_pandora::LArPandoraHelper::IsShower(pfp);
-
-      if (pfpistrack){
-        std::vector<art::Ptr<recob::Track>> track_v = pfp_to_trks.at(pfp.key());
-        for (size_t n_trk = 0; n_trk < track_v.size(); n_trk++){
-          auto track = track_v[n_trk];
-
-          // ** exiting track section ** 
-          // find if the track is uncontained and intersects the wire planes
-          bool uncontained = false;
-          auto const trk_start = track->Start();
-          auto const trk_end   = track->End();
-          geo::Point_t exit_pt; 
-
-          if (abs(trk_start.X()) >= 2.0*geo->DetHalfWidth()-3.0) {exit_pt = trk_start; uncontained = true;}
-          else if (abs(trk_end.X()) >= 2.0*geo->DetHalfWidth()-3.0) {exit_pt = trk_end; uncontained = true;}
-          if (uncontained && _exclude_exiting){
-            mf::LogInfo("SBNDOpT0Finder") << "Found particle with exit point: " 
-                                          << exit_pt.X() << ", " 
-                                          << exit_pt.Y() << ", " 
-                                          << exit_pt.Z() << std::endl;
-
-            int tpc = (exit_pt.X() > 0)? 1 : 0; 
-            for (size_t opch=0; opch < geo->NOpDets(); opch++){
-              if (int(opch)%2 != tpc) continue;
-              // only coated PMTs and vuv arapucas will be affected by direct light
-              if (_pds_map.isPDType(opch, "pmt_uncoated") || _pds_map.isPDType(opch, "xarapuca_vis")) continue;
-              if (_use_arapucas && _pds_map.isPDType(opch, "xarapuca_vuv")) continue;
-              auto center = _opch_centers.at(opch);
-              // find which optical detectors are within range of an exiting particle
-              // ** uses the projection in the beam direction ** 
-              if ((abs(center.Z() - (exit_pt.Z() + 50*std::cos(track->Theta()))) <= 75) && 
-                  (abs(center.Y() - (exit_pt.Y() + 50*std::cos(track->ZenithAngle()))) <= 75)){
-                exit_opch.push_back(opch);
-                light_cluster.tpc_mask_v.at(opch) = 1;
-              }
+    auto fill_deposition = [&](int pfp_self, double x, double y, double z,
+                               float dE, float dQ, double nphotons, float pitch, int trk_val) {
+      // emplace this point into the light cluster
+      light_cluster.emplace_back(x, y, z, nphotons);
+
+      // Also save the quantites for the output tree
+      _dep_slice.push_back(n_slice);
+      _dep_pfpid.push_back(pfp_self);
+      _dep_x.push_back(x);
+      _dep_y.push_back(y);
+      _dep_z.push_back(z);
+      _dep_E.push_back(dE);
+      _dep_charge.push_back(dQ);
+      _dep_photons.push_back(static_cast<float>(nphotons));
+      _dep_pitch.push_back(pitch);
+      _dep_trk.push_back(trk_val);
+    };
+
+    for (size_t n_obj = cached_slice.first_obj; n_obj < cached_slice.first_obj + cached_slice.n_obj; n_obj++) {
+      auto const& obj = cached_objects[n_obj];
+
+      if (obj.is_track){
+        auto const& track = obj.track;
+
+        // ** exiting track section ** 
+        // find if the track is uncontained and intersects the wire planes
+        bool uncontained = false;
+        auto const trk_start = track->Start();
+        auto const trk_end   = track->End();
+        geo::Point_t exit_pt; 
+
+        if (abs(trk_start.X()) >= drift_length-3.0) {exit_pt = trk_start; uncontained = true;}
+        else if (abs(trk_end.X()) >= drift_length-3.0) {exit_pt = trk_end; uncontained = true;}
+        if (uncontained && _exclude_exiting){
+          mf::LogInfo("SBNDOpT0Finder") << "Found particle with exit point: " 
+                                        << exit_pt.X() << ", " 
+                                        << exit_pt.Y() << ", " 
+                                        << exit_pt.Z() << std::endl;
+
+          int exit_tpc = (exit_pt.X() > 0)? 1 : 0; 
+          for (size_t opch=0; opch < geo->NOpDets(); opch++){
+            if (int(opch)%2 != exit_tpc) continue;
+            // only coated PMTs and vuv arapucas will be affected by direct light
+            if (_pds_map.isPDType(opch, "pmt_uncoated") || _pds_map.isPDType(opch, "xarapuca_vis")) continue;
+            if (_use_arapucas && _pds_map.isPDType(opch, "xarapuca_vuv")) continue;
+            auto center = _opch_centers.at(opch);
+            // find which optical detectors are within range of an exiting particle
+            // ** uses the projection in the beam direction ** 
+            if ((abs(center.Z() - (exit_pt.Z() + 50*std::cos(track->Theta()))) <= 75) && 
+                (abs(center.Y() - (exit_pt.Y() + 50*std::cos(track->ZenithAngle()))) <= 75)){
+              exit_opch.push_back(opch);
+              light_cluster.tpc_mask_v.at(opch) = 1;
             }
           }
-          // ** end exiting section ** 
-
-          if(!_track_const_conv){       
-            // ** calo section ** 
-            // access the vector from the association, **not necessarily ordered by planes** 
-            std::vector<art::Ptr<anab::Calorimetry>> calo_assn_v = trk_to_calo.at(track.key());
-            // fill a different vector that is **correctly ordered** by plane 
-            std::vector<art::Ptr<anab::Calorimetry>> calo_v(3);
-            for (auto calo : calo_assn_v){
-              if (calo->PlaneID().Plane == 0) calo_v.at(0) = calo;
-              if (calo->PlaneID().Plane == 1) calo_v.at(1) = calo;
-              if (calo->PlaneID().Plane == 2) calo_v.at(2) = calo;
-            }
-            // choose the plane that we want 
-            int bestPlane_trk = 2;
-            if (!_collection_only){
-              const unsigned int maxHits(std::max({ calo_v[0]->dEdx().size(), calo_v[1]->dEdx().size(), calo_v[2]->dEdx().size() }));
-              bestPlane_trk = ((calo_v[2]->dEdx().size() == maxHits) ? 2 : (calo_v[1]->dEdx().size() == maxHits) ? 1 : (calo_v[0]->dEdx().size() == maxHits) ? 0 : -1);
-              if (bestPlane_trk == -1)
-                continue;
-            }
-
-            auto calo = calo_v[bestPlane_trk];
-            auto dEdx_v = calo->dEdx(); // assuming units in MeV/cm
-            auto dADCdx_v = calo->dQdx(); // this is in ADC/cm!!!!!!
-            auto pitch_v = calo->TrkPitchVec(); // assuming units in cm 
-            auto pos_v   = calo->XYZ();
+        }
+        // ** end exiting section ** 
+
+        if(!_track_const_conv){       
+          // ** calo section ** 
+          // the cache holds the calorimetry **correctly ordered** by plane 
+          auto const& calo_v = obj.calo;
+          // choose the plane that we want 
+          int bestPlane_trk = 2;
+          if (!_collection_only){
+            const unsigned int maxHits(std::max({ calo_v[0]->dEdx().size(), calo_v[1]->dEdx().size(), calo_v[2]->dEdx().size() }));
+            bestPlane_trk = ((calo_v[2]->dEdx().size() == maxHits) ? 2 : (calo_v[1]->dEdx().size() == maxHits) ? 1 : (calo_v[0]->dEdx().size() == maxHits) ? 0 : -1);
+            if (bestPlane_trk == -1)
+              continue;
+          }
 
-            // create vector of e- instead of ADC units 
-            std::vector<float> dQdx_v(dADCdx_v.size(),0);
-            for (size_t n_calo = 0; n_calo < dADCdx_v.size(); n_calo++){
-              dQdx_v[n_calo] = dADCdx_v[n_calo]*(1/_cal_area_const.at(bestPlane_trk));
+          auto const& calo = calo_v[bestPlane_trk];
+          auto const& dEdx_v = calo->dEdx(); // assuming units in MeV/cm
+          auto const& dADCdx_v = calo->dQdx(); // this is in ADC/cm!!!!!!
+          auto const& pitch_v = calo->TrkPitchVec(); // assuming units in cm 
+          auto const& pos_v   = calo->XYZ();
+          const float inv_cal_const = 1/_cal_area_const.at(bestPlane_trk);
+
+          for (size_t n_calo = 0; n_calo < dEdx_v.size(); n_calo++){
+            // only select steps that are in the right TPC
+            auto const& position = pos_v[n_calo];
+            auto x_calo = position.X();
+            if ((x_calo < 0 && tpc==1 ) || (x_calo > 0 && tpc==0)) continue; // skip if not in the correct TPC 
+
+            // create e- instead of ADC units 
+            const float dQdx = dADCdx_v[n_calo]*inv_cal_const;
+            const double corr = atten_corr(x_calo);
+
+            // steps that do not contain an outlier: 
+            if (pitch_v[n_calo] < _pitch_limit && dQdx < _dQdx_limit){
+              float pitch = pitch_v[n_calo];
+              float dQ = dQdx * pitch * corr;
+              float dE = dEdx_v[n_calo] * pitch; // this value *is already* lifetime corrected
+              float nphotons = dE/wph - dQ;
+              fill_deposition(obj.pfp_self, position.X(), position.Y(), position.Z(), dE, dQ, nphotons, pitch, 1);
+            } 
+            // steps that do contain an outlier: 
+            else{
+              float dQ = dQdx * pitch_v[n_calo] * corr;  
+              float nphotons = dQ*_track_to_photons; 
+              fill_deposition(obj.pfp_self, position.X(), position.Y(), position.Z(), -1., dQ, nphotons, -1., 0);
             }
+          } // end loop over calo steps
+        } // end calo (not using constant conversion)
+        if (_track_const_conv){
+          for (size_t n_sp = obj.first_sp; n_sp < obj.first_sp + obj.n_sp; n_sp++) {
+            auto const& sp = cached_sps[object_sps[n_sp]];
+            // find best track planes if other planes are allowed 
+            const int bestPlane_trk = _collection_only ? 2 : best_plane_from_hits(sp);
+            for (size_t n_hit = sp.first_hit; n_hit < sp.first_hit + sp.n_hits; n_hit++) {
+              auto const& hit = cached_hits[n_hit];
+              // Only select hits from the collection plane/best plane and in the specified TPC
+              if (hit.view != bestPlane_trk) continue;
+              if (hit.tpc != tpc) continue; 
 
-            for (size_t n_calo = 0; n_calo < calo->dEdx().size(); n_calo++){
-              // only select steps that are in the right TPC
-              auto &position = pos_v[n_calo];
-              auto x_calo = position.X();
-              if ((x_calo < 0 && tpc==1 ) || (x_calo > 0 && tpc==0)) continue; // skip if not in the correct TPC 
-              // variables to fill the tree
-              float dE; 
-              float dQ;
-              float pitch; 
-              float nphotons; 
-              int   trk_val; 
-
-              double drift_time = ((2.0*geo->DetHalfWidth()) - abs(x_calo))/(det_prop.DriftVelocity()); // cm / (cm/us) 
-              double atten_corr = std::exp(drift_time/det_prop.ElectronLifetime()); // exp(us/us)
-
-              // steps that do not contain an outlier: 
-              if (pitch_v[n_calo] < _pitch_limit && dQdx_v[n_calo] < _dQdx_limit){
-                pitch = pitch_v[n_calo];
-                dQ = dQdx_v[n_calo] * pitch * atten_corr;
-                dE = dEdx_v[n_calo] * pitch; // this value *is already* lifetime corrected
-                nphotons = dE/(g4param->Wph()*1e-6) - dQ;
-                trk_val = 1;
-              } 
-              // steps that do contain an outlier: 
-              else{
-                pitch = -1.;
-                dQ = dQdx_v[n_calo] * pitch_v[n_calo] * atten_corr;  
-                dE = -1.;
-                nphotons = dQ*_track_to_photons; 
-                trk_val = 0;
-              }
-              // Fill tree variables 
-              _dep_slice.push_back(n_slice);
-              _dep_pfpid.push_back(pfp->Self());
-              _dep_x.push_back(position.X());
-              _dep_y.push_back(position.Y());
-              _dep_z.push_back(position.Z());
-              _dep_E.push_back(dE);
-              _dep_charge.push_back(dQ);
-              _dep_photons.push_back(nphotons);
-              _dep_pitch.push_back(pitch);
-              _dep_trk.push_back(trk_val);
-
-              // emplace this point into the light cluster 
-              light_cluster.emplace_back(position.X(),
-                                        position.Y(),
-                                        position.Z(),
-                                        nphotons);
-            } // end loop over calo steps }
-          } // end calo (not using constant conversion)
-          if (_track_const_conv){
-            int bestPlane_trk=2; 
-            std::vector<art::Ptr<recob::SpacePoint>> spacepoint_v = trk_to_spacepoints.at(track.key());
-            for (size_t n_spacepoint = 0; n_spacepoint < spacepoint_v.size(); n_spacepoint++) {
-              auto spacepoint = spacepoint_v[n_spacepoint];
-              std::vector<art::Ptr<recob::Hit>> hit_v = spacepoint_to_hits.at(spacepoint.key());
-              if (!_collection_only){ // find best track planes if other planes are allowed 
-                int nhit0_trk=0; int nhit1_trk=0; int nhit2_trk=0;
-                for (size_t n_hit = 0; n_hit < hit_v.size(); n_hit++) {
-                  auto hit = hit_v[n_hit];
-                  if (hit->View() == 0 && hit->WireID().TPC == tpc) nhit0_trk++; 
-                  if (hit->View() == 1 && hit->WireID().TPC == tpc) nhit1_trk++; 
-                  if (hit->View() == 2 && hit->WireID().TPC == tpc) nhit2_trk++;
-                 } 
-                const int maxHits = std::max({ nhit0_trk, nhit1_trk, nhit2_trk});
-                bestPlane_trk = ((nhit2_trk == maxHits) ? 2 : (nhit1_trk == maxHits) ? 1 : (nhit0_trk == maxHits) ? 0 : -1);
-              } 
-              for (size_t n_hit = 0; n_hit < hit_v.size(); n_hit++) {
-                auto hit = hit_v[n_hit];
-                // Only select hits from the collection plane/best plane and in the specified TPC
-                if (hit->View() != bestPlane_trk) continue;
-                if (hit->WireID().TPC != tpc) continue; 
-
-                const auto &position(spacepoint->XYZ());
-                double drift_time = ((2.0*geo->DetHalfWidth()) - abs(position[0]))/(det_prop.DriftVelocity()); // cm / (cm/us) 
-                double atten_corr = std::exp(drift_time/det_prop.ElectronLifetime()); // exp(us/us)
-
-                const auto charge((1/_cal_area_const.at(bestPlane_trk))*hit->Integral()*atten_corr);
-                double nphotons = charge*_track_to_photons;
-
-                // Emplace this point with charge to the light cluster
-                light_cluster.emplace_back(position[0],
-                                          position[1],
-                                          position[2],
-                                          nphotons);
-
-                // Also save the quantites for the output tree
-                _dep_slice.push_back(n_slice);
-                _dep_pfpid.push_back(pfp->Self());
-                _dep_x.push_back(position[0]);
-                _dep_y.push_back(position[1]);
-                _dep_z.push_back(position[2]);
-                _dep_E.push_back(-1.);
-                _dep_charge.push_back(charge);
-                _dep_photons.push_back(nphotons);
-                _dep_pitch.push_back(-1.);
-                _dep_trk.push_back(0);
-              }
-            }  // End loop over Spacepoints
-          } // end trk const conversion 
-        } // end loop over tracks 
-      } // end if pfpistrack
-
-      else if (pfpisshower){
-        std::vector<art::Ptr<recob::Shower>> shower_v = pfp_to_shws.at(pfp.key());
-        for (size_t n_shw = 0; n_shw < shower_v.size(); n_shw++){
-          auto shower = shower_v[n_shw];
-          int bestPlane_shw=2; 
-          std::vector<art::Ptr<recob::SpacePoint>> spacepoint_v = shw_to_spacepoints.at(shower.key());
-          for (size_t n_spacepoint = 0; n_spacepoint < spacepoint_v.size(); n_spacepoint++) {
-            auto spacepoint = spacepoint_v[n_spacepoint];
-            std::vector<art::Ptr<recob::Hit>> hit_v = spacepoint_to_hits.at(spacepoint.key());
-            
-            if (!_collection_only){ // find best shower plane if other planes are allowed
-              bestPlane_shw = shower->best_plane();
-              if ( (shower->Energy()).at(bestPlane_shw) == -999){
-                int nhit0_shw=0; int nhit1_shw=0; int nhit2_shw=0;
-                for (size_t n_hit=0; n_hit<hit_v.size(); n_hit++){
-                  auto hit = hit_v[n_hit];
-                  if (hit->View() == 0 && hit->WireID().TPC == tpc) nhit0_shw++; 
-                  if (hit->View() == 1 && hit->WireID().TPC == tpc) nhit1_shw++; 
-                  if (hit->View() == 2 && hit->WireID().TPC == tpc) nhit2_shw++;
-                }
-                const int maxHits = std::max({ nhit0_shw, nhit1_shw, nhit2_shw});
-                bestPlane_shw = ((nhit2_shw == maxHits) ? 2 : (nhit1_shw == maxHits) ? 1 : (nhit0_shw == maxHits) ? 0 : -1);
-              }
+              const double charge = (1/_cal_area_const.at(bestPlane_trk))*hit.integral*atten_corr(sp.x);
+              const double nphotons = charge*_track_to_photons;
+              fill_deposition(obj.pfp_self, sp.x, sp.y, sp.z, -1., charge, nphotons, -1., 0);
             }
+          }  // End loop over Spacepoints
+        } // end trk const conversion 
+      } // end if track
 
-            for (size_t n_hit = 0; n_hit < hit_v.size(); n_hit++) {
-              auto hit = hit_v[n_hit];
-              // Only select hits from the collection plane/best plane and in the specified TPC
-              if (hit->View() != bestPlane_shw) continue;
-              if (hit->WireID().TPC != tpc) continue; 
+      else {
+        auto const& shower = obj.shower;
+        for (size_t n_sp = obj.first_sp; n_sp < obj.first_sp + obj.n_sp; n_sp++) {
+          auto const& sp = cached_sps[object_sps[n_sp]];
 
-              const auto &position(spacepoint->XYZ());
-              double drift_time = ((2.0*geo->DetHalfWidth()) - abs(position[0]))/(det_prop.DriftVelocity()); // cm / (cm/us) 
-              double atten_corr = std::exp(drift_time/det_prop.ElectronLifetime()); // exp(us/us)
+          int bestPlane_shw=2; 
+          if (!_collection_only){ // find best shower plane if other planes are allowed
+            bestPlane_shw = shower->best_plane();
+            if ( (shower->Energy()).at(bestPlane_shw) == -999)
+              bestPlane_shw = best_plane_from_hits(sp);
+          }
 
-              const auto charge((1/_cal_area_const.at(bestPlane_shw))*hit->Integral()*atten_corr);
-              double nphotons = 0;
- 
-              if ( _shower_const_conv) nphotons = charge*_shower_to_photons;
-              else{
-                std::cout << "Only have shower constant conversion calculation... using constant conversion" << std::endl;
-                nphotons = charge*_shower_to_photons;
-              }
-              // Emplace this point with charge to the light cluster
-              light_cluster.emplace_back(position[0],
-                                        position[1],
-                                        position[2],
-                                        nphotons);
-
-              // Also save the quantites for the output tree
-              _dep_slice.push_back(n_slice);
-              _dep_pfpid.push_back(pfp->Self());
-              _dep_x.push_back(position[0]);
-              _dep_y.push_back(position[1]);
-              _dep_z.push_back(position[2]);
-              _dep_E.push_back(-1.);
-              _dep_charge.push_back(charge);
-              _dep_photons.push_back(nphotons);
-              _dep_pitch.push_back(-1.);
-              _dep_trk.push_back(2);
-            }
-          } // End loop over Spacepoints
-        } // end shower loop
-      } // end if pfpisshower
-    } // End loop over PFParticle
+          for (size_t n_hit = sp.first_hit; n_hit < sp.first_hit + sp.n_hits; n_hit++) {
+            auto const& hit = cached_hits[n_hit];
+            // Only select hits from the collection plane/best plane and in the specified TPC
+            if (hit.view != bestPlane_shw) continue;
+            if (hit.tpc != tpc) continue; 
+
+            const double charge = (1/_cal_area_const.at(bestPlane_shw))*hit.integral*atten_corr(sp.x);
+            if (!_shower_const_conv)
+              std::cout << "Only have shower constant conversion calculation... using constant conversion" << std::endl;
+            const double nphotons = charge*_shower_to_photons;
+            fill_deposition(obj.pfp_self, sp.x, sp.y, sp.z, -1., charge, nphotons, -1., 2);
+          }
+        } // End loop over Spacepoints
+      } // end if shower
+    } // End loop over tracks/showers
 
     _tree1->Fill();
 
@@ -914,7 +832,7 @@ bool SBNDOpT0Finder::ConstructLightClusters(art::Event& e, unsigned int tpc) {
     }
 
     // Save the light cluster, and remember the correspondance from index to slice
-    _clusterid_to_slice[_light_cluster_v.size()] = slice_v.at(n_slice);
+    _clusterid_to_slice[_light_cluster_v.size()] = cached_slice.slice;
 
     _light_cluster_v.emplace_back(light_cluster);
 
@@ -929,6 +847,101 @@ bool SBNDOpT0Finder::ConstructLightClusters(art::Event& e, unsigned int tpc) {
   return true;
 }
 
+void SBNDOpT0Finder::PruneCandidates(std::vector<::flashmatch::Flash_t> & flash_v, double drift_velocity) {
+  // A slice reconstructed assuming t0 = 0 is shifted in |x| by drift_velocity*t
+  // if it actually happened at time t. Only flash times that keep the whole
+  // slice inside the drift volume are allowed: this bounds the time window
+  // of every cluster from its |x| extent. On top of that, the charge centroid
+  // in y-z has to be close to the (PE-weighted) flash centre.
+
+  ::art::ServiceHandle<geo::Geometry> geo;
+  const double drift_length = 2.0*geo->DetHalfWidth();
+
+  struct ClusterWindow_t {
+    double t_min, t_max; ///< Allowed flash time window [us]
+    double y, z;         ///< Charge-weighted centroid [cm]
+  };
+
+  std::vector<ClusterWindow_t> window_v;
+  window_v.reserve(_light_cluster_v.size());
+  for (auto const& cluster : _light_cluster_v) {
+    double x_min = std::numeric_limits<double>::max();
+    double x_max = std::numeric_limits<double>::lowest();
+    double q_sum = 0., y_sum = 0., z_sum = 0.;
+    for (auto const& pt : cluster) {
+      x_min = std::min(x_min, std::abs(pt.x));
+      x_max = std::max(x_max, std::abs(pt.x));
+      q_sum += pt.q;
+      y_sum += pt.y * pt.q;
+      z_sum += pt.z * pt.q;
+    }
+    ClusterWindow_t w;
+    w.t_min = (-_prune_drift_tolerance - x_min) / drift_velocity;
+    w.t_max = (drift_length + _prune_drift_tolerance - x_max) / drift_velocity;
+    w.y = q_sum > 0 ? y_sum / q_sum : 0.;
+    w.z = q_sum > 0 ? z_sum / q_sum : 0.;
+    window_v.push_back(w);
+  }
+
+  // Sort the flashes in time, so that each cluster only looks at the flashes
+  // inside its own time window
+  std::vector<size_t> order(flash_v.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&flash_v](size_t a, size_t b) {
+    return flash_v[a].time < flash_v[b].time;
+  });
+  std::vector<double> time_v;
+  time_v.reserve(order.size());
+  for (auto idx : order) time_v.push_back(flash_v[idx].time);
+
+  std::vector<bool> keep_flash(flash_v.size(), false);
+  std::vector<bool> keep_cluster(_light_cluster_v.size(), false);
+  const double max_dist2 = _prune_max_centroid_dist * _prune_max_centroid_dist;
+
+  for (size_t n_cl = 0; n_cl < window_v.size(); n_cl++) {
+    auto const& w = window_v[n_cl];
+    auto it = std::lower_bound(time_v.begin(), time_v.end(), w.t_min);
+    for (; it != time_v.end() && *it <= w.t_max; ++it) {
+      size_t n_f = order[std::distance(time_v.begin(), it)];
+      auto const& f = flash_v[n_f];
+      const double dy = f.y - w.y;
+      const double dz = f.z - w.z;
+      if (dy*dy + dz*dz > max_dist2) continue;
+      keep_flash[n_f] = true;
+      keep_cluster[n_cl] = true;
+    }
+  }
+
+  // Compact both arrays and re-index the flash/slice look-up maps
+  std::vector<::flashmatch::Flash_t> pruned_flash_v;
+  std::map<int, art::Ptr<recob::OpFlash>> pruned_flashid_to_opflash;
+  for (size_t n_f = 0; n_f < flash_v.size(); n_f++) {
+    if (!keep_flash[n_f]) continue;
+    auto f = flash_v[n_f];
+    f.idx = pruned_flash_v.size();
+    pruned_flashid_to_opflash[f.idx] = _flashid_to_opflash[n_f];
+    pruned_flash_v.push_back(std::move(f));
+  }
+
+  std::vector<flashmatch::QCluster_t> pruned_cluster_v;
+  std::map<int, art::Ptr<recob::Slice>> pruned_clusterid_to_slice;
+  for (size_t n_cl = 0; n_cl < _light_cluster_v.size(); n_cl++) {
+    if (!keep_cluster[n_cl]) continue;
+    pruned_clusterid_to_slice[pruned_cluster_v.size()] = _clusterid_to_slice[n_cl];
+    pruned_cluster_v.push_back(std::move(_light_cluster_v[n_cl]));
+  }
+
+  mf::LogDebug("SBNDOpT0Finder") << "Candidate pruning kept " << pruned_flash_v.size()
+                                 << "/" << flash_v.size() << " flashes and "
+                                 << pruned_cluster_v.size() << "/" << _light_cluster_v.size()
+                                 << " clusters." << std::endl;
+
+  flash_v = std::move(pruned_flash_v);
+  _flashid_to_opflash = std::move(pruned_flashid_to_opflash);
+  _light_cluster_v = std::move(pruned_cluster_v);
+  _clusterid_to_slice = std::move(pruned_clusterid_to_slice);
+}
+
 std::vector<int> SBNDOpT0Finder::PDNamesToList(std::vector<std::string> pd_names) {
 
   std::vector<int> out_ch_v;
@@ -0,0 +1,181 @@
+////////////////////////////////////////////////////////////////////////
+// File:        SliceChargeCache.cc
+//
+// See SliceChargeCache.h
+////////////////////////////////////////////////////////////////////////
+
+#include "sbndcode/OpT0Finder/SliceChargeCache.h"
+
+#include "art/Framework/Principal/Handle.h"
+#include "canvas/Persistency/Common/FindManyP.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+#include "lardataobj/RecoBase/PFParticle.h"
+#include "lardataobj/RecoBase/SpacePoint.h"
+#include "lardataobj/RecoBase/Hit.h"
+
+#include "larpandora/LArPandoraInterface/LArPandoraHelper.h"
+
+#include <cstdlib>
+#include <optional>
+
+namespace sbnd::opt0 {
+
+  SliceChargeCache::SliceChargeCache(std::string const& slice_producer,
+                                     std::string const& trk_producer,
+                                     std::string const& shw_producer,
+                                     std::string const& calo_producer,
+                                     bool use_track_calo)
+    : fSliceProducer(slice_producer)
+    , fTrackProducer(trk_producer)
+    , fShowerProducer(shw_producer)
+    , fCaloProducer(calo_producer)
+    , fUseTrackCalo(use_track_calo)
+    , fValid(false)
+  {}
+
+  void SliceChargeCache::Clear()
+  {
+    fValid = false;
+    fSlices.clear();
+    fObjects.clear();
+    fSpacePoints.clear();
+    fObjectSpacePoints.clear();
+    fHits.clear();
+  }
+
+  bool SliceChargeCache::Build(art::Event const& e)
+  {
+    Clear();
+
+    art::Handle<std::vector<recob::Slice>> slice_h;
+    e.getByLabel(fSliceProducer, slice_h);
+    if(!slice_h.isValid() || slice_h->empty()) {
+      mf::LogWarning("SliceChargeCache") << "Don't have good Slices." << std::endl;
+      return false;
+    }
+
+    art::Handle<std::vector<recob::PFParticle>> pfp_h;
+    e.getByLabel(fSliceProducer, pfp_h);
+    if(!pfp_h.isValid() || pfp_h->empty()) {
+      mf::LogWarning("SliceChargeCache") << "Don't have good PFParticle." << std::endl;
+      return false;
+    }
+
+    art::Handle<std::vector<recob::SpacePoint>> spacepoint_h;
+    e.getByLabel(fSliceProducer, spacepoint_h);
+    if(!spacepoint_h.isValid() || spacepoint_h->empty()) {
+      mf::LogWarning("SliceChargeCache") << "Don't have good SpacePoint." << std::endl;
+      return false;
+    }
+
+    art::Handle<std::vector<recob::Track>> trk_h;
+    e.getByLabel(fTrackProducer, trk_h);
+
+    art::Handle<std::vector<recob::Shower>> shw_h;
+    e.getByLabel(fShowerProducer, shw_h);
+
+    // Each association is built exactly once per event
+    art::FindManyP<recob::PFParticle> slice_to_pfps(slice_h, e, fSliceProducer);
+    art::FindManyP<recob::Track> pfp_to_trks(pfp_h, e, fTrackProducer);
+    art::FindManyP<recob::Shower> pfp_to_shws(pfp_h, e, fShowerProducer);
+    art::FindManyP<recob::SpacePoint> shw_to_spacepoints(shw_h, e, fShowerProducer);
+    art::FindManyP<recob::Hit> spacepoint_to_hits(spacepoint_h, e, fSliceProducer);
+
+    // Tracks need either the calorimetry or the spacepoints, never both
+    std::optional<art::FindManyP<anab::Calorimetry>> trk_to_calo;
+    std::optional<art::FindManyP<recob::SpacePoint>> trk_to_spacepoints;
+    if (fUseTrackCalo) trk_to_calo.emplace(trk_h, e, fCaloProducer);
+    else               trk_to_spacepoints.emplace(trk_h, e, fTrackProducer);
+
+    // Spacepoints and their hits, flattened in key order
+    fSpacePoints.reserve(spacepoint_h->size());
+    for (size_t n_sp = 0; n_sp < spacepoint_h->size(); n_sp++) {
+      auto const& xyz = (*spacepoint_h)[n_sp].XYZ();
+      std::vector<art::Ptr<recob::Hit>> const& hit_v = spacepoint_to_hits.at(n_sp);
+
+      fSpacePoints.push_back({xyz[0], xyz[1], xyz[2], fHits.size(), hit_v.size()});
+      for (auto const& hit : hit_v) {
+        fHits.push_back({hit->Integral(), static_cast<int>(hit->View()), hit->WireID().TPC});
+      }
+    }
+
+    std::vector<art::Ptr<recob::Slice>> slice_v;
+    art::fill_ptr_vector(slice_v, slice_h);
+
+    auto add_spacepoints = [this](CachedObject& obj, std::vector<art::Ptr<recob::SpacePoint>> const& sp_v) {
+      obj.first_sp = fObjectSpacePoints.size();
+      obj.n_sp = sp_v.size();
+      for (auto const& sp : sp_v) fObjectSpacePoints.push_back(sp.key());
+    };
+
+    fSlices.reserve(slice_v.size());
+    for (size_t n_slice = 0; n_slice < slice_v.size(); n_slice++) {
+
+      CachedSlice cached_slice;
+      cached_slice.slice = slice_v[n_slice];
+      cached_slice.has_neutrino = false;
+      cached_slice.primary_pfp = -1;
+      cached_slice.first_obj = fObjects.size();
+
+      std::vector<art::Ptr<recob::PFParticle>> const& pfp_v = slice_to_pfps.at(n_slice);
+
+      for (auto const& pfp : pfp_v) {
+        unsigned pfpPDGC = std::abs(pfp->PdgCode());
+        if ((pfpPDGC == 12) || (pfpPDGC == 14) || (pfpPDGC == 16))
+          cached_slice.has_neutrino = true;
+        if (pfp->IsPrimary())
+          cached_slice.primary_pfp = pfp->Self();
+
+        if (::lar_pandora::LArPandoraHelper::IsTrack(pfp)) {
+          std::vector<art::Ptr<recob::Track>> const& track_v = pfp_to_trks.at(pfp.key());
+          for (auto const& track : track_v) {
+            CachedObject obj;
+            obj.pfp_self = pfp->Self();
+            obj.is_track = true;
+            obj.track = track;
+            obj.first_sp = fObjectSpacePoints.size();
+            obj.n_sp = 0;
+            if (fUseTrackCalo) {
+              // calorimetry from the association is not necessarily ordered by plane
+              for (auto const& calo : trk_to_calo->at(track.key())) {
+                auto const plane = calo->PlaneID().Plane;
+                if (plane < obj.calo.size()) obj.calo[plane] = calo;
+              }
+            }
+            else {
+              add_spacepoints(obj, trk_to_spacepoints->at(track.key()));
+            }
+            fObjects.push_back(std::move(obj));
+          }
+        }
+        else if (::lar_pandora::LArPandoraHelper::IsShower(pfp)) {
+          std::vector<art::Ptr<recob::Shower>> const& shower_v = pfp_to_shws.at(pfp.key());
+          for (auto const& shower : shower_v) {
+            CachedObject obj;
+            obj.pfp_self = pfp->Self();
+            obj.is_track = false;
+            obj.shower = shower;
+            add_spacepoints(obj, shw_to_spacepoints.at(shower.key()));
+            fObjects.push_back(std::move(obj));
+          }
+        }
+      }
+
+      cached_slice.n_obj = fObjects.size() - cached_slice.first_obj;
+      fSlices.push_back(std::move(cached_slice));
+    }
+
+    fValid = true;
+    return true;
+  }
+
+  int SliceChargeCache::PrimaryPFParticle(int slice_id) const
+  {
+    int primary = -1;
+    for (auto const& cached_slice : fSlices) {
+      if (cached_slice.slice->ID() == slice_id) primary = cached_slice.primary_pfp;
+    }
+    return primary;
+  }
+}
@@ -0,0 +1,112 @@
+#ifndef SBNDCODE_OPT0FINDER_SLICECHARGECACHE_H
+#define SBNDCODE_OPT0FINDER_SLICECHARGECACHE_H
+
+////////////////////////////////////////////////////////////////////////
+// File:        SliceChargeCache.h
+//
+// Per-event cache of the slice -> PFParticle -> track/shower ->
+// spacepoint -> hit graph used to build the OpT0Finder QClusters.
+// The associations are traversed once per event and flattened into
+// contiguous arrays, which are then read once per TPC (and by the
+// analyzer) without constructing any further art::FindManyP.
+////////////////////////////////////////////////////////////////////////
+
+#include "art/Framework/Principal/Event.h"
+#include "canvas/Persistency/Common/Ptr.h"
+
+#include "lardataobj/RecoBase/Slice.h"
+#include "lardataobj/RecoBase/Track.h"
+#include "lardataobj/RecoBase/Shower.h"
+#include "lardataobj/AnalysisBase/Calorimetry.h"
+
+#include <array>
+#include <string>
+#include <vector>
+
+namespace sbnd::opt0 {
+
+  /// A hit attached to a spacepoint, reduced to what the charge estimate needs
+  struct CachedHit {
+    float integral;   ///< Hit integral [ADC]
+    int view;         ///< Wire plane view
+    unsigned int tpc; ///< TPC of the wire the hit is on
+  };
+
+  /// A spacepoint with the range of its hits in the flat hit array
+  struct CachedSpacePoint {
+    double x, y, z;
+    size_t first_hit;
+    size_t n_hits;
+  };
+
+  /// A track or a shower with the range of its spacepoint keys in the flat index array
+  struct CachedObject {
+    int pfp_self;                                   ///< Self() of the parent PFParticle
+    bool is_track;                                  ///< Track if true, shower otherwise
+    art::Ptr<recob::Track> track;
+    art::Ptr<recob::Shower> shower;
+    std::array<art::Ptr<anab::Calorimetry>, 3> calo; ///< Track calorimetry ordered by plane
+    size_t first_sp;
+    size_t n_sp;
+  };
+
+  /// A slice with the range of its tracks/showers in the flat object array
+  struct CachedSlice {
+    art::Ptr<recob::Slice> slice;
+    bool has_neutrino; ///< Whether one of the PFParticles is a neutrino
+    int primary_pfp;   ///< Self() of the (last) primary PFParticle, -1 if none
+    size_t first_obj;
+    size_t n_obj;
+  };
+
+  class SliceChargeCache {
+  public:
+
+    SliceChargeCache(std::string const& slice_producer,
+                     std::string const& trk_producer,
+                     std::string const& shw_producer,
+                     std::string const& calo_producer,
+                     bool use_track_calo);
+
+    /// Traverses the association graph of the event; returns false if there are no slices/PFParticles/spacepoints
+    bool Build(art::Event const& e);
+
+    /// Clears the cache content, keeping the allocated memory
+    void Clear();
+
+    bool Valid() const { return fValid; }
+
+    std::vector<CachedSlice> const& Slices() const { return fSlices; }
+
+    std::vector<CachedObject> const& Objects() const { return fObjects; }
+
+    /// Spacepoints of the slice producer, indexed by art::Ptr key
+    std::vector<CachedSpacePoint> const& SpacePoints() const { return fSpacePoints; }
+
+    /// Spacepoint keys of each object, see CachedObject::first_sp
+    std::vector<size_t> const& ObjectSpacePoints() const { return fObjectSpacePoints; }
+
+    std::vector<CachedHit> const& Hits() const { return fHits; }
+
+    /// Returns the primary PFParticle Self() of the slice with the given ID, -1 if not found
+    int PrimaryPFParticle(int slice_id) const;
+
+  private:
+
+    std::string fSliceProducer;
+    std::string fTrackProducer;
+    std::string fShowerProducer;
+    std::string fCaloProducer;
+    bool        fUseTrackCalo;
+
+    bool fValid;
+
+    std::vector<CachedSlice>      fSlices;
+    std::vector<CachedObject>     fObjects;
+    std::vector<CachedSpacePoint> fSpacePoints;
+    std::vector<size_t>           fObjectSpacePoints;
+    std::vector<CachedHit>        fHits;
+  };
+}
+
+#endif
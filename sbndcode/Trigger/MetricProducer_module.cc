@@ -79,6 +79,8 @@ private:
   double fTriggerTimeOffset;    // offset of trigger time, default 0.5 sec
   double fBeamWindowLength; // beam window length after trigger time, default 1.6us
   uint32_t fWvfmLength;
+  size_t fNBoards;            // number of CAEN V1730 fragments per trigger
+  size_t fNChannelsPerBoard;  // number of PMT channels per fragment
 
   bool fCalculateBaseline;
   bool fCountPMTs;
@@ -99,10 +101,11 @@ private:
   uint32_t beamWindowStart;
   uint32_t beamWindowEnd;
 
-  // waveforms
+  // waveforms, read in place from the fragments of the event:
+  // first sample of each channel, nullptr if its fragment is missing
   uint32_t fTriggerTime;
   bool fWvfmsFound;
-  std::vector<std::vector<uint16_t>> fWvfmsVec;
+  std::vector<const uint16_t*> fWvfmsVec;
 
   // pmt information
   std::vector<sbnd::trigger::pmtInfo> fpmtInfoVec;
@@ -112,7 +115,7 @@ private:
   int num_pmt_frags;
 
 
-  void analyze_crt_fragment(artdaq::Fragment & frag);
+  void analyze_crt_fragment(const artdaq::Fragment & frag);
   void checkCAEN1730FragmentTimeStamp(const artdaq::Fragment &frag);
   void analyzeCAEN1730Fragment(const artdaq::Fragment &frag);
   void estimateBaseline(int i_ch);
@@ -145,6 +148,8 @@ sbndaq::MetricProducer::MetricProducer(fhicl::ParameterSet const& p)
   fTriggerTimeOffset(p.get<double>("TriggerTimeOffset", 0.5)),
   fBeamWindowLength(p.get<double>("BeamWindowLength", 1.6)),
   fWvfmLength(p.get<uint32_t>("WvfmLength", 5120)),
+  fNBoards(p.get<size_t>("NBoards", 8)),
+  fNChannelsPerBoard(p.get<size_t>("NChannelsPerBoard", 15)),
   fCalculateBaseline(p.get<bool>("CalculateBaseline",true)),
   fCountPMTs(p.get<bool>("CountPMTs",true)),
   fCalculatePEMetrics(p.get<bool>("CalculatePEMetrics",false)),
@@ -202,8 +207,8 @@ void sbndaq::MetricProducer::produce(art::Event& evt)
   for (int ip=0;ip<7;++ip)  { crt_metrics.hitsperplane[ip]=0; hitsperplane[ip]=0;}
   foundBeamTrigger = false;
   fWvfmsFound = false;
-  fWvfmsVec.clear(); fWvfmsVec.resize(15*8); // 15 pmt channels per fragment, 8 fragments per trigger
-  fpmtInfoVec.clear(); fpmtInfoVec.resize(15*8);
+  fWvfmsVec.assign(fNChannelsPerBoard*fNBoards, nullptr); // pmt channels per fragment, fragments per trigger
+  fpmtInfoVec.clear(); fpmtInfoVec.resize(fNChannelsPerBoard*fNBoards);
 
   _pmt_beam_trig = false;
   _pmt_time_trig = -9999;
@@ -213,17 +218,18 @@ void sbndaq::MetricProducer::produce(art::Event& evt)
   std::fill(_crt_hitsperplane, _crt_hitsperplane+7, 0);
 
   // get fragment handles
+  // (the fragments are only read, through references, not copied)
   std::vector<art::Handle<artdaq::Fragments>> fragmentHandles = evt.getMany<std::vector<artdaq::Fragment>>();
 
   num_crt_frags = 0;
   num_pmt_frags = 0;
   // loop over fragment handles
-  for (auto handle : fragmentHandles) {
+  for (auto const& handle : fragmentHandles) {
     if (!handle.isValid() || handle->size() == 0) continue;
 
     if (handle->front().type() == artdaq::Fragment::ContainerFragmentType) {
       // container fragment
-      for (auto cont : *handle) {
+      for (auto const& cont : *handle) {
         artdaq::ContainerFragment contf(cont);
         if (contf.fragment_type() == sbndaq::detail::FragmentType::BERNCRTV2){
           if (fVerbose)     std::cout << "    Found " << contf.block_count() << " CRT Fragments in container " << std::endl;
@@ -236,7 +242,7 @@ void sbndaq::MetricProducer::produce(art::Event& evt)
     else {
       // normal fragment
       size_t beamFragmentIdx = -1;
-      for (auto frag : *handle){
+      for (auto const& frag : *handle){
         beamFragmentIdx++;
         if (frag.type()==sbndaq::detail::FragmentType::BERNCRTV2) {
           num_crt_frags++;
@@ -254,7 +260,7 @@ void sbndaq::MetricProducer::produce(art::Event& evt)
               checkCAEN1730FragmentTimeStamp(frag);//handle->at(fragmentIdx));
               // if set of fragment in time with beam found, process waveforms
               if (foundBeamTrigger && beamFragmentIdx != 9999) {
-                for (size_t fragmentIdx = beamFragmentIdx; fragmentIdx < beamFragmentIdx+8; fragmentIdx++) {
+                for (size_t fragmentIdx = beamFragmentIdx; fragmentIdx < beamFragmentIdx+fNBoards; fragmentIdx++) {
                   analyzeCAEN1730Fragment(handle->at(fragmentIdx));
                 }
                 fWvfmsFound = true;
@@ -307,14 +313,17 @@ void sbndaq::MetricProducer::produce(art::Event& evt)
       int beamStartBin = (triggerTimeStamp >= 1000)? 0 : int(500 - abs((triggerTimeStamp-1000)/2));
       int beamEndBin   = (triggerTimeStamp >= 1000)? int(500 + (fBeamWindowLength*1e3 - triggerTimeStamp)/2) : (beamStartBin + (fBeamWindowLength*1e3)/2);
 
-      // wvfm loop to calculate metrics
-      for (int i_ch = 0; i_ch < 120; ++i_ch){
+      // wvfm loop to calculate metrics, reading the samples in place
+      for (size_t i_ch = 0; i_ch < fWvfmsVec.size(); ++i_ch){
         auto &pmtInfo = fpmtInfoVec.at(i_ch);
-        auto wvfm = fWvfmsVec[i_ch];
+        const uint16_t* wvfm = fWvfmsVec[i_ch];
 
         // assign channel
         pmtInfo.channel = channelList.at(i_ch);
 
+        // no fragment for this board
+        if (wvfm == nullptr) continue;
+
         // calculate baseline
         if (fCalculateBaseline) estimateBaseline(i_ch);
         else { pmtInfo.baseline=fInputBaseline.at(0); pmtInfo.baselineSigma = fInputBaseline.at(1); }
@@ -326,23 +335,21 @@ void sbndaq::MetricProducer::produce(art::Event& evt)
             if (adc < fADCThreshold){ nAboveThreshold++; break; } 
           }
         }
-        else nAboveThreshold=-9999;
 
         // quick estimate prompt and preliminary light, assuming sampling rate of 500 MHz (2 ns per bin)
         if (fCalculatePEMetrics){
           double baseline = pmtInfo.baseline;
-          auto prompt_window = std::vector<uint16_t>(wvfm.begin()+500, wvfm.begin()+1000);
-          auto prelim_window = std::vector<uint16_t>(wvfm.begin()+beamStartBin, wvfm.begin()+500);
           if (fFindPulses == false){
-            double ch_promptPE = (baseline-(*std::min_element(prompt_window.begin(), prompt_window.end())))/8;
-            double ch_prelimPE = (baseline-(*std::min_element(prelim_window.begin(), prelim_window.end())))/8;
+            // prompt window: bins 500 to 1000, preliminary window: beam start to bin 500
+            double ch_promptPE = (baseline-(*std::min_element(wvfm+500, wvfm+1000)))/8;
+            double ch_prelimPE = (baseline-(*std::min_element(wvfm+beamStartBin, wvfm+500)))/8;
             promptPE += ch_promptPE;
             prelimPE += ch_prelimPE;
           }
           // pulse finder + prompt and prelim calculation with pulses
           if (fFindPulses == true){
             SimpleThreshAlgo(i_ch);
-            for (auto pulse : pmtInfo.pulseVec){
+            for (auto const& pulse : pmtInfo.pulseVec){
               if (pulse.t_start > 500 && pulse.t_end < 550) promptPE+=pulse.pe;
               if ((triggerTimeStamp) >= 1000){ if (pulse.t_end < 500) prelimPE+=pulse.pe; }
               else if (triggerTimeStamp < 1000){
@@ -352,6 +359,7 @@ void sbndaq::MetricProducer::produce(art::Event& evt)
           }
         } 
       } // end of wvfm loop
+      if (!fCountPMTs) nAboveThreshold=-9999;
 
       pmt_metrics.nAboveThreshold = nAboveThreshold;    
       pmt_metrics.promptPE = promptPE;
@@ -390,7 +398,7 @@ void sbndaq::MetricProducer::produce(art::Event& evt)
 
 
 
-void sbndaq::MetricProducer::analyze_crt_fragment(artdaq::Fragment & frag)
+void sbndaq::MetricProducer::analyze_crt_fragment(const artdaq::Fragment & frag)
 {
 
   sbndaq::BernCRTFragmentV2 bern_fragment(frag);
@@ -448,56 +456,49 @@ void sbndaq::MetricProducer::checkCAEN1730FragmentTimeStamp(const artdaq::Fragme
 
 void sbndaq::MetricProducer::analyzeCAEN1730Fragment(const artdaq::Fragment &frag) {
 
-  // access fragment ID; index of fragment out of set of 8 fragments
-  int fragId = static_cast<int>(frag.fragmentID());
+  // access fragment ID; index of fragment out of set of fragments
+  size_t fragId = frag.fragmentID();
+  if (fragId >= fNBoards) {
+    std::cout << "Unexpected CAEN V1730 fragment ID " << fragId << ", expected fewer than " << fNBoards << std::endl;
+    return;
+  }
 
-  // access waveforms in fragment and save
+  // access waveforms in fragment: the samples of each channel follow each other
   const uint16_t* data_begin = reinterpret_cast<const uint16_t*>(frag.dataBeginBytes()
                  + sizeof(sbndaq::CAENV1730EventHeader));
-  const uint16_t* value_ptr =  data_begin;
-  uint16_t value = 0;
 
-  // channel offset
-  size_t nChannels = 15; // 15 pmts per fragment
-  size_t ch_offset = 0;
-
-  // loop over channels
-  for (size_t i_ch = 0; i_ch < nChannels; ++i_ch){
-    fWvfmsVec[i_ch + nChannels*fragId].resize(fWvfmLength);
-    ch_offset = (size_t)(i_ch * fWvfmLength);
-    //--loop over waveform samples
-    for(size_t i_t = 0; i_t < fWvfmLength; ++i_t){
-      value_ptr = data_begin + ch_offset + i_t; // pointer arithmetic
-      value = *(value_ptr);
-      fWvfmsVec[i_ch + nChannels*fragId][i_t] = value;
-    } //--end loop samples
+  // loop over channels, keeping where their samples start
+  for (size_t i_ch = 0; i_ch < fNChannelsPerBoard; ++i_ch){
+    fWvfmsVec[i_ch + fNChannelsPerBoard*fragId] = data_begin + i_ch * fWvfmLength;
   } //--end loop channels
 }//analyze caen 1730 fragment
 
 void sbndaq::MetricProducer::estimateBaseline(int i_ch){
-  auto wvfm = fWvfmsVec[i_ch];
+  const uint16_t* wvfm = fWvfmsVec[i_ch];
   auto &pmtInfo = fpmtInfoVec[i_ch];
   // assuming that the first 500 ns doesn't include peaks, find the mean of the ADC count as the baseline
-  std::vector<uint16_t> subset = std::vector<uint16_t>(wvfm.begin(), wvfm.begin()+250);
-  double subset_mean = (std::accumulate(subset.begin(), subset.end(), 0))/(subset.size());
+  const uint16_t* subset = wvfm;
+  size_t subset_size = 250;
+  double subset_mean = (std::accumulate(subset, subset+subset_size, 0))/(subset_size);
   double val = 0;
-  for (size_t i=0; i<subset.size();i++){ val += (subset[i] - subset_mean)*(subset[i] - subset_mean);}
-  double subset_stddev = sqrt(val/subset.size());
+  for (size_t i=0; i<subset_size;i++){ val += (subset[i] - subset_mean)*(subset[i] - subset_mean);}
+  double subset_stddev = sqrt(val/subset_size);
 
   // if the first 500 ns seem to be messy, use the last 500
   if (subset_stddev > 3){ // make this fcl parameter?
-    val = 0; subset.clear(); subset_stddev = 0;
-    subset = std::vector<uint16_t>(wvfm.end()-500, wvfm.end());
-    subset_mean = (std::accumulate(subset.begin(), subset.end(), 0))/(subset.size());
-    for (size_t i=0; i<subset.size();i++){ val += (subset[i] - subset_mean)*(subset[i] - subset_mean);}
-    subset_stddev = sqrt(val/subset.size());
+    val = 0; subset_stddev = 0;
+    subset = wvfm + fWvfmLength - 500;
+    subset_size = 500;
+    subset_mean = (std::accumulate(subset, subset+subset_size, 0))/(subset_size);
+    for (size_t i=0; i<subset_size;i++){ val += (subset[i] - subset_mean)*(subset[i] - subset_mean);}
+    subset_stddev = sqrt(val/subset_size);
   }
   pmtInfo.baseline = subset_mean;
   pmtInfo.baselineSigma = subset_stddev;
 }//estimateBaseline
 
 void sbndaq::MetricProducer::SimpleThreshAlgo(int i_ch){
-  auto wvfm = fWvfmsVec[i_ch];
+  const uint16_t* wvfm = fWvfmsVec[i_ch];
   auto &pmtInfo = fpmtInfoVec[i_ch];
   double baseline = pmtInfo.baseline;
   double baseline_sigma = pmtInfo.baselineSigma;
@@ -515,7 +516,8 @@ void sbndaq::MetricProducer::SimpleThreshAlgo(int i_ch){
   std::vector<sbnd::trigger::pmtPulse> pulse_vec;
   sbnd::trigger::pmtPulse pulse;
   pulse.area = 0; pulse.peak = 0; pulse.t_start = 0; pulse.t_end = 0; pulse.t_peak = 0;
-  for (auto const &adc : wvfm){
+  for (const uint16_t* adc_ptr = wvfm; adc_ptr != wvfm + fWvfmLength; ++adc_ptr){
+    const uint16_t adc = *adc_ptr;
     if ( !fire && ((double)adc) <= start_threshold ){ // if its a new pulse
       fire = true;
       //vic: i move t_start back one, this helps with porch
@@ -525,7 +527,7 @@ void sbndaq::MetricProducer::SimpleThreshAlgo(int i_ch){
     if( fire && ((double)adc) > end_threshold ){ // found end of a pulse
       fire = false;
       //vic: i move t_start forward one, this helps with tail
-      pulse.t_end = counter < ((int)wvfm.size())  ? counter : counter - 1;
+      pulse.t_end = counter < ((int)fWvfmLength)  ? counter : counter - 1;
       pulse_vec.push_back(pulse);
       pulse.area = 0; pulse.peak = 0; pulse.t_start = 0; pulse.t_end = 0; pulse.t_peak = 0;
     }
@@ -547,9 +549,9 @@ void sbndaq::MetricProducer::SimpleThreshAlgo(int i_ch){
     pulse.area = 0; pulse.peak = 0; pulse.t_start = 0; pulse.t_end = 0; pulse.t_peak = 0;
   }
 
-  pmtInfo.pulseVec = pulse_vec;
   // calculate PE from area
-  for (auto &pulse : pmtInfo.pulseVec){pulse.pe = pulse.area/fPEArea;}
+  for (auto &pulse : pulse_vec){pulse.pe = pulse.area/fPEArea;}
+  pmtInfo.pulseVec = std::move(pulse_vec);
 }//SimpleThreshAlgo
 
 
@@ -0,0 +1,217 @@
+#ifndef SBND_PMTTRIGGERBINARYWAVEFORM_H
+#define SBND_PMTTRIGGERBINARYWAVEFORM_H
+/*
+ File:    pmtTriggerBinaryWaveform.h
+ Purpose: Bit-packed binary waveforms for the PMT hardware trigger emulation
+
+ The steps of the pmtTriggerProducer trigger logic working on binary
+ waveforms (0=not above threshold, 1=above threshold): downsampling by 4,
+ pairing, extension after a rising edge and the count of waveforms above
+ threshold in the trigger window, as well as the threshold levels of the
+ threshold scan. Waveforms are packed 64 ticks per word,
+ so each step works on a word at a time.
+
+ See test/Trigger/pmt_trigger_binary_waveform_test.cxx for the comparison
+ with the former one-tick-per-char implementation and with a threshold
+ by threshold scan.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sbnd::trigger {
+
+   // binary waveform packed 64 ticks per word: tick i is bit i%64 of word i/64,
+   // bits past the last tick are always 0
+   struct BinaryWaveform {
+      std::vector<uint64_t> words;
+      size_t size = 0;
+
+      explicit BinaryWaveform(size_t n = 0): words((n + 63) / 64, 0), size(n) {}
+
+      void grow(size_t n) { if (n > size) { words.resize((n + 63) / 64, 0); size = n; } }
+
+      bool test(size_t i) const { return (words[i / 64] >> (i % 64)) & 1; }
+
+      void set(size_t i) { words[i / 64] |= uint64_t(1) << (i % 64); }
+
+      // the 64 ticks starting at tick pos
+      uint64_t getWord(size_t pos) const {
+         const size_t w = pos / 64, s = pos % 64;
+         uint64_t bits = w < words.size() ? words[w] >> s : 0;
+         if (s && w + 1 < words.size()) bits |= words[w + 1] << (64 - s);
+         return bits;
+      }
+
+      // ORs the 64 ticks in bits starting at tick pos
+      void orWord(size_t pos, uint64_t bits) {
+         const size_t w = pos / 64, s = pos % 64;
+         words[w] |= bits << s;
+         if (s && w + 1 < words.size()) words[w + 1] |= bits >> (64 - s);
+      }
+
+      // sets ticks [first, last)
+      void setRange(size_t first, size_t last) {
+         for (size_t i = first; i < last; ) {
+            const size_t s = i % 64;
+            const size_t n = std::min<size_t>(64 - s, last - i);
+            const uint64_t mask = n == 64 ? ~uint64_t(0) : ((uint64_t(1) << n) - 1);
+            words[i / 64] |= mask << s;
+            i += n;
+         }
+      }
+   };
+
+   // keeps ticks 0, 4, 8, ...: the 16 kept bits of each word are gathered
+   // into the low bits with shifts and masks
+   inline BinaryWaveform Downsample4(const BinaryWaveform& wvf)
+   {
+      BinaryWaveform down((wvf.size + 3) / 4);
+      for (size_t i = 0; i < wvf.words.size(); i++) {
+         uint64_t x = wvf.words[i] & 0x1111111111111111ULL;
+         x = (x | (x >> 3)) & 0x0303030303030303ULL;
+         x = (x | (x >> 6)) & 0x000F000F000F000FULL;
+         x = (x | (x >> 12)) & 0x000000FF000000FFULL;
+         x = (x | (x >> 24)) & 0x000000000000FFFFULL;
+         down.words[i / 4] |= x << (16 * (i % 4));
+      }
+      return down;
+   }
+
+   // pairs wvf with the waveform of its partner channel, tick by tick
+   inline BinaryWaveform Combine(const BinaryWaveform& partner, const BinaryWaveform& wvf, bool useAND)
+   {
+      BinaryWaveform combined(wvf.size);
+      for (size_t i = 0; i < wvf.words.size(); i++) {
+         const uint64_t other = i < partner.words.size() ? partner.words[i] : 0;
+         combined.words[i] = useAND ? (wvf.words[i] & other) : (wvf.words[i] | other);
+      }
+      return combined;
+   }
+
+   // first tick in [from, end) where wvf goes from 0 to 1, end if there is none
+   inline size_t NextRisingEdge(const BinaryWaveform& wvf, size_t from, size_t end)
+   {
+      for (size_t w = from / 64; w * 64 < end; w++) {
+         const uint64_t prev = w ? wvf.words[w - 1] >> 63 : 0;
+         uint64_t edges = wvf.words[w] & ~((wvf.words[w] << 1) | prev);
+         if (w == from / 64) edges &= ~uint64_t(0) << (from % 64);
+         if (edges) return std::min<size_t>(w * 64 + __builtin_ctzll(edges), end);
+      }
+      return end;
+   }
+
+   // every time the waveform transitions from 0 to 1 (at ticks 1 to size-width-1),
+   // sets the next width ticks to 1; transitions inside an extension are not
+   // rising edges, so the search resumes after it
+   inline void ExtendOverThreshold(BinaryWaveform& wvf, size_t width)
+   {
+      if (wvf.size <= width) return;
+      const size_t end = wvf.size - width;
+      for (size_t i = NextRisingEdge(wvf, 1, end); i < end; i = NextRisingEdge(wvf, i + width + 1, end)) {
+         wvf.setRange(i + 1, i + width + 1);
+      }
+   }
+
+   // number of waveforms on at each tick of the trigger window, kept as a
+   // bit-sliced adder: word w of plane k holds bit k of the counts of ticks
+   // 64*w to 64*w+63, so one waveform word is added with a few bitwise operations
+   class MultiplicityCounter {
+   public:
+      // adds ticks [first, first+n) of wvf as window ticks [0, n)
+      void add(const BinaryWaveform& wvf, size_t first, size_t n) {
+         fNTicks = std::max(fNTicks, n);
+         const size_t nWords = (n + 63) / 64;
+         if (nWords > fNWords) {
+            fNWords = nWords;
+            for (auto& plane : fPlanes) plane.resize(fNWords, 0);
+         }
+         for (size_t w = 0; w < nWords; w++) {
+            uint64_t carry = wvf.getWord(first + 64 * w);
+            if (n - 64 * w < 64) carry &= (uint64_t(1) << (n - 64 * w)) - 1;
+            for (size_t k = 0; carry; k++) {
+               if (k == fPlanes.size()) fPlanes.emplace_back(fNWords, 0);
+               uint64_t& plane = fPlanes[k][w];
+               const uint64_t sum = plane ^ carry;
+               carry &= plane;
+               plane = sum;
+            }
+         }
+      }
+
+      // number of window ticks added so far
+      size_t size() const { return fNTicks; }
+
+      int count(size_t i) const {
+         if (i / 64 >= fNWords) return 0;
+         int n = 0;
+         for (size_t k = 0; k < fPlanes.size(); k++) n |= ((fPlanes[k][i / 64] >> (i % 64)) & 1) << k;
+         return n;
+      }
+
+   private:
+      size_t fNTicks = 0;
+      size_t fNWords = 0;
+      std::vector<std::vector<uint64_t>> fPlanes;
+   };
+
+
+   // threshold scan: the thresholds of a scan are sorted into levels, the
+   // distinct integer cuts in increasing order (ADC values are integer, so
+   // ADC < threshold is ADC < ceil(threshold))
+   inline std::vector<int> ScanLevels(const std::vector<double>& thresholds)
+   {
+      std::vector<int> levels;
+      for (double thr : thresholds) levels.push_back((int)std::ceil(thr));
+      std::sort(levels.begin(), levels.end());
+      levels.erase(std::unique(levels.begin(), levels.end()), levels.end());
+      return levels;
+   }
+
+   // level of each threshold
+   inline std::vector<size_t> ScanRanks(const std::vector<double>& thresholds, const std::vector<int>& levels)
+   {
+      std::vector<size_t> ranks;
+      for (double thr : thresholds) ranks.push_back(std::lower_bound(levels.begin(), levels.end(), (int)std::ceil(thr)) - levels.begin());
+      return ranks;
+   }
+
+   // look up table of the lowest level each 16 bit ADC value is below
+   // (levels.size() if none), so that a sample is tested once for all thresholds
+   inline std::vector<uint16_t> ScanLevelLUT(const std::vector<int>& levels)
+   {
+      std::vector<uint16_t> lut(65536);
+      for (size_t adc = 0; adc < lut.size(); adc++){
+         lut[adc] = std::upper_bound(levels.begin(), levels.end(), (int)adc) - levels.begin();
+      }
+      return lut;
+   }
+
+   // marks the samples of a waveform starting at tick n_before in the
+   // downsampled waveform of their level; only the ticks kept by Downsample4
+   // are needed
+   template<typename Samples>
+   void FillScanLevels(const std::vector<uint16_t>& lut, const Samples& wvf, size_t n_before,
+                       std::vector<BinaryWaveform>& levels)
+   {
+      for (size_t i = (4 - n_before % 4) % 4; i < wvf.size(); i += 4){
+         const size_t level = lut[wvf[i]];
+         if (level < levels.size()) levels[level].set((n_before + i) / 4);
+      }
+   }
+
+   // accumulates the levels: level L then holds the ticks below the L-th
+   // lowest cut, the downsampled binary waveform of the thresholds at that level
+   inline void AccumulateScanLevels(std::vector<BinaryWaveform>& levels)
+   {
+      for (size_t L = 1; L < levels.size(); L++){
+         for (size_t w = 0; w < levels[L].words.size(); w++) levels[L].words[w] |= levels[L-1].words[w];
+      }
+   }
+
+} // namespace sbnd::trigger
+
+#endif // SBND_PMTTRIGGERBINARYWAVEFORM_H
@@ -21,6 +21,7 @@
  - Pair waveforms -> combine 2 downsampled waveforms based on parameters set in fhicl files
  - Extend wavelength when a rising edge is seen
  - Count the number of paired waveforms above threshold for various times within the trigger window
+ Binary waveforms are packed 64 ticks per word, so each step works on a word at a time.
 
  Input:
  - output from OpDetSim module (in particular, OpDetWaveforms)
@@ -72,6 +73,7 @@
 #include "sbndcode/Utilities/SignalShapingServiceSBND.h"
 #include "sbndcode/OpDetSim/sbndPDMapAlg.hh"
 #include "sbnobj/SBND/Trigger/pmtTrigger.hh"
+#include "sbndcode/Trigger/PMT/pmtTriggerBinaryWaveform.h"
 
 // ROOT includes
 #include "TH1D.h"
@@ -82,9 +84,16 @@
 #include <algorithm>
 #include <vector>
 #include <cmath>
+#include <cstdint>
 #include <memory>
 #include <string>
 
+using sbnd::trigger::BinaryWaveform;
+using sbnd::trigger::Downsample4;
+using sbnd::trigger::Combine;
+using sbnd::trigger::ExtendOverThreshold;
+using sbnd::trigger::MultiplicityCounter;
+
 class pmtTriggerProducer: public art::EDProducer {
 public:
     // The destructor generated by the compiler is fine for classes
@@ -104,6 +113,7 @@ public:
 
 private:
    // Define producer-specific functions
+   void fillThresholdScan(std::vector<std::vector<BinaryWaveform>>& scan_levels, double minStartTime, double maxEndTime);
 
 
    // Define global variables
@@ -123,23 +133,20 @@ private:
 
    std::vector<int> passed_trigger; //index =time (us, triger window only), content = number of pmt pairs passed threshold
    int max_passed = 0; //maximum number of pmt pairs passing threshold at the same time within trigger window
-   std::vector<int> channel_numbers = {6,7,8,9,10,11,12,13,14,15,16,17,36,37,38,39,40,41,60,61,62,63,64,65,66,67,68,69,70,71,
-     84,85,86,87,88,89,90,91,92,93,94,95,114,115,116,117,118,119,138,139,140,141,142,143,144,145,146,147,148,149,
-     162,163,164,165,166,167,168,169,170,171,172,173,192,193,194,195,196,197,216,217,218,219,220,221,222,223,224,225,226,227,
-     240,241,242,243,244,245,246,247,248,249,250,251,270,271,272,273,274,275,294,295,296,297,298,299,300,301,302,303,304,305};
-   std::vector<std::vector<char>> channel_bin_wvfs;
-   std::vector<char> wvf_bin_0;
-   std::vector<char> paired;
-   std::vector<std::vector<char>> unpaired_wvfs;
+   std::vector<int> channel_numbers; //pmt (coated and uncoated) channel numbers from the pd map, lowest to highest
+   std::vector<int> fChannelIndex; //index in channel_numbers of each opdet channel, -1 if not a pmt
+   std::vector<int> fPairIndex; //index in Pair1/Pair2 of each opdet channel, -1 if not paired
+   std::vector<char> fIsUnpaired; //1 if the opdet channel is in Unpaired
 
    // List parameters for the fcl file
    std::vector<double> fThreshold = {7960.0,7976.0}; //individual pmt threshold in ADC (set in fcl, passes if ADC is LESS THAN threshold), [coated, uncoated]
    bool fIndividualThresholds;
    int fOVTHRWidth;//over-threshold width, page 40 of manual (set in fcl)
-   std::vector<int> fPair1 = {6,8,10,12,14,16,36,38,40,84,86,88,90,92,94,114,116,118,138,140,142,144,146,148,162,164,166,168,170,172,192,194,196,216,218,220,222,224,226,240,242,244,246,248,250,270,272,274,294,296}; //channel numbers for first set of paired pmts (set in fcl)
-   std::vector<int> fPair2 = {7,9,11,13,15,17,37,39,41,85,87,89,91,93,95,115,117,119,139,141,143,145,147,149,163,165,167,169,171,173,193,195,197,217,219,221,223,225,227,241,243,245,247,249,251,271,273,275,295,297}; //channel numbers for second set of paired pmts (set in fcl)
-   std::vector<int> fUnpaired = {298,299,300,301,302,303,304,305};//channel numbers for unpired pmts (set in fcl)
+   std::vector<int> fPair1; //channel numbers for first set of paired pmts (set in fcl)
+   std::vector<int> fPair2; //channel numbers for second set of paired pmts (set in fcl)
+   std::vector<int> fUnpaired; //channel numbers for unpired pmts (set in fcl)
    std::string fPairLogic;
+   bool fPairAND; //true if fPairLogic is "AND"
    double fWindowStart; //start time (in us) of trigger window (set in fcl, 0 for beam spill)
    double fWindowEnd; //end time (in us) of trigger window (set in fcl, 1.6 for beam spill)
    std::string fInputModuleName; //opdet waveform module name (set in fcl)
@@ -148,6 +155,19 @@ private:
    std::vector<int> fEvHists = {1,2,3}; //if fSaveHists=true, which event hists to save? (set in fcl)
    bool fVerbose; //true=output all cout statements, false=no non-error cout statements (set in fcl)
 
+   // threshold scan, evaluated in the same pass over the waveforms
+   std::vector<std::vector<double>> fScanThresholds; //[coated, uncoated] (or one for both) ADC thresholds to scan (set in fcl, empty for no scan)
+   std::vector<std::vector<double>> fScanWindows; //[start, end] (us) trigger windows to scan (set in fcl, default the trigger window)
+   std::vector<int> fScanMultiplicities; //numbers of pmt pairs to form a trigger with (set in fcl)
+   std::vector<char> fIsUncoated; //1 if channel_numbers entry is a pmt_uncoated
+   std::vector<uint16_t> fScanLevelLUT[2]; //[coated, uncoated] lowest threshold level an ADC value is below
+   std::vector<size_t> fScanRank[2]; //[coated, uncoated] threshold level of each scan threshold
+   size_t fScanNLevels[2]; //[coated, uncoated] number of distinct scan thresholds
+   TTree* fScanTree = nullptr;
+   int fScanRun, fScanSubRun, fScanEvent;
+   std::vector<int> fScanMaxPassed; //index = threshold*nwindows + window
+   std::vector<double> fScanTriggerTime; //index = (threshold*nwindows + window)*nmultiplicities + multiplicity, -9999 if no trigger
+
    // services
    art::ServiceHandle<art::TFileService> tfs;
 
@@ -160,7 +180,41 @@ pmtTriggerProducer::pmtTriggerProducer(fhicl::ParameterSet const & p)
 
    auto const clockData = art::ServiceHandle<detinfo::DetectorClocksService const>()->DataForJob();
    fSampling = clockData.OpticalClock().Frequency(); // MHz
+
+   // the trigger is formed from all the pmts in the pd map
+   channel_numbers = pdMap.getChannelsOfType("pmt_coated");
+   for (int ch : pdMap.getChannelsOfType("pmt_uncoated")) channel_numbers.push_back(ch);
+   std::sort(channel_numbers.begin(), channel_numbers.end());
+
+   fChannelIndex.assign(pdMap.size(), -1);
+   for (size_t i = 0; i < channel_numbers.size(); i++) fChannelIndex.at(channel_numbers[i]) = i;
+
+   fIsUncoated.resize(channel_numbers.size());
+   for (size_t i = 0; i < channel_numbers.size(); i++) fIsUncoated[i] = (pdMap.pdType(channel_numbers[i]) == "pmt_uncoated");
+
    this->reconfigure(p);
+
+   if (!fScanThresholds.empty()){
+      // the scan configuration, the entries of the per event table follow its order
+      TTree* config = tfs->make<TTree>("threshold_scan_config", "Threshold scan configuration");
+      std::vector<double> thr_coated, thr_uncoated, win_start, win_end;
+      for (auto const& thr : fScanThresholds){ thr_coated.push_back(thr.front()); thr_uncoated.push_back(thr.back()); }
+      for (auto const& win : fScanWindows){ win_start.push_back(win[0]); win_end.push_back(win[1]); }
+      config->Branch("threshold_coated", &thr_coated);
+      config->Branch("threshold_uncoated", &thr_uncoated);
+      config->Branch("window_start", &win_start);
+      config->Branch("window_end", &win_end);
+      config->Branch("multiplicity", &fScanMultiplicities);
+      config->Fill();
+      config->ResetBranchAddresses();
+
+      fScanTree = tfs->make<TTree>("threshold_scan", "Threshold scan");
+      fScanTree->Branch("run", &fScanRun, "run/I");
+      fScanTree->Branch("subrun", &fScanSubRun, "subrun/I");
+      fScanTree->Branch("event", &fScanEvent, "event/I");
+      fScanTree->Branch("max_passed", &fScanMaxPassed);
+      fScanTree->Branch("trigger_time", &fScanTriggerTime);
+   }
 }
 
 // Constructor
@@ -181,7 +235,52 @@ void pmtTriggerProducer::reconfigure(fhicl::ParameterSet const & p)
    fSaveHists = p.get<bool>("SaveHists",true);
    fEvHists    = p.get<std::vector<int> >("EvHists");
    fVerbose = p.get<bool>("Verbose", true);
+   fScanThresholds = p.get<std::vector<std::vector<double>> >("ScanThresholds", {});
+   fScanWindows = p.get<std::vector<std::vector<double>> >("ScanWindows", {{fWindowStart, fWindowEnd}});
+   fScanMultiplicities = p.get<std::vector<int> >("ScanMultiplicities", {});
+
+   if (fPairLogic != "OR" && fPairLogic != "AND"){
+      throw cet::exception("pmtTriggerProducer") << "PairLogic must be \"OR\" or \"AND\", not \"" << fPairLogic << "\"\n";
+   }
+   fPairAND = (fPairLogic == "AND");
+
+   for (auto const& thr : fScanThresholds){
+      if (thr.empty() || thr.size() > 2){
+         throw cet::exception("pmtTriggerProducer") << "ScanThresholds entries must be [coated, uncoated] or [threshold]\n";
+      }
+   }
+   for (auto const& win : fScanWindows){
+      if (win.size() != 2){
+         throw cet::exception("pmtTriggerProducer") << "ScanWindows entries must be [start, end]\n";
+      }
+   }
+
+   // the scan thresholds of each pmt type are sorted into levels, and a look up
+   // table gives the lowest level an ADC value is below
+   for (size_t t = 0; t < 2; t++){
+      std::vector<double> thresholds;
+      for (auto const& thr : fScanThresholds) thresholds.push_back(thr.at(std::min(t, thr.size()-1)));
+      const std::vector<int> levels = sbnd::trigger::ScanLevels(thresholds);
+      fScanNLevels[t] = levels.size();
+      fScanRank[t] = sbnd::trigger::ScanRanks(thresholds, levels);
+      fScanLevelLUT[t] = sbnd::trigger::ScanLevelLUT(levels);
+   }
 
+   if (fPair2.size()!=fPair1.size()){std::cout<<"Pair lists mismatched sizes!"<<std::endl;}
+
+   // look up tables from opdet channel to its pairing, a channel is looked for
+   // in Unpaired first, then in Pair1 and then in Pair2
+   fPairIndex.assign(pdMap.size(), -1);
+   fIsUnpaired.assign(pdMap.size(), 0);
+   for (int ch : fUnpaired){
+      if (ch >= 0 && ch < (int)pdMap.size()) fIsUnpaired[ch] = 1;
+   }
+   for (auto const* pairs : {&fPair2, &fPair1}){
+      for (size_t i = std::min(pairs->size(), fPair1.size()); i-- > 0; ){
+         const int ch = pairs->at(i);
+         if (ch >= 0 && ch < (int)pdMap.size()) fPairIndex[ch] = i;
+      }
+   }
 }
 
 void pmtTriggerProducer::produce(art::Event & e)
@@ -260,39 +359,38 @@ void pmtTriggerProducer::produce(art::Event & e)
   }
   if (fVerbose){std::cout<<"MinStartTime: "<<fMinStartTime<<" MaxEndTime: "<<fMaxEndTime<<std::endl;}
 
-   wvf_bin_0.reserve(int((fMaxEndTime-fMinStartTime)/(1./fSampling)));
-   channel_bin_wvfs.reserve(120);
-   paired.reserve(fPair1.size());
-   unpaired_wvfs.reserve(fPair1.size());
-   passed_trigger.reserve(int((fWindowEnd-fWindowStart)/(4./fSampling)));
-
-  // create a vector w/ the number of entries necessary for the sampling rate
+  // the number of entries necessary for the sampling rate
   // e.g. if sampling rate is 500 MHz, each bin has width of 0.002 us or 2 ns, vector length of ~75000
+   size_t n_ticks = 0;
    for (double i = fMinStartTime; i<fMaxEndTime+(1./fSampling); i+=(1./fSampling)){
-      wvf_bin_0.push_back(0);
-   }
-   for (size_t i = 0; i<120; i++){
-      channel_bin_wvfs.push_back(wvf_bin_0);
+      n_ticks++;
    }
-   for (size_t i = 0; i<fPair1.size(); i++){
-      paired.push_back(0);
-   }
-   for (size_t i = 0; i<fPair1.size(); i++){
-      unpaired_wvfs.push_back(wvf_bin_0);
+   std::vector<BinaryWaveform> channel_bin_wvfs(channel_numbers.size(), BinaryWaveform(n_ticks));
+   std::vector<char> paired(fPair1.size(), 0);
+   std::vector<BinaryWaveform> unpaired_wvfs(fPair1.size());
+
+  // for the threshold scan, the downsampled ticks of each channel below each threshold level
+   std::vector<std::vector<BinaryWaveform>> scan_levels;
+   if (!fScanThresholds.empty()){
+      for (size_t i = 0; i < channel_numbers.size(); i++){
+         scan_levels.emplace_back(fScanNLevels[fIsUncoated[i]], BinaryWaveform((n_ticks + 3) / 4));
+      }
    }
+
   // window of the beam spill, 0.0 to 1.6 us
   // e.g. if sampling rate is 500 MHz, each bin has width of 0.008 us or 8 ns
+   size_t n_window = 0;
    for (double i = fWindowStart; i<fWindowEnd+(4./fSampling); i+=(4./fSampling)){
-      passed_trigger.push_back(0);
+      n_window++;
    }
 
+  // number of ticks needed to cover dt (us)
+   auto ticksFor = [this](double dt) -> size_t {
+      return dt > 0. ? size_t(std::ceil(dt * fSampling - 1e-6)) : 0;
+   };
 
-   if (fPair2.size()!=paired.size()){std::cout<<"Pair lists mismatched sizes!"<<std::endl;}
-
-   size_t wvf_id = -1;
    int hist_id = -1;
    for(auto const& wvf : (*waveHandle)) {
-      wvf_id++;
       hist_id++;
       fChNumber = wvf.ChannelNumber();
       opdetType = pdMap.pdType(fChNumber);
@@ -318,9 +416,6 @@ void pmtTriggerProducer::produce(art::Event & e)
     }
     // if(fVerbose){std::cout<<"Channel "<<fChNumber<<" is "<<opdetType<<" and is using theshold "<<adc_threshold<<" ADC."<<std::endl;}
 
-      //create binary waveform
-      std::vector<char> wvf_bin;
-      wvf_bin.reserve(wvf.size());
       // start histo
       if (i_ev!=-1 && i_ev<3){
          histname.str(std::string());
@@ -337,58 +432,51 @@ void pmtTriggerProducer::produce(art::Event & e)
          }
       } // end histo
 
-      if (fStartTime > fMinStartTime){
-         for (double i = fStartTime-fMinStartTime; i>0.; i-=(1./fSampling)){
-            wvf_bin.push_back(0);
-         }
-      }
-
-      for(unsigned int i = 0; i < wvf.size(); i++) {
-         if((double)wvf[i]<adc_threshold){wvf_bin.push_back(1);}else{wvf_bin.push_back(0);}
-      }
+      // the waveform is padded with 0s to span from fMinStartTime to fMaxEndTime
+      const size_t n_before = (fStartTime > fMinStartTime) ? ticksFor(fStartTime-fMinStartTime) : 0;
+      const size_t n_after = (fEndTime < fMaxEndTime) ? ticksFor(fMaxEndTime-fEndTime) : 0;
+      const size_t bin_size = n_before + wvf.size() + n_after;
 
-      if (fEndTime < fMaxEndTime){
-         for (double i = fMaxEndTime-fEndTime; i>0.; i-=(1./fSampling)){
-            wvf_bin.push_back(0);
+      //combine wavform with any other waveforms from same channel
+      const int i_ch = fChannelIndex.at(fChNumber);
+      BinaryWaveform& wvf_bin = channel_bin_wvfs.at(i_ch);
+      // if the number of bins is mismatched
+      if (wvf_bin.size < bin_size){
+         std::cout<<"Previous Channel" << fChNumber <<" Size: "<<wvf_bin.size<<"New Channel" << fChNumber <<" Size: "<<bin_size<<std::endl;
+         wvf_bin.grow(bin_size);
+         if (!scan_levels.empty()){
+            for (auto& level : scan_levels.at(i_ch)) level.grow((bin_size + 3) / 4);
          }
       }
 
-       //combine wavform with any other waveforms from same channel
-      int i_ch = -1.;
-      auto ich = std::find(channel_numbers.begin(), channel_numbers.end(), fChNumber);
-      if (ich != channel_numbers.end()){
-         i_ch = ich - channel_numbers.begin(); // the index for the channel of interest
-      }
-      // if the number of bins is mismatched
-      if (channel_bin_wvfs.at(i_ch).size() < wvf_bin.size()){
-	       std::cout<<"Previous Channel" << fChNumber <<" Size: "<<channel_bin_wvfs.at(i_ch).size()<<"New Channel" << fChNumber <<" Size: "<<wvf_bin.size()<<std::endl;
-         for(unsigned int i = channel_bin_wvfs.at(i_ch).size(); i < wvf_bin.size(); i++) {
-            channel_bin_wvfs.at(i_ch).push_back(0);
+      //create binary waveform, 64 ticks at a time (adc values are integer, so ADC < threshold is ADC < ceil(threshold))
+      const int adc_cut = std::ceil(adc_threshold);
+      for (size_t i0 = 0; i0 < wvf.size(); i0 += 64){
+         const size_t n = std::min<size_t>(64, wvf.size() - i0);
+         uint64_t bits = 0;
+         for (size_t k = 0; k < n; k++){
+            bits |= uint64_t((int)wvf[i0 + k] < adc_cut) << k;
          }
+         if (bits) wvf_bin.orWord(n_before + i0, bits);
       }
-      for(unsigned int i = 0; i < wvf_bin.size(); i++) {
-         if(channel_bin_wvfs.at(i_ch).at(i)==1 || wvf_bin[i]==1){channel_bin_wvfs.at(i_ch)[i]=1;}else{channel_bin_wvfs.at(i_ch)[i]=0;}
+
+      //threshold scan, only the ticks kept by the downsampling are needed
+      if (!scan_levels.empty()){
+         sbnd::trigger::FillScanLevels(fScanLevelLUT[fIsUncoated.at(i_ch)], wvf, n_before, scan_levels.at(i_ch));
       }
-      wvf_bin.clear();
-      wvf_bin.shrink_to_fit();
-      waveHandle.clear();
 
    }//wave handle loop
 
-     int wvf_num = -1;
+     MultiplicityCounter counter;
 
-     for (auto wvf_bin : channel_bin_wvfs){ // wvf_bin is a vector with entries making up the wvf, one for every channel
-       wvf_num++;
+     for (size_t wvf_num = 0; wvf_num < channel_bin_wvfs.size(); wvf_num++){ // one binary waveform for every channel
+       const BinaryWaveform& wvf_bin = channel_bin_wvfs[wvf_num];
        fChNumber = channel_numbers.at(wvf_num);
        fStartTime = fMinStartTime;
        fEndTime = fMaxEndTime;
 
        //downscale binary waveform by 4
-       std::vector<char> wvf_bin_down;
-       wvf_bin_down.reserve(int(wvf_bin.size()/4));
-       for(unsigned int i = 0; i < wvf_bin.size(); i++) {
-         if(i%4==0){wvf_bin_down.push_back(wvf_bin[i]);}
-       }
+       BinaryWaveform wvf_bin_down = Downsample4(wvf_bin);
 
        num_pmt_ch++;
 
@@ -397,10 +485,10 @@ void pmtTriggerProducer::produce(art::Event & e)
        histname2 << "event_" << fEvNumber
                 << "_opchannel_" << fChNumber
                 << "_binary";
-       TH1D *wvfbHist = tfs->make< TH1D >(histname2.str().c_str(), "Binary Waveform", wvf_bin.size(), fStartTime, fEndTime);
+       TH1D *wvfbHist = tfs->make< TH1D >(histname2.str().c_str(), "Binary Waveform", wvf_bin.size, fStartTime, fEndTime);
        wvfbHist->GetXaxis()->SetTitle("t (#mus)");
-       for(unsigned int i = 0; i < wvf_bin.size(); i++) {
-         wvfbHist->SetBinContent(i + 1, wvf_bin[i]);
+       for(unsigned int i = 0; i < wvf_bin.size; i++) {
+         wvfbHist->SetBinContent(i + 1, wvf_bin.test(i));
        }
      }
 
@@ -410,57 +498,33 @@ void pmtTriggerProducer::produce(art::Event & e)
                 << "_opchannel_" << fChNumber
                 << "_binary_down";
 
-       TH1D *wvfbdHist = tfs->make< TH1D >(histname2.str().c_str(), "Downsampled Binary Waveform", wvf_bin_down.size(), fStartTime, fEndTime);
+       TH1D *wvfbdHist = tfs->make< TH1D >(histname2.str().c_str(), "Downsampled Binary Waveform", wvf_bin_down.size, fStartTime, fEndTime);
        wvfbdHist->GetXaxis()->SetTitle("t (#mus)");
-       for(unsigned int i = 0; i < wvf_bin_down.size(); i++) {
-         wvfbdHist->SetBinContent(i + 1, wvf_bin_down[i]);
+       for(unsigned int i = 0; i < wvf_bin_down.size; i++) {
+         wvfbdHist->SetBinContent(i + 1, wvf_bin_down.test(i));
        }
      }
 
-       bool combine = false;
-       bool found = false;
-       bool unpaired = false;
-       size_t pair_num = -1;
-
-       for (size_t i = 0; i < fUnpaired.size(); i++){
-         if (fUnpaired.at(i) == (int)fChNumber){found=true; unpaired=true;}
-       }
+       const bool unpaired = fIsUnpaired.at(fChNumber);
+       const int pair_num = fPairIndex.at(fChNumber);
 
-       if (!found){
-         // if a pmt is found in pair1 vector and has passed threshold (for some reason)
-         // set found == true, set pair_num = index of location in Pair1
-         for (size_t i = 0; i < fPair1.size(); i++){
-           if (fPair1.at(i) == (int)fChNumber && paired.at(i)==1){found=true; pair_num=i; combine=true; break;}
-            // else if pmt is found in pair1 vector and has not yet passed threshold,
-            // set found == true, set the corresponding channel's wvf equal to downscaled wvf in the unpaired vector
-            // should be paired now
-           else if (fPair1.at(i) == (int)fChNumber && paired.at(i)==0){found=true; unpaired_wvfs.at(i)=wvf_bin_down; paired.at(i)=1; break;}
-         }
-         if (!found){
-         // if still not found in pair1, check pair2 channels
-           for (size_t i = 0; i < fPair2.size(); i++){
-             if (fPair2.at(i) == (int)fChNumber && paired.at(i)==1){found=true; pair_num=i; combine=true; break;}
-             else if (fPair2.at(i) == (int)fChNumber && paired.at(i)==0){found=true; unpaired_wvfs.at(i)=wvf_bin_down; paired.at(i)=1; break;}
-           }
+       //pair waveforms: the first channel of a pair waits for its partner
+       if (!unpaired){
+         if (pair_num < 0) continue;
+         if (!paired.at(pair_num)){
+           unpaired_wvfs.at(pair_num) = std::move(wvf_bin_down);
+           paired.at(pair_num) = 1;
+           continue;
          }
        }
 
-       //pair waveforms
-       if (combine || unpaired){
-         std::vector<char> wvf_combine;
-         wvf_combine.reserve(wvf_bin_down.size());
-         if (combine){
-           if (unpaired_wvfs.at(pair_num).size()!=wvf_bin_down.size()){std::cout<<"Mismatched paired waveform size"<<std::endl;}
-           for(unsigned int i = 0; i < wvf_bin_down.size(); i++) {
-            if (fPairLogic=="OR"){
-              if(unpaired_wvfs.at(pair_num)[i]==1 || wvf_bin_down[i]==1){wvf_combine.push_back(1);}else{wvf_combine.push_back(0);}
-            }else if (fPairLogic=="AND"){
-              if(unpaired_wvfs.at(pair_num)[i]==1 && wvf_bin_down[i]==1){wvf_combine.push_back(1);}else{wvf_combine.push_back(0);}
-            }
-           }
-         }else if(unpaired){
-           wvf_combine = wvf_bin_down;
-         }
+       BinaryWaveform wvf_combine;
+       if (unpaired){
+         wvf_combine = std::move(wvf_bin_down);
+       }else{
+         if (unpaired_wvfs.at(pair_num).size!=wvf_bin_down.size){std::cout<<"Mismatched paired waveform size"<<std::endl;}
+         wvf_combine = Combine(unpaired_wvfs.at(pair_num), wvf_bin_down, fPairAND);
+       }
 
       if (i_ev!=-1 && i_ev<3){
        histname2.str(std::string());
@@ -476,22 +540,16 @@ void pmtTriggerProducer::produce(art::Event & e)
                   << "_combined";
        }
 
-       TH1D *wvfcHist = tfs->make< TH1D >(histname2.str().c_str(), "Paired Waveform", wvf_combine.size(), fStartTime, fEndTime);
+       TH1D *wvfcHist = tfs->make< TH1D >(histname2.str().c_str(), "Paired Waveform", wvf_combine.size, fStartTime, fEndTime);
        wvfcHist->GetXaxis()->SetTitle("t (#mus)");
-       for(unsigned int i = 0; i < wvf_combine.size(); i++) {
-         wvfcHist->SetBinContent(i + 1, wvf_combine[i]);
+       for(unsigned int i = 0; i < wvf_combine.size; i++) {
+         wvfcHist->SetBinContent(i + 1, wvf_combine.test(i));
        }
      }
 
        //implement over threshold trigger signal width
        //(Every time the combined waveform transitions from 0 to 1, change the next fOVTHRWidth values to 1 (ex: fOVTHRWidth=11 -> 12 high -> 12*8=96 ns true) )
-       for(unsigned int i = 1; i < wvf_combine.size()-fOVTHRWidth; i++) {
-         if(wvf_combine[i]==1 && wvf_combine[i-1]==0){
-           for(unsigned int j = i+1; j < i+fOVTHRWidth+1; j++){
-             wvf_combine[j] = 1;
-           }
-           }
-       }
+       ExtendOverThreshold(wvf_combine, fOVTHRWidth);
 
       if (i_ev!=-1 && i_ev<3){
        histname2.str(std::string());
@@ -507,40 +565,34 @@ void pmtTriggerProducer::produce(art::Event & e)
                   << "_combined_width";
        }
 
-       TH1D *wvfcwHist = tfs->make< TH1D >(histname2.str().c_str(), "Over Threshold Paired Waveform", wvf_combine.size(), fStartTime, fEndTime);
+       TH1D *wvfcwHist = tfs->make< TH1D >(histname2.str().c_str(), "Over Threshold Paired Waveform", wvf_combine.size, fStartTime, fEndTime);
        wvfcwHist->GetXaxis()->SetTitle("t (#mus)");
-       for(unsigned int i = 0; i < wvf_combine.size(); i++) {
-         wvfcwHist->SetBinContent(i + 1, wvf_combine[i]);
+       for(unsigned int i = 0; i < wvf_combine.size; i++) {
+         wvfcwHist->SetBinContent(i + 1, wvf_combine.test(i));
        }
      }
 
        //Combine the waveforms to get a 1D array of integers where the value corresponds to the number of pairs ON and the
        //index corresponds to the tick in the waveform
-       double binspermus = wvf_combine.size()/(fEndTime-fStartTime);
+       double binspermus = wvf_combine.size/(fEndTime-fStartTime);
        unsigned int startbin = std::floor(binspermus*(fWindowStart - fStartTime));
        unsigned int endbin = std::ceil(binspermus*(fWindowEnd - fStartTime));
-       if (startbin<0.){startbin=0;}
-       if (endbin > wvf_combine.size() - 1){endbin = wvf_combine.size() - 1;}
-       if (passed_trigger.size() < endbin-startbin){
-         for (unsigned int i = passed_trigger.size(); i<endbin; i++){
-           passed_trigger.push_back(0);
-         }
-       }
-       unsigned int i_p = 0;
-       for(unsigned int i = startbin; i<endbin; i++){
-         if (wvf_combine.at(i)==1){passed_trigger.at(i_p)++;}
-         i_p++;
-       }
-
-       wvf_bin_down.clear();
-       wvf_bin_down.shrink_to_fit();
-       wvf_combine.clear();
-       wvf_combine.shrink_to_fit();
+       if (endbin > wvf_combine.size - 1){endbin = wvf_combine.size - 1;}
+       if (n_window < endbin-startbin){n_window = std::max<size_t>(n_window, endbin);}
+       if (endbin <= startbin) continue;
+       counter.add(wvf_combine, startbin, endbin-startbin);
 
      }
 
+
+   passed_trigger.resize(n_window);
+   for(size_t i = 0; i < n_window; i++) {
+     passed_trigger[i] = counter.count(i);
    }
 
+   if (!scan_levels.empty()){
+     fillThresholdScan(scan_levels, fMinStartTime, fMaxEndTime);
+   }
 
   if (i_ev!=-1 && i_ev<3){
    histname.str(std::string());
@@ -575,23 +627,88 @@ void pmtTriggerProducer::produce(art::Event & e)
 
    //clear variables
    passed_trigger.clear();
-   passed_trigger.shrink_to_fit();
    max_passed = 0;
 
    if (fVerbose){std::cout << "Number of PMT waveforms: " << num_pmt_wvf << std::endl;}
    if (fVerbose){std::cout << "Number of PMT channels: " << num_pmt_ch << std::endl;}
 
-   channel_bin_wvfs.clear();
-   channel_bin_wvfs.shrink_to_fit();
-   paired.clear();
-   paired.shrink_to_fit();
-   unpaired_wvfs.clear();
-   unpaired_wvfs.shrink_to_fit();
+} // pmtTriggerProducer::produce()
 
-   wvf_bin_0.clear();
-   wvf_bin_0.shrink_to_fit();
+void pmtTriggerProducer::fillThresholdScan(std::vector<std::vector<BinaryWaveform>>& scan_levels, double minStartTime, double maxEndTime)
+{
+   // accumulate the levels, level L then holds the ticks below the L-th lowest threshold
+   for (auto& levels : scan_levels) sbnd::trigger::AccumulateScanLevels(levels);
+
+   const size_t n_win = fScanWindows.size();
+   const size_t n_mult = fScanMultiplicities.size();
+   fScanMaxPassed.assign(fScanThresholds.size()*n_win, 0);
+   fScanTriggerTime.assign(fScanThresholds.size()*n_win*n_mult, -9999.);
+
+   std::vector<BinaryWaveform> unpaired_wvfs(fPair1.size());
+   std::vector<char> paired(fPair1.size());
+
+   for (size_t i_thr = 0; i_thr < fScanThresholds.size(); i_thr++){
+      std::fill(paired.begin(), paired.end(), 0);
+      std::vector<MultiplicityCounter> counters(n_win);
+      // first bin of each window in the waveforms and bins per us, to convert
+      // counter ticks back to time
+      std::vector<unsigned int> win_startbin(n_win, 0);
+      std::vector<double> win_binspermus(n_win, 0.);
+
+      // same pairing, width and counting as the nominal trigger
+      for (size_t i_ch = 0; i_ch < channel_numbers.size(); i_ch++){
+         const int ch = channel_numbers[i_ch];
+         const BinaryWaveform& wvf_bin_down = scan_levels[i_ch][fScanRank[fIsUncoated[i_ch]][i_thr]];
+
+         const bool unpaired = fIsUnpaired.at(ch);
+         const int pair_num = fPairIndex.at(ch);
+         if (!unpaired){
+            if (pair_num < 0) continue;
+            if (!paired.at(pair_num)){
+               unpaired_wvfs.at(pair_num) = wvf_bin_down;
+               paired.at(pair_num) = 1;
+               continue;
+            }
+         }
 
-} // pmtTriggerProducer::produce()
+         BinaryWaveform wvf_combine = unpaired ? wvf_bin_down : Combine(unpaired_wvfs.at(pair_num), wvf_bin_down, fPairAND);
+         ExtendOverThreshold(wvf_combine, fOVTHRWidth);
+
+         double binspermus = wvf_combine.size/(maxEndTime-minStartTime);
+         for (size_t i_win = 0; i_win < n_win; i_win++){
+            unsigned int startbin = std::floor(binspermus*(fScanWindows[i_win][0] - minStartTime));
+            unsigned int endbin = std::ceil(binspermus*(fScanWindows[i_win][1] - minStartTime));
+            if (endbin > wvf_combine.size - 1){endbin = wvf_combine.size - 1;}
+            if (endbin <= startbin) continue;
+            if (counters[i_win].size() == 0){
+               win_startbin[i_win] = startbin;
+               win_binspermus[i_win] = binspermus;
+            }
+            counters[i_win].add(wvf_combine, startbin, endbin-startbin);
+         }
+      }
+
+      // maximum number of pairs on, and first time each multiplicity is reached
+      for (size_t i_win = 0; i_win < n_win; i_win++){
+         const size_t idx = i_thr*n_win + i_win;
+         for (size_t i = 0; i < counters[i_win].size(); i++){
+            const int n_passed = counters[i_win].count(i);
+            if (n_passed > fScanMaxPassed[idx]) fScanMaxPassed[idx] = n_passed;
+            for (size_t i_mult = 0; i_mult < n_mult; i_mult++){
+               double& trigger_time = fScanTriggerTime[idx*n_mult + i_mult];
+               if (trigger_time == -9999. && n_passed >= fScanMultiplicities[i_mult]){
+                  trigger_time = minStartTime + (win_startbin[i_win] + i)/win_binspermus[i_win];
+               }
+            }
+         }
+      }
+   }
+
+   fScanRun = run;
+   fScanSubRun = subrun;
+   fScanEvent = event;
+   fScanTree->Fill();
+}
 
 // A macro required for a JobControl module.
 DEFINE_ART_MODULE(pmtTriggerProducer)
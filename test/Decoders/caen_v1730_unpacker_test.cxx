@@ -0,0 +1,171 @@
+/**
+ * @file   caen_v1730_unpacker_test.cxx
+ * @brief  Unit test for the CAEN V1730 waveform spans of CAENV1730Unpacker.h
+ *
+ * Usage:
+ *   `caen_v1730_unpacker_test`
+ *
+ * Synthetic CAEN V1730 fragments are built as in pmtArtdaqFragmentProducer.
+ * Their waveforms, and the waveforms combined over extended triggers, are
+ * assembled from the spans by V1730CombineWaveform, as SBNDPMTDecoder does,
+ * and required to be identical, byte by byte, to the ones of the sample by
+ * sample unpacking previously used by SBNDPMTDecoder (kept here as the
+ * reference).
+ *
+ * Returns the number of detected errors (0 on success).
+ */
+
+// SBND libraries
+#include "sbndcode/Decoders/PMT/CAENV1730Unpacker.h"
+
+// SBND DAQ libraries
+#include "artdaq-core/Data/Fragment.hh"
+#include "sbndaq-artdaq-core/Overlays/Common/CAENV1730Fragment.hh"
+#include "sbndaq-artdaq-core/Overlays/FragmentType.hh"
+
+// C/C++ standard libraries
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+
+namespace {
+
+  // builds a fragment with nch channels of wvfm_length random 14 bit samples
+  std::unique_ptr<artdaq::Fragment> MakeFragment(uint32_t nch, uint32_t wvfm_length,
+                                                 std::mt19937 &engine)
+  {
+    sbndaq::CAENV1730FragmentMetadata metadata;
+    metadata.nChannels = nch;
+    metadata.nSamples = wvfm_length;
+
+    auto frag = artdaq::Fragment::FragmentBytes(metadata.ExpectedDataSize(), 1, 0,
+                                                sbndaq::detail::FragmentType::CAENV1730, metadata);
+
+    auto header_ptr = reinterpret_cast<sbndaq::CAENV1730EventHeader*>(frag->dataBeginBytes());
+    header_ptr->eventSize = (wvfm_length * nch * sizeof(uint16_t) + sizeof(sbndaq::CAENV1730EventHeader)) / sizeof(uint32_t);
+
+    uint16_t* data_begin = reinterpret_cast<uint16_t*>(frag->dataBeginBytes() + sizeof(sbndaq::CAENV1730EventHeader));
+    std::uniform_int_distribution<uint16_t> sample(0, (1 << 14) - 1);
+    for (size_t i = 0; i < nch * wvfm_length; ++i) data_begin[i] = sample(engine);
+
+    return frag;
+  }
+
+  // the sample by sample unpacking of SBNDPMTDecoder::get_waveforms
+  void ReferenceWaveforms(const artdaq::Fragment &frag, std::vector<std::vector<uint16_t>> &wvfm_v)
+  {
+    sbndaq::CAENV1730Fragment bb(frag);
+    auto const* md = bb.Metadata();
+    auto nch = md->nChannels;
+
+    sbndaq::CAENV1730Event const* event_ptr = bb.Event();
+    sbndaq::CAENV1730EventHeader header = event_ptr->Header;
+    uint32_t ev_size_quad_bytes = header.eventSize;
+    uint32_t evt_header_size_quad_bytes = sizeof(sbndaq::CAENV1730EventHeader)/sizeof(uint32_t);
+    uint32_t data_size_double_bytes = 2*(ev_size_quad_bytes - evt_header_size_quad_bytes);
+    uint32_t wvfm_length = data_size_double_bytes/nch;
+
+    const uint16_t* data_begin = reinterpret_cast<const uint16_t*>(frag.dataBeginBytes()
+                                   + sizeof(sbndaq::CAENV1730EventHeader));
+
+    for (size_t i_ch=0; i_ch<nch; ++i_ch){
+      auto ch_offset = (size_t)(i_ch * wvfm_length);
+      std::vector<uint16_t> wvfm(wvfm_length,0);
+      for(size_t i_t=0; i_t<wvfm_length; ++i_t)
+        wvfm.at(i_t) = *(data_begin + ch_offset + i_t);
+      wvfm_v.push_back(wvfm);
+    }
+  }
+
+  bool SameBytes(std::vector<uint16_t> const& a, std::vector<uint16_t> const& b)
+  {
+    return a.size() == b.size()
+      && std::memcmp(a.data(), b.data(), a.size() * sizeof(uint16_t)) == 0;
+  }
+
+  unsigned TestCombined(std::vector<std::unique_ptr<artdaq::Fragment>> const& frags)
+  {
+    unsigned nErrors = 0;
+
+    // reference: unpack each trigger and append to the first one
+    std::vector<std::vector<uint16_t>> expected;
+    ReferenceWaveforms(*frags.front(), expected);
+    for (size_t j = 1; j < frags.size(); ++j) {
+      std::vector<std::vector<uint16_t>> extended;
+      ReferenceWaveforms(*frags[j], extended);
+      for (size_t ich = 0; ich < expected.size(); ++ich)
+        expected[ich].insert(expected[ich].end(), extended[ich].begin(), extended[ich].end());
+    }
+
+    // spans of the nominal trigger and of its extended triggers
+    std::vector<sbndaq::V1730WaveformSpan> spans;
+    std::vector<std::vector<sbndaq::V1730WaveformSpan>> extended_spans(frags.size() - 1);
+    for (size_t j = 0; j < frags.size(); ++j) {
+      if (sbndaq::V1730WaveformLength(*frags[j]) != frags[j]->metadata<sbndaq::CAENV1730FragmentMetadata>()->nSamples) {
+        std::cerr << "Trigger " << j << ": wrong waveform length" << std::endl;
+        ++nErrors;
+      }
+      auto &trigger_spans = (j == 0) ? spans : extended_spans[j-1];
+      sbndaq::V1730WaveformSpans(*frags[j], trigger_spans);
+      if (trigger_spans.size() != expected.size()) {
+        std::cerr << "Trigger " << j << ": " << trigger_spans.size() << " channels, expected "
+                  << expected.size() << std::endl;
+        return ++nErrors;
+      }
+    }
+
+    // combined as SBNDPMTDecoder does
+    for (size_t ich = 0; ich < expected.size(); ++ich) {
+      if (sbndaq::V1730CombinedLength(spans, extended_spans, ich) != expected[ich].size()) {
+        std::cerr << "Channel " << ich << " of " << frags.size() << " triggers: wrong combined length" << std::endl;
+        ++nErrors;
+      }
+
+      std::vector<uint16_t> combined;
+      sbndaq::V1730CombineWaveform(spans, extended_spans, ich, combined);
+
+      if (!SameBytes(combined, expected[ich])) {
+        std::cerr << "Channel " << ich << " of " << frags.size() << " triggers does not match" << std::endl;
+        ++nErrors;
+      }
+    }
+
+    return nErrors;
+  }
+
+} // local namespace
+
+
+int main() {
+
+  unsigned nErrors = 0;
+  std::mt19937 engine(1730);
+
+  // single nominal trigger
+  {
+    std::vector<std::unique_ptr<artdaq::Fragment>> frags;
+    frags.push_back(MakeFragment(16, 5000, engine));
+    nErrors += TestCombined(frags);
+  }
+
+  // nominal trigger followed by short extended triggers, odd lengths
+  {
+    std::vector<std::unique_ptr<artdaq::Fragment>> frags;
+    frags.push_back(MakeFragment(16, 5000, engine));
+    frags.push_back(MakeFragment(16, 1251, engine));
+    frags.push_back(MakeFragment(16, 7, engine));
+    nErrors += TestCombined(frags);
+  }
+
+  // board without the flash trigger channel (the data is in 32 bit words)
+  {
+    std::vector<std::unique_ptr<artdaq::Fragment>> frags;
+    frags.push_back(MakeFragment(15, 334, engine));
+    nErrors += TestCombined(frags);
+  }
+
+  return nErrors;
+}
@@ -0,0 +1,257 @@
+/**
+ * @file   nevis_tpc_unpacker_test.cxx
+ * @brief  Unit test for daq::NevisTPCUnpacker
+ *
+ * Usage:
+ *   `nevis_tpc_unpacker_test [FragmentDump ...]`
+ *
+ * The unpacker is first checked on synthetic fragments: a Nevis header
+ * followed by data words with known content. Their waveforms are
+ * compared both with the known content and with
+ * sbndaq::NevisTPCFragment::decode_data. Then each fragment dump (raw
+ * fragment payload: the Nevis header followed by the data words) is
+ * unpacked both by the unpacker and by decode_data, and the two are
+ * required to agree sample for sample.
+ *
+ * Returns the number of detected errors (0 on success).
+ */
+
+// SBND libraries
+#include "sbndcode/Decoders/TPC/NevisTPCUnpacker.h"
+
+// SBND DAQ libraries
+#include "artdaq-core/Data/Fragment.hh"
+#include "sbndaq-artdaq-core/Overlays/SBND/NevisTPCFragment.hh"
+
+// C/C++ standard libraries
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+namespace {
+
+  // difference to the previous sample for a Huffman code of n zeros followed
+  // by a one, as written by the Nevis FEM (kept independent of the unpacker)
+  constexpr int kNevisHuffmanDiffs[] = { 0, -1, 1, -2, 2, -3, 3 };
+
+  // encodes a waveform as a channel header, a first uncompressed sample,
+  // Huffman words for the following samples and a channel ending
+  void EncodeHuffman(uint16_t channel, std::vector<int16_t> const& waveform,
+                     std::vector<uint16_t> &words)
+  {
+    words.push_back(0x4000 | channel);
+    words.push_back(waveform.front());
+
+    uint16_t payload = 0;
+    unsigned bit = 0;
+
+    for (size_t i = 1; i < waveform.size(); ++i) {
+      const int diff = waveform[i] - waveform[i-1];
+      unsigned zeros = 0;
+      while (kNevisHuffmanDiffs[zeros] != diff) ++zeros;
+
+      // the code does not fit in this word: flush it
+      if (bit + zeros + 1 > 15) {
+        words.push_back(0x8000 | payload);
+        payload = 0;
+        bit = 0;
+      }
+
+      bit += zeros;
+      payload |= (1u << bit);
+      ++bit;
+    }
+
+    if (bit > 0) words.push_back(0x8000 | payload);
+
+    words.push_back(0x5000 | channel);
+  }
+
+  // encodes a waveform as uncompressed samples
+  void EncodeUncompressed(uint16_t channel, std::vector<int16_t> const& waveform,
+                          std::vector<uint16_t> &words)
+  {
+    words.push_back(0x4000 | channel);
+    for (auto sample: waveform) words.push_back(sample);
+    words.push_back(0x5000 | channel);
+  }
+
+  // packs a value the way the Nevis FEM writes header words: two 16 bit
+  // halves of 12 bits each, the upper 12 bits of the value in the lower half
+  uint32_t PackHeaderWord(uint32_t value)
+  {
+    return ((value & 0xFFF) << 16) | ((value >> 12) & 0xFFF);
+  }
+
+  // builds a fragment with a Nevis header followed by the data words
+  std::unique_ptr<artdaq::Fragment> MakeFragment(std::vector<uint16_t> const& words,
+                                                 uint32_t checksum)
+  {
+    sbndaq::NevisTPCHeader header;
+    std::memset(&header, 0, sizeof(header));
+    // RETURN VALUE OF getADCWordCount IS OFF BY 1
+    header.word_count = PackHeaderWord(words.size() - 1);
+    header.checksum = PackHeaderWord(checksum);
+
+    const size_t n_bytes = sizeof(header) + words.size() * sizeof(uint16_t);
+    auto frag = artdaq::Fragment::FragmentBytes(n_bytes);
+    std::memcpy(frag->dataBeginBytes(), &header, sizeof(header));
+    std::memcpy(frag->dataBeginBytes() + sizeof(header), words.data(), words.size() * sizeof(uint16_t));
+
+    return frag;
+  }
+
+  // unpacks the fragment with both the unpacker and decode_data and
+  // compares the two; returns the number of errors, and the checksum
+  // computed by the unpacker
+  unsigned CompareWithDecodeData(std::string const& name, artdaq::Fragment const& frag,
+                                 daq::NevisTPCUnpacker &unpacker, uint32_t &checksum)
+  {
+    sbndaq::NevisTPCFragment fragment(frag);
+
+    std::unordered_map<uint16_t, sbndaq::NevisTPC_Data_t> waveform_map;
+    fragment.decode_data(waveform_map);
+
+    // RETURN VALUE OF getADCWordCount IS OFF BY 1
+    const size_t n_words = fragment.header()->getADCWordCount() + 1;
+
+    checksum = unpacker.Unpack(fragment.data(), n_words);
+
+    unsigned nErrors = 0;
+
+    if (unpacker.Channels().size() != waveform_map.size()) {
+      std::cerr << name << ": " << unpacker.Channels().size() << " channels, decode_data found "
+                << waveform_map.size() << std::endl;
+      ++nErrors;
+    }
+
+    for (auto const& [channel, reference]: waveform_map) {
+      auto const& waveform = unpacker.Waveform(channel);
+
+      bool match = waveform.size() == reference.size();
+      for (size_t i = 0; match && i < reference.size(); ++i)
+        match = waveform[i] == (int16_t) reference[i];
+
+      if (!match) {
+        std::cerr << name << ": channel " << channel << " does not match decode_data ("
+                  << waveform.size() << " samples, expected " << reference.size() << ")" << std::endl;
+        ++nErrors;
+      }
+    }
+
+    std::cout << name << ": compared " << waveform_map.size() << " channels, "
+              << nErrors << " errors" << std::endl;
+
+    return nErrors;
+  }
+
+  unsigned TestSynthetic()
+  {
+    unsigned nErrors = 0;
+
+    std::map<uint16_t, std::vector<int16_t>> expected;
+    std::vector<uint16_t> words;
+
+    // uncompressed channel
+    expected[3] = { 2048, 2050, 4095, 0, 17, 2047 };
+    EncodeUncompressed(3, expected[3], words);
+
+    // compressed channel, with every difference in the table
+    std::vector<int16_t> waveform = { 2000 };
+    for (int i = 0; i < 100; ++i) waveform.push_back(waveform.back() + (i % 7) - 3);
+    expected[10] = waveform;
+    EncodeHuffman(10, expected[10], words);
+
+    // long flat compressed channel, 15 samples per word
+    expected[63] = std::vector<int16_t>(301, 1000);
+    EncodeHuffman(63, expected[63], words);
+
+    uint32_t expectedChecksum = 0;
+    for (auto word: words) expectedChecksum += word;
+    expectedChecksum &= 0xFFFFFF;
+
+    auto frag = MakeFragment(words, expectedChecksum);
+
+    if (sbndaq::NevisTPCFragment(*frag).header()->getADCWordCount() + 1 != words.size()) {
+      std::cerr << "Synthetic data: the header word count was not packed as the overlay reads it" << std::endl;
+      return nErrors + 1;
+    }
+
+    // the unpacker and decode_data must agree with each other...
+    daq::NevisTPCUnpacker unpacker;
+    uint32_t checksum = 0;
+    nErrors += CompareWithDecodeData("Synthetic data", *frag, unpacker, checksum);
+
+    if (checksum != expectedChecksum) {
+      std::cerr << "Synthetic data: checksum " << checksum << ", expected " << expectedChecksum << std::endl;
+      ++nErrors;
+    }
+
+    if (!unpacker.Compressed()) {
+      std::cerr << "Synthetic data: Huffman words not reported as compressed" << std::endl;
+      ++nErrors;
+    }
+
+    // ... and with the content that was encoded
+    if (unpacker.Channels().size() != expected.size()) {
+      std::cerr << "Synthetic data: " << unpacker.Channels().size() << " channels, expected "
+                << expected.size() << std::endl;
+      ++nErrors;
+    }
+
+    for (auto const& [channel, samples]: expected) {
+      if (unpacker.Waveform(channel) != samples) {
+        std::cerr << "Synthetic data: channel " << channel << " does not match" << std::endl;
+        ++nErrors;
+      }
+    }
+
+    // a fragment with uncompressed channels only
+    std::vector<uint16_t> uncompressed_words;
+    EncodeUncompressed(3, expected[3], uncompressed_words);
+    unpacker.Unpack(uncompressed_words.data(), uncompressed_words.size());
+    if (unpacker.Compressed()) {
+      std::cerr << "Uncompressed data: reported as compressed" << std::endl;
+      ++nErrors;
+    }
+
+    return nErrors;
+  }
+
+  unsigned TestDump(const char *fileName)
+  {
+    std::ifstream file(fileName, std::ios::binary);
+    if (!file) {
+      std::cerr << "Can't open fragment dump " << fileName << std::endl;
+      return 1;
+    }
+
+    const std::vector<char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    auto frag = artdaq::Fragment::FragmentBytes(bytes.size());
+    std::memcpy(frag->dataBeginBytes(), bytes.data(), bytes.size());
+
+    daq::NevisTPCUnpacker unpacker;
+    uint32_t checksum = 0;
+    return CompareWithDecodeData(fileName, *frag, unpacker, checksum);
+  }
+
+} // local namespace
+
+
+int main(int argc, char const** argv) {
+
+  unsigned nErrors = TestSynthetic();
+
+  for (int iArg = 1; iArg < argc; ++iArg)
+    nErrors += TestDump(argv[iArg]);
+
+  return nErrors;
+}
@@ -0,0 +1,190 @@
+/**
+ * @file   sbnd_ptb_raw_utils_test.cxx
+ * @brief  Unit test for the sbndptb queries of SBNDPTBRawUtils
+ *
+ * Usage:
+ *   `sbnd_ptb_raw_utils_test`
+ *
+ * Random sbndptb products are built, with HLT, LLT and channel status words
+ * interleaved as the decoder writes them, HLT timestamps out of order and
+ * repeated, and sparse trigger words.
+ *
+ * HLTBitIndex::FirstHLTWithBit and HLTBitIndex::HLTsWithBit are required to
+ * agree with a brute-force search over all the HLTs, for every trigger word
+ * bit and for random time windows. GetChStatusBeforeHLTs is required to give
+ * the same channel statuses as the former implementation, which scanned all
+ * the word indexes for each HLT and is kept here as the reference.
+ *
+ * Returns the number of detected errors (0 on success).
+ */
+
+// SBND libraries
+#include "sbndcode/Decoders/PTB/SBNDPTBRawUtils.h"
+#include "sbndcode/Decoders/PTB/sbndptb.h"
+
+// C/C++ standard libraries
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+
+namespace {
+
+  // reference: earliest HLT with the bit set in [tmin, tmax], lowest index on ties
+  int BruteForceFirstHLTWithBit(raw::ptb::sbndptb const& pdata, unsigned bit,
+                                ULong64_t tmin, ULong64_t tmax)
+  {
+    int first = -1;
+    auto const& hlts = pdata.GetHLTriggers();
+    for (size_t i = 0; i < hlts.size(); ++i) {
+      if (bit >= 64 || !((hlts[i].trigger_word >> bit) & 0x1)) continue;
+      if (hlts[i].timestamp < tmin || hlts[i].timestamp > tmax) continue;
+      if (first < 0 || hlts[i].timestamp < hlts[first].timestamp) first = i;
+    }
+    return first;
+  }
+
+  // reference: HLTs with the bit set, by timestamp then index
+  std::vector<size_t> BruteForceHLTsWithBit(raw::ptb::sbndptb const& pdata, unsigned bit)
+  {
+    std::vector<size_t> out;
+    auto const& hlts = pdata.GetHLTriggers();
+    std::vector<bool> taken(hlts.size(), false);
+    while (true) {
+      int next = -1;
+      for (size_t i = 0; i < hlts.size(); ++i) {
+        if (taken[i] || bit >= 64 || !((hlts[i].trigger_word >> bit) & 0x1)) continue;
+        if (next < 0 || hlts[i].timestamp < hlts[next].timestamp) next = i;
+      }
+      if (next < 0) break;
+      taken[next] = true;
+      out.push_back(next);
+    }
+    return out;
+  }
+
+  // reference: the former GetChStatusBeforeHLTs
+  std::vector<raw::ptb::ChStatus> ReferenceChStatusBeforeHLTs(raw::ptb::sbndptb const& pdata)
+  {
+    std::vector<raw::ptb::ChStatus> chs;
+    raw::ptb::ChStatus emptychstat{0, 0, 0, 0, 0, 0, 0, 0};
+
+    auto const& hlts = pdata.GetHLTriggers();
+    auto const& idxs = pdata.GetIndexes();
+    auto const& chst = pdata.GetChStatuses();
+
+    for (size_t i = 0; i < hlts.size(); ++i) {
+      for (size_t j = 0; j < idxs.size(); ++j) {
+        if (idxs.at(j).word_type != (uint32_t) ::ptb::content::word::t_gt || idxs.at(j).index != i) continue;
+        if (j > 0 && idxs.at(j-1).word_type == (uint32_t) ::ptb::content::word::t_ch
+            && idxs.at(j-1).index < chst.size())
+          chs.push_back(chst.at(idxs.at(j-1).index));
+        else
+          chs.push_back(emptychstat);
+      }
+    }
+    return chs;
+  }
+
+  bool Same(raw::ptb::ChStatus const& a, raw::ptb::ChStatus const& b)
+  {
+    return a.timestamp == b.timestamp && a.beam == b.beam && a.crt == b.crt && a.pds == b.pds
+      && a.mtca == b.mtca && a.nim == b.nim && a.auxpds == b.auxpds && a.word_type == b.word_type;
+  }
+
+  raw::ptb::sbndptb RandomProduct(std::mt19937_64 &engine)
+  {
+    std::vector<raw::ptb::Trigger> hlts, llts;
+    std::vector<raw::ptb::ChStatus> chstats;
+    std::vector<raw::ptb::Feedback> fbs;
+    std::vector<raw::ptb::Misc> miscs;
+    std::vector<raw::ptb::WordIndex> idxs;
+
+    const unsigned nwords = engine() % 60;
+    for (unsigned n = 0; n < nwords; ++n) {
+      const ULong64_t timestamp = 1000 + engine() % 50;
+      switch (engine() % 4) {
+      case 0: {
+        // a few bits set, with the high ones too
+        ULong64_t word = 0;
+        for (unsigned b = engine() % 4; b > 0; --b) word |= ULong64_t(1) << (engine() % 64);
+        hlts.push_back({timestamp, word, (uint32_t) ::ptb::content::word::t_gt});
+        idxs.push_back({(uint32_t) ::ptb::content::word::t_gt, (uint32_t) hlts.size()-1});
+        break;
+      }
+      case 1:
+        llts.push_back({timestamp, engine(), (uint32_t) ::ptb::content::word::t_lt});
+        idxs.push_back({(uint32_t) ::ptb::content::word::t_lt, (uint32_t) llts.size()-1});
+        break;
+      default: {
+        const uint32_t v = engine();
+        chstats.push_back({timestamp, v & 0x1, v & 0x2, v & 0x4, v & 0x8, v & 0x10, v & 0x20,
+                           (uint32_t) ::ptb::content::word::t_ch});
+        idxs.push_back({(uint32_t) ::ptb::content::word::t_ch, (uint32_t) chstats.size()-1});
+        break;
+      }
+      }
+    }
+
+    return raw::ptb::sbndptb(std::move(hlts), std::move(llts), std::move(chstats),
+                             std::move(fbs), std::move(miscs), std::move(idxs));
+  }
+
+  unsigned TestTrial(std::mt19937_64 &engine)
+  {
+    unsigned nErrors = 0;
+    const raw::ptb::sbndptb pdata = RandomProduct(engine);
+    const raw::ptb::HLTBitIndex index(pdata);
+
+    // also the bits past the trigger word, which have no HLT
+    for (unsigned bit = 0; bit < raw::ptb::HLTBitIndex::kNBits + 2; ++bit) {
+      if (index.HLTsWithBit(bit) != BruteForceHLTsWithBit(pdata, bit)) {
+        std::cerr << "HLTsWithBit(" << bit << ") of " << pdata.GetNHLTriggers()
+                  << " HLTs does not match" << std::endl;
+        ++nErrors;
+      }
+
+      for (int w = 0; w < 5; ++w) {
+        const ULong64_t tmin = 990 + engine() % 70;
+        const ULong64_t tmax = tmin + engine() % 20;
+        const int first = index.FirstHLTWithBit(bit, tmin, tmax);
+        const int expected = BruteForceFirstHLTWithBit(pdata, bit, tmin, tmax);
+        if (first != expected) {
+          std::cerr << "FirstHLTWithBit(" << bit << ", " << tmin << ", " << tmax << ") = " << first
+                    << ", expected " << expected << std::endl;
+          ++nErrors;
+        }
+      }
+    }
+
+    const auto chs = raw::ptb::GetChStatusBeforeHLTs(pdata);
+    const auto expected_chs = ReferenceChStatusBeforeHLTs(pdata);
+    if (chs.size() != expected_chs.size()) {
+      std::cerr << "GetChStatusBeforeHLTs: " << chs.size() << " statuses, expected "
+                << expected_chs.size() << std::endl;
+      ++nErrors;
+    }
+    else {
+      for (size_t i = 0; i < chs.size(); ++i) {
+        if (Same(chs[i], expected_chs[i])) continue;
+        std::cerr << "GetChStatusBeforeHLTs: status " << i << " does not match" << std::endl;
+        ++nErrors;
+      }
+    }
+
+    return nErrors;
+  }
+
+} // local namespace
+
+
+int main() {
+
+  unsigned nErrors = 0;
+  std::mt19937_64 engine(50);
+
+  for (int trial = 0; trial < 2000; trial++) nErrors += TestTrial(engine);
+
+  return nErrors;
+}
@@ -0,0 +1,112 @@
+/**
+ * \brief Unit tests for the CRT geometry wrapper (CRTGeoAlg)
+ */
+
+#include "art/Framework/Core/EDAnalyzer.h"
+#include "art/Framework/Core/ModuleMacros.h"
+#include "art/Framework/Principal/Event.h"
+#include "fhiclcpp/ParameterSet.h"
+#include "cetlib_except/exception.h"
+
+#include "larcore/Geometry/AuxDetGeometry.h"
+
+#include "sbndcode/Geometry/GeometryWrappers/CRTGeoAlg.h"
+
+#include <algorithm>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+
+class SBNDCRTGeoAlgTest;
+
+
+class SBNDCRTGeoAlgTest : public art::EDAnalyzer {
+public:
+  explicit SBNDCRTGeoAlgTest(fhicl::ParameterSet const& p);
+  // The compiler-generated destructor is fine for non-base
+  // classes without bare pointers or other resource use.
+
+  // Plugins should not be copied or assigned.
+  SBNDCRTGeoAlgTest(SBNDCRTGeoAlgTest const&) = delete;
+  SBNDCRTGeoAlgTest(SBNDCRTGeoAlgTest&&) = delete;
+  SBNDCRTGeoAlgTest& operator=(SBNDCRTGeoAlgTest const&) = delete;
+  SBNDCRTGeoAlgTest& operator=(SBNDCRTGeoAlgTest&&) = delete;
+
+  // Required functions.
+  void analyze(art::Event const& e) override;
+
+private:
+
+  std::vector<unsigned> fInvertedAuxDets;
+};
+
+
+SBNDCRTGeoAlgTest::SBNDCRTGeoAlgTest(fhicl::ParameterSet const& p)
+  : EDAnalyzer{p}
+  , fInvertedAuxDets(p.get<std::vector<unsigned>>("InvertedAuxDets"))
+{}
+
+void SBNDCRTGeoAlgTest::analyze(art::Event const& e)
+{
+  art::ServiceHandle<geo::AuxDetGeometry const> auxDetGeoService;
+  const std::vector<geo::AuxDetGeo> &auxDets = auxDetGeoService->GetProvider().AuxDetGeoVec();
+
+  // The channel inversion table needs an entry for every aux det
+  std::vector<std::pair<unsigned, bool>> inversion;
+  for(unsigned ad_i = 0; ad_i < auxDets.size(); ++ad_i)
+    inversion.emplace_back(ad_i, std::find(fInvertedAuxDets.begin(), fInvertedAuxDets.end(), ad_i)
+                           != fInvertedAuxDets.end());
+
+  fhicl::ParameterSet geoAlgParams;
+  geoAlgParams.put("InvertedChannelOrder", inversion);
+
+  const sbnd::crt::CRTGeoAlg crtGeoAlg(geoAlgParams);
+
+  unsigned nErrors = 0;
+
+  // The bulk accessors iterate in name order, as the std::map containers they replaced
+  auto byName = [](auto const& a, auto const& b) { return a.name < b.name; };
+
+  if(!std::is_sorted(crtGeoAlg.GetTaggers().begin(), crtGeoAlg.GetTaggers().end(), byName)) {
+    std::cout << "Taggers are not sorted by name" << std::endl;
+    ++nErrors;
+  }
+  if(!std::is_sorted(crtGeoAlg.GetModules().begin(), crtGeoAlg.GetModules().end(), byName)) {
+    std::cout << "Modules are not sorted by name" << std::endl;
+    ++nErrors;
+  }
+  if(!std::is_sorted(crtGeoAlg.GetStrips().begin(), crtGeoAlg.GetStrips().end(), byName)) {
+    std::cout << "Strips are not sorted by name" << std::endl;
+    ++nErrors;
+  }
+
+  // Every sensitive volume must map back to a strip of its own aux det, with
+  // the channels counted in the direction configured for that module
+  for(unsigned ad_i = 0; ad_i < auxDets.size(); ++ad_i) {
+
+    const sbnd::crt::CRTModuleGeo &module = crtGeoAlg.GetModuleByAuxDetIndex(ad_i);
+
+    for(unsigned ads_i = 0; ads_i < auxDets[ad_i].NSensitiveVolume(); ++ads_i) {
+
+      const sbnd::crt::CRTStripGeo &strip = crtGeoAlg.GetStripByAuxDetIndices(ad_i, ads_i);
+
+      const uint16_t channel0 = module.invertedOrdering ?
+        32 * ad_i + (31 - 2 * ads_i) : 32 * ad_i + 2 * ads_i;
+
+      if(strip.adsID != ads_i || crtGeoAlg.GetModuleByID(strip.moduleID).adID != ad_i
+         || strip.channel0 != channel0) {
+        std::cout << "Aux det " << ad_i << " sensitive volume " << ads_i
+                  << " returned strip " << strip.name << " (aux det "
+                  << crtGeoAlg.GetModuleByID(strip.moduleID).adID << ", sensitive volume "
+                  << strip.adsID << ", channel " << strip.channel0 << ")" << std::endl;
+        ++nErrors;
+      }
+    }
+  }
+
+  if(nErrors)
+    throw cet::exception("SBNDCRTGeoAlgTest") << nErrors << " CRT geometry errors found";
+}
+
+DEFINE_ART_MODULE(SBNDCRTGeoAlgTest)
@@ -0,0 +1,142 @@
+/**
+ * @file   digi_pmt_float_accumulation_test.cxx
+ * @brief  Compares the single and double precision PMT waveform accumulation
+ *
+ * Usage:
+ *   `digi_pmt_float_accumulation_test test_digi_pmt_float_accumulation.fcl`
+ *
+ * Two DigiPMTSBNDAlg are built from the same SBND configuration, one with
+ * PMTFloatAccumulation false and one with it true, each with its own random
+ * engine started from the same seed, so that both draw the same photons and
+ * noise. They digitize the same photons, from a few photoelectrons to a
+ * saturating pulse, and their ADC waveforms are required to differ by at
+ * most one count, on less than 1% of the samples.
+ *
+ * Returns the number of detected errors (0 on success).
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "larcorealg/TestUtils/unit_test_base.h"
+#include "lardataalg/DetectorInfo/DetectorClocksStandard.h"
+#include "lardataalg/DetectorInfo/LArPropertiesStandard.h"
+#include "lardataobj/Simulation/SimPhotons.h"
+#include "fhiclcpp/ParameterSet.h"
+#include "fhiclcpp/types/Table.h"
+#include "CLHEP/Random/JamesRandom.h"
+#include "sbndcode/OpDetSim/DigiPMTSBNDAlg.hh"
+
+constexpr long SEED = 30;
+
+// fraction of samples allowed to differ by one ADC count
+constexpr double MAX_DIFF_FRACTION = 0.01;
+
+fhicl::ParameterSet get_parameters(int argc, char const** argv) {
+
+  // first argument: configuration file (mandatory)
+  std::string config_path;
+  if (argc > 1) config_path = argv[1];
+
+  char const* fhicl_env = getenv("FHICL_FILE_PATH");
+  std::string search_path = fhicl_env? std::string(fhicl_env) + ":": ".:";
+  testing::details::FirstAbsoluteOrLookupWithDotPolicy policy(search_path);
+
+  fhicl::intermediate_table table = fhicl::parse_document(config_path, policy);
+
+  return fhicl::ParameterSet::make(table).get<fhicl::ParameterSet>("testdigipmt");
+}
+
+std::unique_ptr<opdet::DigiPMTSBNDAlg> make_digitizer(fhicl::ParameterSet digi_params, bool float_accumulation,
+                                                      detinfo::LArProperties const& larp,
+                                                      detinfo::DetectorClocksData const& clockData,
+                                                      CLHEP::HepRandomEngine* engine) {
+
+  digi_params.put_or_replace("PMTFloatAccumulation", float_accumulation);
+
+  fhicl::Table<opdet::DigiPMTSBNDAlgMaker::Config> config(digi_params);
+  opdet::DigiPMTSBNDAlgMaker maker(config());
+
+  return maker(larp, clockData, engine);
+}
+
+// photons of a scintillation-like pulse: n_photons spread over ~1.5 us after t0 (ns)
+sim::SimPhotonsLite make_photons(int ch, int t0, int n_photons) {
+
+  sim::SimPhotonsLite photons;
+  photons.OpChannel = ch;
+
+  for (int i = 0; i < n_photons; i++) {
+    // fast component on the first third, slow tail on the rest
+    const int t = (i % 3 == 0) ? t0 + (i * 7) % 10 : t0 + (i * 13) % 1500;
+    photons.DetectedPhotons[t]++;
+  }
+
+  return photons;
+}
+
+int main(int argc, char const** argv) {
+
+  int errors = 0;
+
+  const fhicl::ParameterSet params = get_parameters(argc, argv);
+
+  const detinfo::LArPropertiesStandard larp(params.get<fhicl::ParameterSet>("LArProperties"),
+                                            { "service_provider", "service_type" });
+  const detinfo::DetectorClocksStandard clocks(params.get<fhicl::ParameterSet>("DetectorClocks"));
+  const detinfo::DetectorClocksData clockData = clocks.DataForJob();
+
+  const fhicl::ParameterSet digi_params = params.get<fhicl::ParameterSet>("DigiPMTAlg");
+
+  CLHEP::HepJamesRandom engineDouble(SEED);
+  CLHEP::HepJamesRandom engineFloat(SEED);
+
+  auto digiDouble = make_digitizer(digi_params, false, larp, clockData, &engineDouble);
+  auto digiFloat = make_digitizer(digi_params, true, larp, clockData, &engineFloat);
+
+  const unsigned n_sample = 5000;
+  const int ch = 6;
+
+  // from a few photoelectrons to a saturating pulse
+  for (int n_photons: { 0, 20, 500, 20000, 2000000 }) {
+
+    const sim::SimPhotonsLite photons = make_photons(ch, 2000, n_photons);
+
+    std::vector<short unsigned int> waveformDouble, waveformFloat;
+    digiDouble->ConstructWaveformLiteUncoatedPMT(ch, photons, waveformDouble, "pmt_uncoated", 0., n_sample);
+    digiFloat->ConstructWaveformLiteUncoatedPMT(ch, photons, waveformFloat, "pmt_uncoated", 0., n_sample);
+
+    if (waveformDouble.size() != waveformFloat.size()) {
+      std::cout << n_photons << " photons: waveform sizes " << waveformDouble.size()
+                << " and " << waveformFloat.size() << std::endl;
+      errors++;
+      continue;
+    }
+
+    unsigned n_diff = 0;
+    int max_diff = 0;
+    for (size_t i = 0; i < waveformDouble.size(); i++) {
+      const int diff = std::abs((int) waveformDouble[i] - (int) waveformFloat[i]);
+      if (diff != 0) n_diff++;
+      if (diff > max_diff) max_diff = diff;
+    }
+
+    std::cout << n_photons << " photons: " << n_diff << " of " << waveformDouble.size()
+              << " samples differ, by at most " << max_diff << " ADC" << std::endl;
+
+    if (max_diff > 1) {
+      std::cout << "Single precision accumulation is off by more than one ADC count?" << std::endl;
+      errors++;
+    }
+
+    if (n_diff > MAX_DIFF_FRACTION * waveformDouble.size()) {
+      std::cout << "Single precision accumulation differs on too many samples?" << std::endl;
+      errors++;
+    }
+  }
+
+  return errors;
+}
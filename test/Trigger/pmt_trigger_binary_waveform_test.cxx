@@ -0,0 +1,233 @@
+/**
+ * @file   pmt_trigger_binary_waveform_test.cxx
+ * @brief  Unit test for the bit-packed binary waveforms of pmtTriggerProducer
+ *
+ * Usage:
+ *   `pmt_trigger_binary_waveform_test`
+ *
+ * Random binary waveforms are run through the trigger logic both with the
+ * bit-packed helpers of pmtTriggerBinaryWaveform.h and with the former
+ * implementation of pmtTriggerProducer, one tick per char, kept here as
+ * the reference. Filling (orWord), Downsample4, Combine,
+ * ExtendOverThreshold and MultiplicityCounter are required to give the
+ * same ticks and counts.
+ *
+ * The threshold scan levels, filled through the ADC look up table and
+ * accumulated, are required to match the downsampled binary waveform
+ * obtained by thresholding every sample against each scan threshold.
+ *
+ * Returns the number of detected errors (0 on success).
+ */
+
+// SBND libraries
+#include "sbndcode/Trigger/PMT/pmtTriggerBinaryWaveform.h"
+
+// C/C++ standard libraries
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+
+namespace {
+
+  using sbnd::trigger::BinaryWaveform;
+
+  // reference: keeps ticks 0, 4, 8, ...
+  std::vector<char> ReferenceDownsample4(std::vector<char> const& wvf_bin)
+  {
+    std::vector<char> wvf_bin_down;
+    for (unsigned int i = 0; i < wvf_bin.size(); i++) {
+      if (i%4==0) wvf_bin_down.push_back(wvf_bin[i]);
+    }
+    return wvf_bin_down;
+  }
+
+  // reference: sets the next width ticks after each rising edge
+  void ReferenceExtendOverThreshold(std::vector<char> &wvf_combined, unsigned width)
+  {
+    if (wvf_combined.size() <= width) return;
+    for (unsigned i = 1; i < wvf_combined.size()-width; i++) {
+      if (wvf_combined[i]==1 && wvf_combined[i-1]==0) {
+        for (unsigned j = i+1; j < i+width+1; j++) wvf_combined[j] = 1;
+      }
+    }
+  }
+
+  bool Same(BinaryWaveform const& wvf, std::vector<char> const& reference)
+  {
+    if (wvf.size != reference.size()) return false;
+    for (size_t i = 0; i < reference.size(); i++) {
+      if (wvf.test(i) != (reference[i] == 1)) return false;
+    }
+    return true;
+  }
+
+  unsigned TestTrial(std::mt19937_64 &engine)
+  {
+    unsigned nErrors = 0;
+
+    const size_t n = 1 + engine() % 3000;
+    const unsigned width = engine() % 15;
+    const bool useAND = engine() % 2;
+    const unsigned density = engine() % 300; // per mille of ticks over threshold
+
+    // two channels, each the OR of a few waveforms at random offsets
+    std::vector<std::vector<char>> reference(2, std::vector<char>(n, 0));
+    std::vector<BinaryWaveform> packed(2, BinaryWaveform(n));
+
+    for (int ch = 0; ch < 2; ch++) {
+      for (int w = 0; w < 3; w++) {
+        const size_t offset = engine() % n;
+        const size_t length = engine() % (n - offset + 1);
+        const size_t total = offset + length + engine() % 50;
+        if (reference[ch].size() < total) {
+          reference[ch].resize(total, 0);
+          packed[ch].grow(total);
+        }
+
+        std::vector<char> ticks(length);
+        for (auto &tick : ticks) tick = (engine() % 1000) < density;
+
+        for (size_t i = 0; i < length; i++) if (ticks[i]) reference[ch][offset + i] = 1;
+
+        for (size_t i0 = 0; i0 < length; i0 += 64) {
+          uint64_t bits = 0;
+          for (size_t k = 0; k < std::min<size_t>(64, length - i0); k++) bits |= uint64_t(ticks[i0 + k]) << k;
+          if (bits) packed[ch].orWord(offset + i0, bits);
+        }
+      }
+
+      if (!Same(packed[ch], reference[ch])) {
+        std::cerr << "Channel " << ch << " of " << n << " ticks: filled waveform does not match" << std::endl;
+        ++nErrors;
+      }
+    }
+
+    // downsampling
+    std::vector<std::vector<char>> reference_down;
+    std::vector<BinaryWaveform> packed_down;
+    for (int ch = 0; ch < 2; ch++) {
+      reference_down.push_back(ReferenceDownsample4(reference[ch]));
+      packed_down.push_back(sbnd::trigger::Downsample4(packed[ch]));
+
+      if (!Same(packed_down[ch], reference_down[ch])) {
+        std::cerr << "Channel " << ch << " of " << n << " ticks: downsampled waveform does not match" << std::endl;
+        ++nErrors;
+      }
+    }
+
+    // pairing and extension are only defined for waveforms of the same length
+    if (reference_down[0].size() != reference_down[1].size()) return nErrors;
+
+    std::vector<char> reference_combined(reference_down[1].size());
+    for (size_t i = 0; i < reference_combined.size(); i++) {
+      reference_combined[i] = useAND ? (reference_down[0][i] && reference_down[1][i])
+                                     : (reference_down[0][i] || reference_down[1][i]);
+    }
+    BinaryWaveform packed_combined = sbnd::trigger::Combine(packed_down[0], packed_down[1], useAND);
+
+    if (!Same(packed_combined, reference_combined)) {
+      std::cerr << n << " ticks: combined waveform does not match" << std::endl;
+      ++nErrors;
+    }
+
+    ReferenceExtendOverThreshold(reference_combined, width);
+    sbnd::trigger::ExtendOverThreshold(packed_combined, width);
+
+    if (!Same(packed_combined, reference_combined)) {
+      std::cerr << n << " ticks, width " << width << ": extended waveform does not match" << std::endl;
+      ++nErrors;
+    }
+
+    // counting: the combined waveform added several times over random ranges
+    sbnd::trigger::MultiplicityCounter counter;
+    std::vector<int> passed_trigger(engine() % 200, 0);
+
+    const size_t size = reference_combined.size();
+    const int n_adds = 1 + engine() % 40;
+    for (int r = 0; size >= 2 && r < n_adds; r++) {
+      const unsigned startbin = engine() % size;
+      const unsigned endbin = std::min<size_t>(startbin + engine() % (size - startbin), size - 1);
+
+      if (passed_trigger.size() < endbin - startbin) passed_trigger.resize(endbin - startbin, 0);
+      for (unsigned i = startbin; i < endbin; i++) {
+        if (reference_combined.at(i) == 1) passed_trigger.at(i - startbin)++;
+      }
+
+      if (endbin > startbin) counter.add(packed_combined, startbin, endbin - startbin);
+    }
+
+    for (size_t i = 0; i < passed_trigger.size(); i++) {
+      if (counter.count(i) != passed_trigger[i]) {
+        std::cerr << n << " ticks: count at tick " << i << " is " << counter.count(i)
+                  << ", expected " << passed_trigger[i] << std::endl;
+        ++nErrors;
+        break;
+      }
+    }
+
+    return nErrors;
+  }
+
+  unsigned TestThresholdScan(std::mt19937_64 &engine)
+  {
+    unsigned nErrors = 0;
+
+    // thresholds with repeated and non integer values
+    const std::vector<double> thresholds = { 7960.5, 7950., 7976., 7960.5, 7940.2 };
+
+    const std::vector<int> levels = sbnd::trigger::ScanLevels(thresholds);
+    const std::vector<size_t> ranks = sbnd::trigger::ScanRanks(thresholds, levels);
+    const std::vector<uint16_t> lut = sbnd::trigger::ScanLevelLUT(levels);
+
+    const size_t n = 1000 + engine() % 3000;
+
+    // full rate binary waveform of each threshold, and the scan levels
+    std::vector<BinaryWaveform> full(thresholds.size(), BinaryWaveform(n));
+    std::vector<BinaryWaveform> scan_levels(levels.size(), BinaryWaveform((n + 3) / 4));
+
+    for (int w = 0; w < 4; w++) {
+      const size_t n_before = engine() % (n / 2);
+      std::vector<uint16_t> wvf(engine() % (n - n_before));
+      for (auto &adc : wvf) adc = 7900 + engine() % 100;
+
+      for (size_t t = 0; t < thresholds.size(); t++) {
+        for (size_t i = 0; i < wvf.size(); i++) {
+          if ((double)wvf[i] < thresholds[t]) full[t].set(n_before + i);
+        }
+      }
+
+      sbnd::trigger::FillScanLevels(lut, wvf, n_before, scan_levels);
+    }
+
+    sbnd::trigger::AccumulateScanLevels(scan_levels);
+
+    for (size_t t = 0; t < thresholds.size(); t++) {
+      const BinaryWaveform down = sbnd::trigger::Downsample4(full[t]);
+      const BinaryWaveform& level = scan_levels.at(ranks[t]);
+      if (down.size != level.size || down.words != level.words) {
+        std::cerr << "Threshold " << thresholds[t] << " (level " << ranks[t] << ") of " << n
+                  << " ticks: scan level does not match" << std::endl;
+        ++nErrors;
+      }
+    }
+
+    return nErrors;
+  }
+
+} // local namespace
+
+
+int main() {
+
+  unsigned nErrors = 0;
+  std::mt19937_64 engine(48);
+
+  for (int trial = 0; trial < 3000; trial++) nErrors += TestTrial(engine);
+
+  for (int trial = 0; trial < 500; trial++) nErrors += TestThresholdScan(engine);
+
+  return nErrors;
+}